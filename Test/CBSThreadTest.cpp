@@ -0,0 +1,396 @@
+/**
+ * @file CBSThreadTest.cpp
+ * @author Lennart Hustermeier (lennart.hustermeier@gmx.de)
+ * @brief Contains a mini-program which solves random MAPF tasks with one and with multiple CBS threads and checks that both plans
+ * are collision free, avoid blocked nodes and have the same sum of costs, once with the space-time A* and once with SIPP as low level search; Also checks that the agent paths shared between constraint tree nodes stay valid
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "graph/MAPF/CBS/CBS.hpp"
+#include "graph/MAPF/CBS/ConstraintTree.hpp"
+#include "graph/HeuristicCache.hpp"
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <iostream>
+
+/**
+ * @brief Returns a name for a node in a 2D grid as a string
+ *
+ * @param pX X-coordinate of the node in the 2D grid
+ * @param pY Y-coordinate of the node in the 2D grid
+ * @return std::string Name of the node
+ */
+std::string createNodeName(int pX, int pY)
+{
+    return std::to_string(pX) + "," + std::to_string(pY);
+}
+
+/**
+ * @brief Creates a 2D grid graph with loops and random edge weights of 1 or 2
+ *
+ * @param pWidth Width of the 2D grid
+ * @param pHeight Height of the 2D grid
+ * @param pRandom The random number generator
+ * @return Graph The constructed graph
+ */
+Graph createGraph(unsigned int pWidth, unsigned int pHeight, std::mt19937& pRandom)
+{
+    std::set<NodeType> nodes;
+    std::set<std::tuple<NodeType, NodeType, double>> edges;
+    std::uniform_real_distribution<double> distribution(0.0, 1.0);
+
+    for(unsigned int x=0; x<pWidth; x++)
+    {
+        for(unsigned int y=0; y<pHeight; y++)
+        {
+            nodes.insert(createNodeName(x, y));
+            edges.insert(std::make_tuple(createNodeName(x, y), createNodeName(x, y), 1.0));
+            if(x + 1 < pWidth)
+            {
+                double weight = distribution(pRandom) < 0.5 ? 1.0 : 2.0;
+                edges.insert(std::make_tuple(createNodeName(x, y), createNodeName(x + 1, y), weight));
+                edges.insert(std::make_tuple(createNodeName(x + 1, y), createNodeName(x, y), weight));
+            }
+            if(y + 1 < pHeight)
+            {
+                double weight = distribution(pRandom) < 0.5 ? 1.0 : 2.0;
+                edges.insert(std::make_tuple(createNodeName(x, y), createNodeName(x, y + 1), weight));
+                edges.insert(std::make_tuple(createNodeName(x, y + 1), createNodeName(x, y), weight));
+            }
+        }
+    }
+
+    return Graph(nodes, edges);
+}
+
+/**
+ * @brief Checks that a plan is collision free, valid on the graph and avoids the blocked nodes and returns its sum of costs
+ *
+ * @param pGraph The graph of the task
+ * @param pTask The agents and their missions
+ * @param pPlan The plan to check
+ * @return std::optional<double> The sum of costs or an empty optional if the plan is invalid
+ */
+std::optional<double> checkPlan(const Graph& pGraph, const std::map<unsigned int, std::pair<NodeType, NodeType>>& pTask, MAPF::Plan& pPlan)
+{
+    std::map<unsigned int, std::vector<NodeType>> paths;
+    std::map<unsigned int, NodeType> previous;
+    bool valid = true;
+
+    pPlan.simulate([&](const std::map<unsigned int, NodeType>& pPositions) {
+        std::set<NodeType> occupied;
+        for(const auto& [agent, node] : pPositions)
+        {
+            paths[agent].push_back(node);
+            /*Node conflict, a blocked node or a step along an edge which does not exist*/
+            if(!occupied.insert(node).second || pGraph.isBlocked(node) || (previous.contains(agent) && !pGraph.getOutgoingEdgesWithWeights(previous[agent]).contains(node)))
+            {
+                valid = false;
+            }
+            /*Swap conflict*/
+            for(const auto& [otherAgent, otherNode] : pPositions)
+            {
+                if(agent != otherAgent && node != otherNode && previous.contains(agent) && previous.contains(otherAgent) &&
+                    previous[agent] == otherNode && previous[otherAgent] == node)
+                {
+                    valid = false;
+                }
+            }
+        }
+        previous = pPositions;
+    });
+
+    double costSum = 0.0;
+    for(const auto& [agent, startTarget] : pTask)
+    {
+        std::vector<NodeType>& path = paths[agent];
+        if(path.empty() || path.front() != startTarget.first || path.back() != startTarget.second)
+        {
+            return std::nullopt;
+        }
+        /*The agent waits at its target until the last agent arrived, which is not part of its costs*/
+        while(path.size() > 1 && path[path.size() - 2] == startTarget.second)
+        {
+            path.pop_back();
+        }
+        for(size_t i=1; i<path.size(); i++)
+        {
+            costSum += pGraph.getOutgoingEdgesWithWeights(path[i - 1]).at(path[i]);
+        }
+    }
+
+    if(!valid)
+    {
+        return std::nullopt;
+    }
+    return costSum;
+}
+
+/**
+ * @brief Returns the paths of the agents of a tree node without the waits at the target which only pad the solution
+ *
+ * @param pTree The tree node
+ * @return std::map<unsigned int, std::vector<NodeType>> Mapping <agent> -> <path>
+ */
+std::map<unsigned int, std::vector<NodeType>> getPaths(const ConstraintTree& pTree)
+{
+    std::map<unsigned int, std::vector<NodeType>> paths;
+    for(const auto& [timestep, positions] : pTree.getSolution())
+    {
+        for(const auto& [agent, node] : positions)
+        {
+            paths[agent].push_back(node);
+        }
+    }
+    for(auto& [agent, path] : paths)
+    {
+        while(path.size() > 1 && path[path.size() - 2] == path.back())
+        {
+            path.pop_back();
+        }
+    }
+    return paths;
+}
+
+/**
+ * @brief Follows the first conflicts down a constraint tree and checks the agent records which the children share with their
+ * parent: A child must keep the paths of all agents except the constrained one, creating children must not change the parent
+ * and a child must keep its paths when its ancestors are destroyed
+ *
+ * @param pGraph The graph of the task
+ * @param pTask The agents and their missions
+ * @param pAlgorithm The low level search which replans the constrained agents
+ * @return true All checks passed
+ * @return false At least one check failed
+ */
+bool checkSharedPaths(const Graph& pGraph, const std::map<unsigned int, std::pair<NodeType, NodeType>>& pTask, LowLevelAlgorithm pAlgorithm)
+{
+    NodeNameHeuristicFactory zeroHeuristic{[](NodeType, NodeType) {
+        return 0.0;
+    }};
+    std::shared_ptr<const BlockedGraph> layer = pGraph.getActiveBlockedGraph();
+    std::shared_ptr<const LowLevelPlanner> planner = layer ? makeLowLevelPlanner(layer, zeroHeuristic, pAlgorithm) : makeLowLevelPlanner(pGraph.getCompactGraph(), zeroHeuristic, pAlgorithm);
+    std::unique_ptr<ConstraintTree> tree = std::make_unique<ConstraintTree>(planner, pTask);
+
+    for(unsigned int depth=0; depth<8 && tree->hasSolution(); depth++)
+    {
+        std::optional<Conflict> conflict = tree->getFirstConflict();
+        if(!conflict.has_value())
+        {
+            break;
+        }
+        std::map<unsigned int, std::vector<NodeType>> parentPaths = getPaths(*tree);
+
+        std::vector<std::unique_ptr<ConstraintTree>> children;
+        children.push_back(std::make_unique<ConstraintTree>(*tree, Constraint(conflict->getTimestep(), conflict->getAgent1(), conflict->getNode1())));
+        children.push_back(std::make_unique<ConstraintTree>(*tree, Constraint(conflict->getTimestep(), conflict->getAgent2(), conflict->getNode2())));
+        if(getPaths(*tree) != parentPaths)
+        {
+            return false;
+        }
+
+        std::unique_ptr<ConstraintTree> next;
+        for(size_t i=0; i<children.size(); i++)
+        {
+            if(!children[i]->hasSolution())
+            {
+                continue;
+            }
+            unsigned int constrainedAgent = i == 0 ? conflict->getAgent1() : conflict->getAgent2();
+            NodeType constrainedNode = i == 0 ? conflict->getNode1() : conflict->getNode2();
+            std::map<unsigned int, std::vector<NodeType>> childPaths = getPaths(*children[i]);
+            for(const auto& [agent, path] : childPaths)
+            {
+                if(agent != constrainedAgent && path != parentPaths[agent])
+                {
+                    return false;
+                }
+            }
+            const std::vector<NodeType>& replanned = childPaths[constrainedAgent];
+            if(replanned[std::min<size_t>(conflict->getTimestep(), replanned.size() - 1)] == constrainedNode)
+            {
+                return false;
+            }
+            if(!next)
+            {
+                next = std::move(children[i]);
+            }
+        }
+        if(!next)
+        {
+            break;
+        }
+
+        /*Only the chosen child survives, its records must not depend on the destroyed tree nodes*/
+        std::map<unsigned int, std::vector<NodeType>> nextPaths = getPaths(*next);
+        children.clear();
+        tree = std::move(next);
+        if(getPaths(*tree) != nextPaths)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Checks that a solver avoids a blocked node although the detour around it is more expensive: On the path a-b-c-d with a
+ * direct edge a->d of weight 5 and b blocked the agent has to take the direct edge
+ *
+ * @param pSolver The solver
+ * @return true The agent took the direct edge
+ * @return false The agent entered the blocked node or found no path
+ */
+bool checkBlockedNode(CBS& pSolver)
+{
+    Graph g({"a", "b", "c", "d"}, {{"a", "a", 1.0}, {"b", "b", 1.0}, {"c", "c", 1.0}, {"d", "d", 1.0}, {"a", "b", 1.0}, {"b", "c", 1.0},
+                                   {"c", "d", 1.0}, {"a", "d", 5.0}});
+    g.setBlocked("b", true);
+    std::map<unsigned int, std::pair<NodeType, NodeType>> tasks = {{0, std::make_pair("a", "d")}};
+    MAPF::Plan plan = pSolver.solveTask(MAPF::Task(g, tasks));
+    std::optional<double> costs = checkPlan(g, tasks, plan);
+    return costs.has_value() && costs.value() == 5.0;
+}
+
+/**
+ * @brief Main entry point for the test program; Solves random tasks on small grids with one and with multiple threads, with a
+ * heuristic cache and without a heuristic, with both low level searches; Every third grid has a blocked node
+ *
+ * @param argc Argument count
+ * @param argv Argument values: [<number of instances>] [<number of threads>] [<seed>]
+ * @return int 0 if all plans are valid, the costs match and the shared paths are consistent, 1 otherwise
+ */
+int main(int argc, char* argv[])
+{
+    unsigned int numInstances = argc > 1 ? std::stoi(argv[1]) : 120;
+    unsigned int numThreads = argc > 2 ? std::stoi(argv[2]) : 4;
+    unsigned int seed = argc > 3 ? std::stoi(argv[3]) : 5;
+    std::mt19937 random(seed);
+
+    /*The solvers are reused for all instances, so their thread pools and the heuristic cache are reused as well*/
+    std::shared_ptr<HeuristicCache> heuristicCache = std::make_shared<HeuristicCache>();
+    auto zeroHeuristic = [](NodeType, NodeType) {
+        return 0.0;
+    };
+
+    /*Every node has a loop of weight 1, so SIPP with its unit wait costs has to find plans with the same sum of costs*/
+    const LowLevelAlgorithm algorithms[] = {LOW_LEVEL_SPACE_TIME_A_STAR, LOW_LEVEL_SAFE_INTERVALS};
+    const std::string algorithmNames[] = {"Space-time A*", "SIPP"};
+    std::vector<std::unique_ptr<CBS>> sequentialSolvers;
+    std::vector<std::unique_ptr<CBS>> parallelSolvers;
+    std::vector<std::unique_ptr<CBS>> sequentialCachedSolvers;
+    std::vector<std::unique_ptr<CBS>> parallelCachedSolvers;
+    for(LowLevelAlgorithm algorithm : algorithms)
+    {
+        sequentialSolvers.push_back(std::make_unique<CBS>(zeroHeuristic, 1));
+        parallelSolvers.push_back(std::make_unique<CBS>(zeroHeuristic, numThreads));
+        sequentialCachedSolvers.push_back(std::make_unique<CBS>(heuristicCache, 1));
+        parallelCachedSolvers.push_back(std::make_unique<CBS>(heuristicCache, numThreads));
+        sequentialSolvers.back()->setLowLevelAlgorithm(algorithm);
+        parallelSolvers.back()->setLowLevelAlgorithm(algorithm);
+        sequentialCachedSolvers.back()->setLowLevelAlgorithm(algorithm);
+        parallelCachedSolvers.back()->setLowLevelAlgorithm(algorithm);
+    }
+
+    unsigned int failures = 0;
+    double totalCosts = 0.0;
+
+    for(size_t a=0; a<std::size(algorithms); a++)
+    {
+        for(CBS* solver : {sequentialSolvers[a].get(), parallelSolvers[a].get(), sequentialCachedSolvers[a].get(), parallelCachedSolvers[a].get()})
+        {
+            if(!checkBlockedNode(*solver))
+            {
+                failures++;
+                std::cout << algorithmNames[a] << ": The agent did not avoid the blocked node" << std::endl;
+            }
+        }
+    }
+
+    for(unsigned int instance=0; instance<numInstances; instance++)
+    {
+        Graph g = createGraph(5 + instance % 3, 5 + instance % 2, random);
+        std::set<NodeType> nodeSet = g.getNodes();
+        std::vector<NodeType> starts(nodeSet.begin(), nodeSet.end());
+        std::vector<NodeType> targets(nodeSet.begin(), nodeSet.end());
+        std::shuffle(starts.begin(), starts.end(), random);
+        std::shuffle(targets.begin(), targets.end(), random);
+
+        std::map<unsigned int, std::pair<NodeType, NodeType>> tasks;
+        for(unsigned int agent=0; agent<2 + instance % 3; agent++)
+        {
+            tasks[agent] = std::make_pair(starts[agent], targets[agent]);
+        }
+
+        /*Block a node which is neither a start nor a target of the solved and the crowded tasks; A single node can not cut a grid*/
+        const unsigned int crowdedAgents = 6 + instance % 5;
+        if(instance % 3 == 2)
+        {
+            for(const NodeType& n : nodeSet)
+            {
+                if(std::find(starts.begin(), starts.begin() + crowdedAgents, n) == starts.begin() + crowdedAgents &&
+                   std::find(targets.begin(), targets.begin() + crowdedAgents, n) == targets.begin() + crowdedAgents)
+                {
+                    g.setBlocked(n, true);
+                    break;
+                }
+            }
+        }
+
+        MAPF::Task task(g, tasks);
+        std::optional<double> expectedCosts;
+        for(size_t a=0; a<std::size(algorithms); a++)
+        {
+            CBS& sequential = instance % 2 == 1 ? *sequentialCachedSolvers[a] : *sequentialSolvers[a];
+            CBS& parallel = instance % 2 == 1 ? *parallelCachedSolvers[a] : *parallelSolvers[a];
+
+            MAPF::Plan sequentialPlan = sequential.solveTask(task);
+            MAPF::Plan parallelPlan = parallel.solveTask(task);
+
+            std::optional<double> sequentialCosts = checkPlan(g, tasks, sequentialPlan);
+            std::optional<double> parallelCosts = checkPlan(g, tasks, parallelPlan);
+            if(!sequentialCosts.has_value() || !parallelCosts.has_value() || sequentialCosts.value() != parallelCosts.value())
+            {
+                failures++;
+                std::cout << "Instance " << instance << " (" << algorithmNames[a] << "): 1 thread "
+                    << (sequentialCosts.has_value() ? std::to_string(sequentialCosts.value()) : "invalid") << ", " << numThreads << " threads "
+                    << (parallelCosts.has_value() ? std::to_string(parallelCosts.value()) : "invalid") << std::endl;
+                continue;
+            }
+            if(!expectedCosts.has_value())
+            {
+                expectedCosts = sequentialCosts;
+                totalCosts += sequentialCosts.value();
+            }
+            else if(sequentialCosts.value() != expectedCosts.value())
+            {
+                failures++;
+                std::cout << "Instance " << instance << ": " << algorithmNames[0] << " " << expectedCosts.value() << ", "
+                    << algorithmNames[a] << " " << sequentialCosts.value() << std::endl;
+            }
+        }
+
+        /*More agents than in the solved task, so there are more conflicts to follow down the tree*/
+        std::map<unsigned int, std::pair<NodeType, NodeType>> crowdedTasks;
+        for(unsigned int agent=0; agent<crowdedAgents; agent++)
+        {
+            crowdedTasks[agent] = std::make_pair(starts[agent], targets[agent]);
+        }
+        for(size_t a=0; a<std::size(algorithms); a++)
+        {
+            if(!checkSharedPaths(g, crowdedTasks, algorithms[a]))
+            {
+                failures++;
+                std::cout << "Instance " << instance << " (" << algorithmNames[a] << "): The shared agent paths of the constraint tree are inconsistent" << std::endl;
+            }
+        }
+    }
+
+    std::cout << "Solved " << numInstances << " instances with a total sum of costs of " << totalCosts << ", " << failures << " failures" << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,221 @@
+/**
+ * @file ConflictTest.cpp
+ * @author Lennart Hustermeier (lennart.hustermeier@gmx.de)
+ * @brief Contains a mini-program which compares the conflict detection of the constraint tree against a brute-force enumeration
+ * on random 2D grids
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "graph/MAPF/CBS/ConstraintTree.hpp"
+#include <algorithm>
+#include <random>
+#include <iostream>
+
+/**
+ * @brief A conflict as tuple (<timestep>, <agent 1>, <agent 2>, <node 1>, <node 2>), so conflicts can be compared directly
+ */
+typedef std::tuple<unsigned int, unsigned int, unsigned int, NodeType, NodeType> ConflictTuple;
+
+/**
+ * @brief Returns a name for a node in a 2D grid as a string
+ *
+ * @param pX X-coordinate of the node in the 2D grid
+ * @param pY Y-coordinate of the node in the 2D grid
+ * @return std::string Name of the node
+ */
+std::string createNodeName(int pX, int pY)
+{
+    return std::to_string(pX) + "," + std::to_string(pY);
+}
+
+/**
+ * @brief Creates a 2D grid graph with loops, so the agents can wait on every node
+ *
+ * @param pWidth Width of the 2D grid
+ * @param pHeight Height of the 2D grid
+ * @return Graph The constructed graph
+ */
+Graph createGraph(unsigned int pWidth, unsigned int pHeight)
+{
+    std::set<NodeType> nodes;
+    std::set<std::tuple<NodeType, NodeType, double>> edges;
+
+    for(unsigned int x=0; x<pWidth; x++)
+    {
+        for(unsigned int y=0; y<pHeight; y++)
+        {
+            nodes.insert(createNodeName(x, y));
+            edges.insert(std::make_tuple(createNodeName(x, y), createNodeName(x, y), 1.0));
+            if(x + 1 < pWidth)
+            {
+                edges.insert(std::make_tuple(createNodeName(x, y), createNodeName(x + 1, y), 1.0));
+                edges.insert(std::make_tuple(createNodeName(x + 1, y), createNodeName(x, y), 1.0));
+            }
+            if(y + 1 < pHeight)
+            {
+                edges.insert(std::make_tuple(createNodeName(x, y), createNodeName(x, y + 1), 1.0));
+                edges.insert(std::make_tuple(createNodeName(x, y + 1), createNodeName(x, y), 1.0));
+            }
+        }
+    }
+
+    return Graph(nodes, edges);
+}
+
+/**
+ * @brief Enumerates all conflicts of a solution by comparing every pair of agents in every timestep; Node conflicts come first
+ * (ordered by timestep and then by agent, every agent is paired with the first agent on the same node), then swap conflicts
+ * (ordered by timestep, every pair of agents once with the lower agent first)
+ *
+ * @param pSolution The solution as mapping time -> agent -> node
+ * @return std::vector<ConflictTuple> All conflicts in the order of ConstraintTree::getConflicts()
+ */
+std::vector<ConflictTuple> enumerateConflicts(const std::map<unsigned int, std::map<unsigned int, NodeType>>& pSolution)
+{
+    std::vector<ConflictTuple> result;
+    unsigned int lastTimestep = pSolution.empty() ? 0 : pSolution.rbegin()->first;
+
+    for(unsigned int t=1; t<=lastTimestep; t++)
+    {
+        std::map<NodeType, unsigned int> firstAgent;
+        for(const auto& [agent, node] : pSolution.at(t))
+        {
+            if(firstAgent.contains(node))
+            {
+                result.push_back(std::make_tuple(t, firstAgent[node], agent, node, node));
+            }
+            else
+            {
+                firstAgent[node] = agent;
+            }
+        }
+    }
+    for(unsigned int t=0; t<lastTimestep; t++)
+    {
+        const std::map<unsigned int, NodeType>& now = pSolution.at(t);
+        const std::map<unsigned int, NodeType>& next = pSolution.at(t + 1);
+        for(const auto& [agent1, node1] : now)
+        {
+            for(const auto& [agent2, node2] : now)
+            {
+                if(agent1 < agent2 && node1 != node2 && next.at(agent1) == node2 && next.at(agent2) == node1)
+                {
+                    result.push_back(std::make_tuple(t + 1, agent1, agent2, node2, node1));
+                }
+            }
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Converts a conflict into a tuple
+ *
+ * @param pConflict The conflict
+ * @return ConflictTuple The conflict as tuple
+ */
+ConflictTuple toTuple(const Conflict& pConflict)
+{
+    return std::make_tuple(pConflict.getTimestep(), pConflict.getAgent1(), pConflict.getAgent2(), pConflict.getNode1(), pConflict.getNode2());
+}
+
+/**
+ * @brief Checks getConflicts() and getFirstConflict() of a tree node against the brute-force enumeration
+ *
+ * @param pTree The tree node to check
+ * @return true Both methods match the enumeration
+ * @return false At least one of them does not
+ */
+bool checkTree(const ConstraintTree& pTree)
+{
+    std::vector<ConflictTuple> expected = enumerateConflicts(pTree.getSolution());
+    std::vector<Conflict> conflicts = pTree.getConflicts();
+    std::optional<Conflict> first = pTree.getFirstConflict();
+
+    if(conflicts.size() != expected.size())
+    {
+        return false;
+    }
+    for(size_t i=0; i<conflicts.size(); i++)
+    {
+        if(toTuple(conflicts[i]) != expected[i])
+        {
+            return false;
+        }
+    }
+    if(expected.empty())
+    {
+        return !first.has_value();
+    }
+    return first.has_value() && toTuple(first.value()) == expected.front();
+}
+
+/**
+ * @brief Main entry point for the test program; Solves the root and a few children of constraint trees for random tasks and
+ * compares the conflicts of every node with a brute-force enumeration
+ *
+ * @param argc Argument count
+ * @param argv Argument values: [<number of instances>] [<seed>]
+ * @return int 0 if all conflicts matched, 1 otherwise
+ */
+int main(int argc, char* argv[])
+{
+    unsigned int numInstances = argc > 1 ? std::stoi(argv[1]) : 300;
+    unsigned int seed = argc > 2 ? std::stoi(argv[2]) : 3;
+    std::mt19937 random(seed);
+
+    unsigned int mismatches = 0;
+    unsigned int nodesChecked = 0;
+    unsigned int conflictsChecked = 0;
+
+    for(unsigned int instance=0; instance<numInstances; instance++)
+    {
+        Graph g = createGraph(4 + instance % 5, 4 + instance % 3);
+        std::set<NodeType> nodeSet = g.getNodes();
+        std::vector<NodeType> starts(nodeSet.begin(), nodeSet.end());
+        std::vector<NodeType> targets(nodeSet.begin(), nodeSet.end());
+        std::shuffle(starts.begin(), starts.end(), random);
+        std::shuffle(targets.begin(), targets.end(), random);
+
+        /*Sparse agent IDs, so the agent order is not the index order by accident*/
+        std::map<unsigned int, std::pair<NodeType, NodeType>> tasks;
+        for(unsigned int agent=0; agent<2 + instance % 12 && agent<starts.size(); agent++)
+        {
+            tasks[agent * 3 + 1] = std::make_pair(starts[agent], targets[agent]);
+        }
+
+        std::shared_ptr<const LowLevelPlanner> planner = makeLowLevelPlanner(g.getCompactGraph(), NodeNameHeuristicFactory{[](NodeType, NodeType) {
+            return 0.0;
+        }}, LOW_LEVEL_SPACE_TIME_A_STAR);
+
+        /*Check the root and then follow the first conflicts down a few levels of the tree*/
+        std::vector<std::unique_ptr<ConstraintTree>> trees;
+        trees.push_back(std::make_unique<ConstraintTree>(planner, tasks));
+        for(unsigned int depth=0; depth<4 && trees.back()->hasSolution(); depth++)
+        {
+            const ConstraintTree& tree = *trees.back();
+            nodesChecked++;
+            conflictsChecked += tree.getConflicts().size();
+            if(!checkTree(tree))
+            {
+                mismatches++;
+                std::cout << "Mismatch in instance " << instance << " at depth " << depth << std::endl;
+                break;
+            }
+
+            std::optional<Conflict> conflict = tree.getFirstConflict();
+            if(!conflict.has_value())
+            {
+                break;
+            }
+            trees.push_back(std::make_unique<ConstraintTree>(tree, Constraint(conflict->getTimestep(), conflict->getAgent2(), conflict->getNode2())));
+        }
+    }
+
+    std::cout << "Checked " << nodesChecked << " tree nodes with " << conflictsChecked << " conflicts, " << mismatches << " mismatches" << std::endl;
+    return mismatches == 0 ? 0 : 1;
+}
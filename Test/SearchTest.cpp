@@ -0,0 +1,1171 @@
+/**
+ * @file SearchTest.cpp
+ * @author Lennart Hustermeier (lennart.hustermeier@gmx.de)
+ * @brief Contains a mini-program which compares the path searches on random graphs against brute-force references
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "graph/graph.hpp"
+#include "graph/ContractionHierarchy.hpp"
+#include "graph/DistanceMatrix.hpp"
+#include "graph/HeuristicCache.hpp"
+#include "graph/HopDistanceMatrix.hpp"
+#include "graph/IncrementalSearch.hpp"
+#include "graph/JumpPointSearch.hpp"
+#include "graph/LandmarkHeuristic.hpp"
+#include "graph/LatticeHierarchy.hpp"
+#include "graph/LowLevelPlanner.hpp"
+#include "graph/SafeIntervalSearch.hpp"
+#include "graph/ShortestPathTree.hpp"
+#include "graph/SpaceTimeAStar.hpp"
+#include "graph/ThreadPool.hpp"
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <queue>
+#include <random>
+
+/**
+ * @brief An edge as tuple (<from>, <to>, <weight>)
+ */
+typedef std::tuple<NodeId, NodeId, double> Edge;
+
+/**
+ * @brief Costs of the references and the searches are equal if they differ by less than this
+ */
+constexpr double EPSILON = 1e-9;
+
+/**
+ * @brief Creates a random directed graph with integer weights; Some nodes get a loop
+ *
+ * @param pNodeCount The number of nodes
+ * @param pRandom The random number generator
+ * @param pUniformWeight The weight of every edge; 0 selects random weights
+ * @return Graph The constructed graph
+ */
+Graph createGraph(unsigned int pNodeCount, std::mt19937& pRandom, double pUniformWeight=0.0)
+{
+    std::uniform_int_distribution<unsigned int> node(0, pNodeCount - 1);
+    std::uniform_int_distribution<unsigned int> weight(1, 9);
+    std::uniform_int_distribution<unsigned int> degree(1, 4);
+    std::bernoulli_distribution loop(0.3);
+
+    std::set<NodeType> nodes;
+    std::map<std::pair<NodeType, NodeType>, double> weights;
+    for(unsigned int n=0; n<pNodeCount; n++)
+    {
+        nodes.insert("n" + std::to_string(n));
+    }
+    for(unsigned int n=0; n<pNodeCount; n++)
+    {
+        unsigned int edges = degree(pRandom);
+        for(unsigned int e=0; e<edges; e++)
+        {
+            unsigned int target = node(pRandom);
+            if(target != n)
+            {
+                weights[std::make_pair("n" + std::to_string(n), "n" + std::to_string(target))] = pUniformWeight > 0.0 ? pUniformWeight : weight(pRandom);
+            }
+        }
+        if(loop(pRandom))
+        {
+            weights[std::make_pair("n" + std::to_string(n), "n" + std::to_string(n))] = pUniformWeight > 0.0 ? pUniformWeight : weight(pRandom);
+        }
+    }
+
+    std::set<std::tuple<NodeType, NodeType, double>> edges;
+    for(const auto& [edge, w] : weights)
+    {
+        edges.insert(std::make_tuple(edge.first, edge.second, w));
+    }
+    return Graph(nodes, edges);
+}
+
+/**
+ * @brief Collects all edges of a graph which neither start nor end in a blocked node
+ *
+ * @tparam GraphType The type of the graph (e.g. CompactGraph or LatticeGraph)
+ * @param pGraph The graph
+ * @return std::vector<Edge> All edges
+ */
+template<class GraphType> std::vector<Edge> getEdges(const GraphType& pGraph)
+{
+    std::vector<Edge> edges;
+    for(NodeId n=0; n<pGraph.getNodeCount(); n++)
+    {
+        if(pGraph.isBlocked(n))
+        {
+            continue;
+        }
+        pGraph.forEachOutgoing(n, [&](NodeId pTarget, double pWeight) {
+            edges.push_back(std::make_tuple(n, pTarget, pWeight));
+        });
+    }
+    return edges;
+}
+
+/**
+ * @brief Calculates the distances from a source node to all nodes with the Bellman-Ford algorithm
+ *
+ * @param pEdges The edges of the graph; Edges with infinite weights are ignored
+ * @param pNodeCount The number of nodes in the graph
+ * @param pSource The source node
+ * @return std::vector<double> The distances indexed by node ID (infinity for unreachable nodes)
+ */
+std::vector<double> getDistances(const std::vector<Edge>& pEdges, size_t pNodeCount, NodeId pSource)
+{
+    std::vector<double> distances(pNodeCount, std::numeric_limits<double>::infinity());
+    distances[pSource] = 0.0;
+    for(size_t round=1; round<pNodeCount; round++)
+    {
+        for(const auto& [from, to, weight] : pEdges)
+        {
+            distances[to] = std::min(distances[to], distances[from] + weight);
+        }
+    }
+    return distances;
+}
+
+/**
+ * @brief Counts the edges on the shortest paths from a source node to all nodes with a breadth-first search
+ *
+ * @param pEdges The edges of the graph
+ * @param pNodeCount The number of nodes in the graph
+ * @param pSource The source node
+ * @return std::vector<uint32_t> The hops indexed by node ID (HopDistanceMatrix::UNREACHABLE for unreachable nodes)
+ */
+std::vector<uint32_t> getHops(const std::vector<Edge>& pEdges, size_t pNodeCount, NodeId pSource)
+{
+    std::vector<std::vector<NodeId>> neighbours(pNodeCount);
+    for(const auto& [from, to, weight] : pEdges)
+    {
+        neighbours[from].push_back(to);
+    }
+    std::vector<uint32_t> hops(pNodeCount, HopDistanceMatrix::UNREACHABLE);
+    std::queue<NodeId> queue;
+    hops[pSource] = 0;
+    queue.push(pSource);
+    while(!queue.empty())
+    {
+        NodeId n = queue.front();
+        queue.pop();
+        for(NodeId next : neighbours[n])
+        {
+            if(hops[next] == HopDistanceMatrix::UNREACHABLE)
+            {
+                hops[next] = hops[n] + 1;
+                queue.push(next);
+            }
+        }
+    }
+    return hops;
+}
+
+/**
+ * @brief Calculates the costs of the cheapest path in the time expanded graph by a Dijkstra search over all (<node>, <timestep>)
+ * pairs up to a horizon; Every move takes one timestep and has to respect the reservations, the target only counts once it is not
+ * reserved anymore
+ *
+ * @tparam GraphType The type of the graph (e.g. CompactGraph or LatticeGraph)
+ * @param pGraph The graph
+ * @param pStart The start node
+ * @param pTarget The target node
+ * @param pReservations The node and edge reservations
+ * @param pWaitCost The costs of a wait on a node without a loop (SIPP); Empty -> The agent can only wait along the loops of the graph
+ * @return double The costs or infinity if there is no such path
+ */
+template<class GraphType> double getTimeExpandedCosts(const GraphType& pGraph, NodeId pStart, NodeId pTarget, const ReservationTable& pReservations, std::optional<double> pWaitCost)
+{
+    const unsigned int horizon = pReservations.getLastTimestep() + pGraph.getNodeCount();
+    const std::optional<unsigned int> lastTargetReservation = pReservations.getLastNodeReservation(pTarget);
+    std::vector<std::vector<double>> costs(horizon + 1, std::vector<double>(pGraph.getNodeCount(), std::numeric_limits<double>::infinity()));
+    typedef std::tuple<double, unsigned int, NodeId> State;
+    std::priority_queue<State, std::vector<State>, std::greater<State>> open;
+
+    costs[0][pStart] = 0.0;
+    open.push(std::make_tuple(0.0, 0, pStart));
+    while(!open.empty())
+    {
+        auto [cost, timestep, node] = open.top();
+        open.pop();
+        if(cost > costs[timestep][node])
+        {
+            continue;
+        }
+        if(node == pTarget && (!lastTargetReservation.has_value() || lastTargetReservation.value() < timestep))
+        {
+            return cost;
+        }
+        if(timestep == horizon)
+        {
+            continue;
+        }
+        auto relax = [&](NodeId pNext, double pCost) {
+            if(pCost < costs[timestep + 1][pNext])
+            {
+                costs[timestep + 1][pNext] = pCost;
+                open.push(std::make_tuple(pCost, timestep + 1, pNext));
+            }
+        };
+        if(pWaitCost.has_value() && !pReservations.isNodeReserved(node, timestep + 1))
+        {
+            relax(node, cost + pGraph.getWeight(node, node).value_or(pWaitCost.value()));
+        }
+        pGraph.forEachOutgoing(node, [&](NodeId pNext, double pWeight) {
+            if(pWaitCost.has_value() && pNext == node)
+            {
+                /*Loops are waits*/
+                return;
+            }
+            if(!pGraph.isBlocked(pNext) && pReservations.isMoveAllowed(node, pNext, timestep + 1))
+            {
+                relax(pNext, cost + pWeight);
+            }
+        });
+    }
+    return std::numeric_limits<double>::infinity();
+}
+
+/**
+ * @brief Checks that a path starts and ends at the right nodes, only uses edges of the graph (or waits) and respects the
+ * reservations; Returns its costs
+ *
+ * @tparam GraphType The type of the graph (e.g. CompactGraph or LatticeGraph)
+ * @param pGraph The graph
+ * @param pPath The path (one node per timestep)
+ * @param pStart The start node
+ * @param pTarget The target node
+ * @param pReservations The node and edge reservations
+ * @param pWaitCost The costs of a wait on a node without a loop (SIPP); Empty -> Repeated nodes have to be loops of the graph
+ * @return std::optional<double> The costs of the path or an empty optional if the path is invalid
+ */
+template<class GraphType> std::optional<double> getTimedPathCosts(const GraphType& pGraph, const std::vector<NodeId>& pPath, NodeId pStart, NodeId pTarget, const ReservationTable& pReservations, std::optional<double> pWaitCost)
+{
+    if(pPath.empty() || pPath.front() != pStart || pPath.back() != pTarget || !pReservations.isPathAllowed(pPath))
+    {
+        return std::nullopt;
+    }
+    double costs = 0.0;
+    for(size_t i=1; i<pPath.size(); i++)
+    {
+        if(pWaitCost.has_value() && pPath[i] == pPath[i - 1])
+        {
+            costs += pGraph.getWeight(pPath[i], pPath[i]).value_or(pWaitCost.value());
+            continue;
+        }
+        std::optional<double> weight = pGraph.getWeight(pPath[i - 1], pPath[i]);
+        if(!weight.has_value())
+        {
+            return std::nullopt;
+        }
+        costs += weight.value();
+    }
+    return costs;
+}
+
+/**
+ * @brief Creates random node and edge reservations after timestep 0
+ *
+ * @param pEdges The edges of the graph
+ * @param pNodeCount The number of nodes in the graph
+ * @param pRandom The random number generator
+ * @return ReservationTable The reservations
+ */
+ReservationTable createReservations(const std::vector<Edge>& pEdges, size_t pNodeCount, std::mt19937& pRandom)
+{
+    std::uniform_int_distribution<NodeId> node(0, pNodeCount - 1);
+    std::uniform_int_distribution<unsigned int> timestep(1, 12);
+    std::uniform_int_distribution<size_t> edge(0, pEdges.size() - 1);
+
+    ReservationTable reservations;
+    for(unsigned int r=0; r<pNodeCount; r++)
+    {
+        reservations.reserveNode(node(pRandom), timestep(pRandom));
+    }
+    for(unsigned int r=0; r<pNodeCount / 2 && !pEdges.empty(); r++)
+    {
+        /*Loops are not reserved, CBS only creates edge reservations for swaps*/
+        const Edge& e = pEdges[edge(pRandom)];
+        if(std::get<0>(e) != std::get<1>(e))
+        {
+            reservations.reserveEdge(std::get<0>(e), std::get<1>(e), timestep(pRandom));
+        }
+    }
+    return reservations;
+}
+
+/**
+ * @brief Compares SIPP and the space-time A* with the time expanded Dijkstra search on random graphs with random reservations; On
+ * graphs with weighted loops on every node the paths of both planners have to cost the same
+ *
+ * @param pRandom The random number generator
+ * @param pInstances The number of random instances
+ * @return unsigned int The number of mismatches
+ */
+unsigned int checkSafeIntervalSearch(std::mt19937& pRandom, unsigned int pInstances)
+{
+    unsigned int mismatches = 0;
+    for(unsigned int instance=0; instance<pInstances; instance++)
+    {
+        Graph g = createGraph(6 + instance % 20, pRandom);
+        std::shared_ptr<const CompactGraph> compact = g.getCompactGraph();
+        std::uniform_int_distribution<NodeId> node(0, compact->getNodeCount() - 1);
+        NodeId start = node(pRandom);
+        NodeId target = node(pRandom);
+        ReservationTable reservations = createReservations(getEdges(*compact), compact->getNodeCount(), pRandom);
+
+        auto zero = [](NodeId) {
+            return 0.0;
+        };
+        /*Both searches charge a wait with the weight of the loop, SIPP waits on nodes without a loop as well*/
+        const double waitCost = 0.5 + 0.5 * (instance % 3);
+        BasicSafeIntervalSearch<CompactGraph> safeIntervalSearch(*compact, std::pmr::get_default_resource(), waitCost);
+        BasicSpaceTimeAStar<CompactGraph> spaceTimeAStar(*compact);
+        std::vector<NodeId> safeIntervalPath = safeIntervalSearch.findPath(start, target, zero, std::vector<bool>(), reservations);
+        std::vector<NodeId> spaceTimePath = spaceTimeAStar.findPath(start, target, zero, std::vector<bool>(), reservations);
+
+        /*Both searches are compared with the time expanded graph, once with waits on every node and once along the loops only*/
+        double safeIntervalExpected = getTimeExpandedCosts(*compact, start, target, reservations, waitCost);
+        double spaceTimeExpected = getTimeExpandedCosts(*compact, start, target, reservations, std::nullopt);
+        std::optional<double> safeIntervalCosts = getTimedPathCosts(*compact, safeIntervalPath, start, target, reservations, waitCost);
+        std::optional<double> spaceTimeCosts = getTimedPathCosts(*compact, spaceTimePath, start, target, reservations, std::nullopt);
+
+        bool safeIntervalMatches = std::isinf(safeIntervalExpected) ? safeIntervalPath.empty() : safeIntervalCosts.has_value() && std::abs(safeIntervalCosts.value() - safeIntervalExpected) < EPSILON;
+        bool spaceTimeMatches = std::isinf(spaceTimeExpected) ? spaceTimePath.empty() : spaceTimeCosts.has_value() && std::abs(spaceTimeCosts.value() - spaceTimeExpected) < EPSILON;
+
+        /*With a loop on every node both planners can wait everywhere, so CBS gets the same costs from either of them*/
+        Graph looped = g;
+        std::uniform_int_distribution<unsigned int> weight(1, 9);
+        for(NodeId n=0; n<compact->getNodeCount(); n++)
+        {
+            looped.addEdge(std::make_tuple(compact->getNodeName(n), compact->getNodeName(n), weight(pRandom)));
+        }
+        std::shared_ptr<const CompactGraph> loopedCompact = looped.getCompactGraph();
+        auto zeroFactory = [](const std::shared_ptr<const CompactGraph>&, NodeId) {
+            return [](NodeId) { return 0.0; };
+        };
+        std::shared_ptr<const LowLevelPlanner> safeIntervalPlanner = makeLowLevelPlanner(loopedCompact, zeroFactory, LOW_LEVEL_SAFE_INTERVALS);
+        std::shared_ptr<const LowLevelPlanner> spaceTimePlanner = makeLowLevelPlanner(loopedCompact, zeroFactory, LOW_LEVEL_SPACE_TIME_A_STAR);
+        NodeId loopedStart = loopedCompact->getNodeId(compact->getNodeName(start));
+        NodeId loopedTarget = loopedCompact->getNodeId(compact->getNodeName(target));
+        ReservationTable loopedReservations = createReservations(getEdges(*loopedCompact), loopedCompact->getNodeCount(), pRandom);
+        std::vector<NodeId> safeIntervalPlannerPath = safeIntervalPlanner->findPath(loopedStart, loopedTarget, loopedReservations);
+        std::vector<NodeId> spaceTimePlannerPath = spaceTimePlanner->findPath(loopedStart, loopedTarget, loopedReservations);
+        bool plannersMatch = safeIntervalPlannerPath.empty() == spaceTimePlannerPath.empty() && (safeIntervalPlannerPath.empty() ||
+                             std::abs(safeIntervalPlanner->getPathCost(safeIntervalPlannerPath) - spaceTimePlanner->getPathCost(spaceTimePlannerPath)) < EPSILON);
+
+        if(!safeIntervalMatches || !spaceTimeMatches || !plannersMatch)
+        {
+            mismatches++;
+            std::cout << "SIPP/space-time A*: Mismatch in instance " << instance << std::endl;
+        }
+    }
+    return mismatches;
+}
+
+/**
+ * @brief Returns the costs of a path under the current edge weights and obstacles
+ *
+ * @param pPath The path
+ * @param pWeights The current weights of the edges
+ * @param pBlocked The blocked nodes (indexed by node ID)
+ * @return double The costs or infinity if the path uses a missing edge or a blocked node
+ */
+double getPathCosts(const std::vector<NodeId>& pPath, const std::map<std::pair<NodeId, NodeId>, double>& pWeights, const std::vector<bool>& pBlocked)
+{
+    double costs = 0.0;
+    for(size_t i=0; i<pPath.size(); i++)
+    {
+        if(pBlocked[pPath[i]])
+        {
+            return std::numeric_limits<double>::infinity();
+        }
+        if(i > 0)
+        {
+            std::map<std::pair<NodeId, NodeId>, double>::const_iterator edge = pWeights.find(std::make_pair(pPath[i - 1], pPath[i]));
+            if(edge == pWeights.end())
+            {
+                return std::numeric_limits<double>::infinity();
+            }
+            costs += edge->second;
+        }
+    }
+    return costs;
+}
+
+/**
+ * @brief Checks the result of an incremental search against the Bellman-Ford distances under the current edge weights
+ *
+ * @param pSearch The search
+ * @param pStart The current start node of the search
+ * @param pTarget The target node of the search
+ * @param pWeights The current weights of the edges
+ * @param pBlocked The blocked nodes (indexed by node ID)
+ * @return std::optional<std::vector<NodeId>> The path of the search if it matches the reference, otherwise an empty optional
+ */
+std::optional<std::vector<NodeId>> checkIncrementalPath(IncrementalSearch& pSearch, NodeId pStart, NodeId pTarget, const std::map<std::pair<NodeId, NodeId>, double>& pWeights, const std::vector<bool>& pBlocked)
+{
+    std::vector<Edge> edges;
+    for(const auto& [edge, weight] : pWeights)
+    {
+        if(!pBlocked[edge.first] && !pBlocked[edge.second] && !std::isinf(weight))
+        {
+            edges.push_back(std::make_tuple(edge.first, edge.second, weight));
+        }
+    }
+    double expected = getDistances(edges, pBlocked.size(), pStart)[pTarget];
+
+    std::vector<NodeId> path = pSearch.getPath();
+    double costs = pSearch.getPathCost();
+    if(std::isinf(expected))
+    {
+        return std::isinf(costs) && path.empty() ? std::make_optional(path) : std::nullopt;
+    }
+    if(std::abs(costs - expected) >= EPSILON || path.empty() || path.front() != pStart || path.back() != pTarget ||
+       std::abs(getPathCosts(path, pWeights, pBlocked) - expected) >= EPSILON)
+    {
+        return std::nullopt;
+    }
+    return path;
+}
+
+/**
+ * @brief Compares LPA* and D* Lite with the Bellman-Ford algorithm on random graphs while random edges change their weights or
+ * are removed and random nodes are blocked and unblocked; The start of D* Lite moves along its path after every change
+ *
+ * @param pRandom The random number generator
+ * @param pInstances The number of random instances
+ * @return unsigned int The number of mismatches
+ */
+unsigned int checkIncrementalSearch(std::mt19937& pRandom, unsigned int pInstances)
+{
+    unsigned int mismatches = 0;
+    for(unsigned int instance=0; instance<pInstances; instance++)
+    {
+        Graph g = createGraph(6 + instance % 20, pRandom);
+        std::shared_ptr<const CompactGraph> compact = g.getCompactGraph();
+        std::uniform_int_distribution<NodeId> node(0, compact->getNodeCount() - 1);
+        std::uniform_int_distribution<unsigned int> weight(1, 9);
+        std::uniform_int_distribution<unsigned int> change(0, 99);
+        NodeId start = node(pRandom);
+        NodeId target = node(pRandom);
+
+        std::map<std::pair<NodeId, NodeId>, double> weights;
+        for(const auto& [from, to, w] : getEdges(*compact))
+        {
+            weights[std::make_pair(from, to)] = w;
+        }
+        std::vector<bool> blocked(compact->getNodeCount(), false);
+
+        LifelongPlanningAStar lifelongPlanningAStar(compact, start, target);
+        DStarLite dStarLite(compact, start, target);
+        NodeId agent = start;
+
+        for(unsigned int step=0; step<12; step++)
+        {
+            if(step > 0)
+            {
+                /*Change the weight of an edge, remove an edge or block respectively unblock a node*/
+                unsigned int kind = change(pRandom);
+                if(kind < 65)
+                {
+                    std::map<std::pair<NodeId, NodeId>, double>::iterator edge = std::next(weights.begin(), std::uniform_int_distribution<size_t>(0, weights.size() - 1)(pRandom));
+                    edge->second = kind < 50 ? weight(pRandom) : std::numeric_limits<double>::infinity();
+                    lifelongPlanningAStar.setEdgeWeight(edge->first.first, edge->first.second, edge->second);
+                    dStarLite.setEdgeWeight(edge->first.first, edge->first.second, edge->second);
+                }
+                else
+                {
+                    NodeId n = node(pRandom);
+                    if(n != start && n != target && n != agent)
+                    {
+                        blocked[n] = !blocked[n];
+                        lifelongPlanningAStar.setNodeBlocked(n, blocked[n]);
+                        dStarLite.setNodeBlocked(n, blocked[n]);
+                    }
+                }
+            }
+
+            std::optional<std::vector<NodeId>> lifelongPlanningPath = checkIncrementalPath(lifelongPlanningAStar, start, target, weights, blocked);
+            std::optional<std::vector<NodeId>> dStarLitePath = checkIncrementalPath(dStarLite, agent, target, weights, blocked);
+            if(!lifelongPlanningPath.has_value() || !dStarLitePath.has_value())
+            {
+                mismatches++;
+                std::cout << "LPA*/D* Lite: Mismatch in instance " << instance << " after " << step << " changes" << std::endl;
+                break;
+            }
+
+            /*The agent makes a step along its path*/
+            if(dStarLitePath->size() > 1)
+            {
+                agent = dStarLitePath->at(1);
+                dStarLite.moveStart(agent);
+            }
+        }
+    }
+    return mismatches;
+}
+
+/**
+ * @brief Compares LPA* and D* Lite which follow the edits of a Graph (see IncrementalSearch::update()) with the Bellman-Ford
+ * algorithm while random nodes and edges are blocked, unblocked and removed; Adding an edge has to be rejected
+ *
+ * @param pRandom The random number generator
+ * @param pInstances The number of random instances
+ * @return unsigned int The number of mismatches
+ */
+unsigned int checkIncrementalGraphUpdate(std::mt19937& pRandom, unsigned int pInstances)
+{
+    unsigned int mismatches = 0;
+    for(unsigned int instance=0; instance<pInstances; instance++)
+    {
+        Graph g = createGraph(6 + instance % 20, pRandom);
+        std::shared_ptr<const CompactGraph> compact = g.getCompactGraph();
+        std::uniform_int_distribution<NodeId> node(0, compact->getNodeCount() - 1);
+        std::uniform_int_distribution<unsigned int> change(0, 99);
+        NodeId start = node(pRandom);
+        NodeId target = node(pRandom);
+
+        std::map<std::pair<NodeId, NodeId>, double> baseWeights;
+        for(const auto& [from, to, w] : getEdges(*compact))
+        {
+            baseWeights[std::make_pair(from, to)] = w;
+        }
+        std::set<std::pair<NodeId, NodeId>> blockedEdges;
+        std::set<std::pair<NodeId, NodeId>> removedEdges;
+        std::vector<bool> blockedNodes(compact->getNodeCount(), false);
+        std::vector<bool> removedNodes(compact->getNodeCount(), false);
+
+        LifelongPlanningAStar lifelongPlanningAStar(compact, start, target);
+        DStarLite dStarLite(compact, start, target);
+        NodeId agent = start;
+
+        for(unsigned int step=0; step<12; step++)
+        {
+            if(step > 0)
+            {
+                /*Block respectively unblock or remove an edge or a node of the graph itself*/
+                unsigned int kind = change(pRandom);
+                if(kind < 60)
+                {
+                    std::pair<NodeId, NodeId> edge = std::next(baseWeights.begin(), std::uniform_int_distribution<size_t>(0, baseWeights.size() - 1)(pRandom))->first;
+                    const NodeType& from = compact->getNodeName(edge.first);
+                    const NodeType& to = compact->getNodeName(edge.second);
+                    if(removedEdges.count(edge) == 0 && !removedNodes[edge.first] && !removedNodes[edge.second])
+                    {
+                        if(kind < 45)
+                        {
+                            if(blockedEdges.erase(edge) == 0)
+                            {
+                                blockedEdges.insert(edge);
+                            }
+                            g.setEdgeBlocked(from, to, blockedEdges.count(edge) > 0);
+                        }
+                        else
+                        {
+                            removedEdges.insert(edge);
+                            g.removeEdge(std::make_pair(from, to));
+                        }
+                    }
+                }
+                else
+                {
+                    NodeId n = node(pRandom);
+                    if(n != start && n != target && n != agent && !removedNodes[n])
+                    {
+                        if(kind < 85)
+                        {
+                            blockedNodes[n] = !blockedNodes[n];
+                            g.setBlocked(compact->getNodeName(n), blockedNodes[n]);
+                        }
+                        else
+                        {
+                            removedNodes[n] = true;
+                            g.removeNode(compact->getNodeName(n));
+                        }
+                    }
+                }
+            }
+
+            std::map<std::pair<NodeId, NodeId>, double> weights;
+            for(const auto& [edge, w] : baseWeights)
+            {
+                if(blockedEdges.count(edge) == 0 && removedEdges.count(edge) == 0)
+                {
+                    weights[edge] = w;
+                }
+            }
+            std::vector<bool> blocked(compact->getNodeCount(), false);
+            for(NodeId n=0; n<compact->getNodeCount(); n++)
+            {
+                blocked[n] = blockedNodes[n] || removedNodes[n];
+            }
+
+            bool updated = lifelongPlanningAStar.update(g) && dStarLite.update(g);
+            std::optional<std::vector<NodeId>> lifelongPlanningPath = checkIncrementalPath(lifelongPlanningAStar, start, target, weights, blocked);
+            std::optional<std::vector<NodeId>> dStarLitePath = checkIncrementalPath(dStarLite, agent, target, weights, blocked);
+            if(!updated || !lifelongPlanningPath.has_value() || !dStarLitePath.has_value())
+            {
+                mismatches++;
+                std::cout << "LPA*/D* Lite graph update: Mismatch in instance " << instance << " after " << step << " changes" << std::endl;
+                break;
+            }
+
+            /*The agent makes a step along its path*/
+            if(dStarLitePath->size() > 1)
+            {
+                agent = dStarLitePath->at(1);
+                dStarLite.moveStart(agent);
+            }
+        }
+
+        /*The searches can not follow edges which are not part of their compact graph*/
+        g.addEdge(std::make_tuple(compact->getNodeName(start), compact->getNodeName(target), 0.5));
+        if(start != target && baseWeights.count(std::make_pair(start, target)) == 0 && lifelongPlanningAStar.update(g))
+        {
+            mismatches++;
+            std::cout << "LPA*/D* Lite graph update: Added edge accepted in instance " << instance << std::endl;
+        }
+    }
+    return mismatches;
+}
+
+/**
+ * @brief Compares the Jump Point Search with the Bellman-Ford algorithm and with the time expanded Dijkstra search on random
+ * lattices with and without spikes and with obstacles, without and with random reservations
+ *
+ * @param pRandom The random number generator
+ * @param pInstances The number of random instances
+ * @return unsigned int The number of mismatches
+ */
+unsigned int checkJumpPointSearch(std::mt19937& pRandom, unsigned int pInstances)
+{
+    const std::vector<double> axisWeights = {1.0, 1.5, 2.0, 3.0};
+    unsigned int mismatches = 0;
+    for(unsigned int instance=0; instance<pInstances; instance++)
+    {
+        std::uniform_int_distribution<size_t> axisWeight(0, axisWeights.size() - 1);
+        const double weightX = axisWeights[axisWeight(pRandom)];
+        const double weightY = axisWeights[axisWeight(pRandom)];
+
+        /*Without spikes, with spikes as expensive as the grid, with spikes like in the GeometryModule and with cheap spikes (fallback)*/
+        const double spikeWeights[] = {1.0, (weightX + weightY) / 2, std::sqrt(weightX * weightX + weightY * weightY + 1.0), 0.75};
+        LatticeGraph lattice(4 + instance % 12, 4 + instance % 9, instance % 4 != 0, weightX, weightY, spikeWeights[instance % 4]);
+        std::uniform_int_distribution<NodeId> node(0, lattice.getNodeCount() - 1);
+        std::bernoulli_distribution obstacle(0.2);
+        NodeId start = node(pRandom);
+        NodeId target = node(pRandom);
+
+        /*Obstacles of the lattice and additional ones passed to the search*/
+        std::vector<bool> blocked(lattice.getNodeCount(), false);
+        for(NodeId n=0; n<lattice.getNodeCount(); n++)
+        {
+            if(n != start && n != target && obstacle(pRandom))
+            {
+                if((instance / 4) % 2 == 0)
+                {
+                    lattice.setBlocked(n, true);
+                }
+                else
+                {
+                    blocked[n] = true;
+                }
+            }
+        }
+        std::vector<Edge> edges;
+        for(const Edge& e : getEdges(lattice))
+        {
+            if(!blocked[std::get<0>(e)] && !blocked[std::get<1>(e)])
+            {
+                edges.push_back(e);
+            }
+        }
+
+        LatticeJumpPointSearch jumpPointSearch(lattice);
+        std::vector<NodeId> path = jumpPointSearch.findPath(start, target, blocked);
+        double expected = getDistances(edges, lattice.getNodeCount(), start)[target];
+        std::optional<double> costs = getTimedPathCosts(lattice, path, start, target, ReservationTable(), std::nullopt);
+        bool matches = std::isinf(expected) ? path.empty() : costs.has_value() && std::abs(costs.value() - expected) < EPSILON;
+        for(NodeId n : path)
+        {
+            matches = matches && !blocked[n];
+        }
+
+        /*With reservations and only the obstacles of the lattice*/
+        ReservationTable reservations = createReservations(edges, lattice.getNodeCount(), pRandom);
+        std::vector<NodeId> timedPath = jumpPointSearch.findPath(start, target, reservations);
+        double timedExpected = getTimeExpandedCosts(lattice, start, target, reservations, std::nullopt);
+        std::optional<double> timedCosts = getTimedPathCosts(lattice, timedPath, start, target, reservations, std::nullopt);
+        matches = matches && (std::isinf(timedExpected) ? timedPath.empty() : timedCosts.has_value() && std::abs(timedCosts.value() - timedExpected) < EPSILON);
+
+        if(!matches)
+        {
+            mismatches++;
+            std::cout << "Jump Point Search: Mismatch in instance " << instance << std::endl;
+        }
+    }
+    return mismatches;
+}
+
+/**
+ * @brief Compares the cached distances to targets on random spiked lattices with obstacles with the Bellman-Ford algorithm; The
+ * cached distances are used as exact heuristic of the planners on the lattice
+ *
+ * @param pRandom The random number generator
+ * @param pInstances The number of random instances
+ * @return unsigned int The number of mismatches
+ */
+unsigned int checkLatticeHeuristicCache(std::mt19937& pRandom, unsigned int pInstances)
+{
+    const std::vector<double> axisWeights = {1.0, 1.5, 2.0, 3.0};
+    unsigned int mismatches = 0;
+    for(unsigned int instance=0; instance<pInstances; instance++)
+    {
+        std::uniform_int_distribution<size_t> axisWeight(0, axisWeights.size() - 1);
+        std::shared_ptr<LatticeGraph> lattice = std::make_shared<LatticeGraph>(3 + instance % 8, 3 + instance % 7, instance % 4 != 0, axisWeights[axisWeight(pRandom)], axisWeights[axisWeight(pRandom)], 0.75);
+        std::uniform_int_distribution<NodeId> node(0, lattice->getNodeCount() - 1);
+        std::bernoulli_distribution obstacle(0.15);
+        for(NodeId n=0; n<lattice->getNodeCount(); n++)
+        {
+            lattice->setBlocked(n, obstacle(pRandom));
+        }
+        std::vector<Edge> reversedEdges;
+        for(const auto& [from, to, weight] : getEdges(*lattice))
+        {
+            if(!lattice->isBlocked(to))
+            {
+                reversedEdges.push_back(std::make_tuple(to, from, weight));
+            }
+        }
+
+        HeuristicCache cache;
+        bool matches = true;
+        for(unsigned int t=0; t<3 && matches; t++)
+        {
+            NodeId target = node(pRandom);
+            std::vector<double> expected = lattice->isBlocked(target) ? std::vector<double>(lattice->getNodeCount(), std::numeric_limits<double>::infinity()) : getDistances(reversedEdges, lattice->getNodeCount(), target);
+            std::shared_ptr<const std::vector<double>> distances = cache.getDistances(lattice, target);
+            for(NodeId n=0; n<lattice->getNodeCount() && matches; n++)
+            {
+                matches = std::isinf(expected[n]) ? std::isinf(distances->at(n)) : std::abs(distances->at(n) - expected[n]) < EPSILON;
+            }
+            /*A second lookup has to be served from the cache*/
+            matches = matches && cache.getDistances(lattice, target) == distances;
+        }
+        if(!matches)
+        {
+            mismatches++;
+            std::cout << "Lattice heuristic cache: Mismatch in instance " << instance << std::endl;
+        }
+    }
+    return mismatches;
+}
+
+/**
+ * @brief Compares the distances and paths of hierarchical path finding with Dijkstra's algorithm on random spiked lattices with
+ * obstacles and different sector sizes; Nodes are blocked and unblocked between the queries and the hierarchy is updated with
+ * updateNode()
+ *
+ * @param pRandom The random number generator
+ * @param pInstances The number of random instances
+ * @return unsigned int The number of mismatches
+ */
+unsigned int checkLatticeHierarchy(std::mt19937& pRandom, unsigned int pInstances)
+{
+    const std::vector<double> axisWeights = {1.0, 1.5, 2.0, 3.0};
+    const std::vector<uint32_t> sectorSizes = {1, 2, 3, 4, 7, 16};
+    unsigned int mismatches = 0;
+    for(unsigned int instance=0; instance<pInstances; instance++)
+    {
+        std::uniform_int_distribution<size_t> axisWeight(0, axisWeights.size() - 1);
+        std::shared_ptr<LatticeGraph> lattice = std::make_shared<LatticeGraph>(2 + instance % 15, 2 + instance % 11, instance % 5 != 0, axisWeights[axisWeight(pRandom)], axisWeights[axisWeight(pRandom)], 1.25);
+        std::uniform_int_distribution<NodeId> node(0, lattice->getNodeCount() - 1);
+        std::bernoulli_distribution obstacle(0.2);
+        for(NodeId n=0; n<lattice->getNodeCount(); n++)
+        {
+            lattice->setBlocked(n, obstacle(pRandom));
+        }
+
+        LatticeHierarchy hierarchy(lattice, sectorSizes[instance % sectorSizes.size()]);
+        HierarchicalSearch search(hierarchy);
+        bool matches = true;
+        for(unsigned int round=0; round<4 && matches; round++)
+        {
+            if(round > 0)
+            {
+                /*Block and unblock some nodes; Only their sectors are rebuilt*/
+                for(unsigned int change=0; change<4; change++)
+                {
+                    NodeId n = node(pRandom);
+                    lattice->setBlocked(n, !lattice->isBlocked(n));
+                    hierarchy.updateNode(n);
+                }
+            }
+            for(unsigned int q=0; q<5 && matches; q++)
+            {
+                NodeId start = node(pRandom);
+                NodeId target = node(pRandom);
+                if(lattice->isBlocked(start) || lattice->isBlocked(target))
+                {
+                    continue;
+                }
+                double expected = ShortestPathTree::compute(lattice, start, std::vector<bool>(), target).getDistance(target);
+                double distance = search.getDistance(start, target);
+                std::vector<NodeId> path = search.findPath(start, target);
+                if(std::isinf(expected))
+                {
+                    matches = std::isinf(distance) && path.empty();
+                    continue;
+                }
+                std::optional<double> costs = getTimedPathCosts(*lattice, path, start, target, ReservationTable(), std::nullopt);
+                matches = std::abs(distance - expected) < EPSILON && costs.has_value() && std::abs(costs.value() - expected) < EPSILON;
+            }
+        }
+        if(!matches)
+        {
+            mismatches++;
+            std::cout << "Hierarchical search: Mismatch in instance " << instance << std::endl;
+        }
+    }
+    return mismatches;
+}
+
+/**
+ * @brief Compares the bit-parallel multi-source BFS with one BFS per source on random graphs with uniform weights, with more than
+ * 64 sources, in both directions and with obstacles; Also checks the distances which HeuristicCache::prepare() derives from the hops
+ *
+ * @param pRandom The random number generator
+ * @param pInstances The number of random instances
+ * @return unsigned int The number of mismatches
+ */
+unsigned int checkHopDistanceMatrix(std::mt19937& pRandom, unsigned int pInstances)
+{
+    const std::vector<double> uniformWeights = {1.0, 0.5, 2.5};
+    unsigned int mismatches = 0;
+    for(unsigned int instance=0; instance<pInstances; instance++)
+    {
+        const double uniformWeight = uniformWeights[instance % uniformWeights.size()];
+        Graph g = createGraph(6 + instance % 150, pRandom, uniformWeight);
+        std::shared_ptr<const CompactGraph> compact = g.getCompactGraph();
+        std::uniform_int_distribution<NodeId> node(0, compact->getNodeCount() - 1);
+        std::bernoulli_distribution obstacle(0.1);
+        bool backward = instance % 2 == 1;
+
+        /*Up to 140 sources, i.e. up to three 64 bit words per node; Sources may repeat and may be blocked*/
+        std::vector<NodeId> sources;
+        for(unsigned int i=0; i<1 + (instance * 13) % 140; i++)
+        {
+            sources.push_back(node(pRandom));
+        }
+        std::vector<bool> blocked(compact->getNodeCount(), false);
+        if(instance % 3 != 0)
+        {
+            for(NodeId n=0; n<compact->getNodeCount(); n++)
+            {
+                blocked[n] = obstacle(pRandom);
+            }
+        }
+        std::vector<Edge> edges;
+        std::vector<Edge> reversedEdges;
+        for(const auto& [from, to, weight] : getEdges(*compact))
+        {
+            reversedEdges.push_back(std::make_tuple(to, from, weight));
+            if(!blocked[from] && !blocked[to])
+            {
+                edges.push_back(backward ? std::make_tuple(to, from, weight) : std::make_tuple(from, to, weight));
+            }
+        }
+
+        HopDistanceMatrix matrix = HopDistanceMatrix::compute(compact, sources, blocked, backward);
+        bool matches = matrix.getSourceCount() == sources.size();
+        for(size_t i=0; i<sources.size() && matches; i++)
+        {
+            std::vector<uint32_t> expected = blocked[sources[i]] ? std::vector<uint32_t>(compact->getNodeCount(), HopDistanceMatrix::UNREACHABLE) : getHops(edges, compact->getNodeCount(), sources[i]);
+            std::vector<double> distances = matrix.getDistances(i, uniformWeight);
+            for(NodeId n=0; n<compact->getNodeCount() && matches; n++)
+            {
+                matches = matrix.getHops(i, n) == expected[n] &&
+                          (expected[n] == HopDistanceMatrix::UNREACHABLE ? std::isinf(distances[n]) : std::abs(distances[n] - expected[n] * uniformWeight) < EPSILON);
+            }
+        }
+
+        /*The cache converts the hops of a backward BFS without obstacles into distances to the targets*/
+        HeuristicCache cache;
+        cache.prepare(compact, sources);
+        for(size_t i=0; i<sources.size() && matches; i++)
+        {
+            std::vector<uint32_t> expected = getHops(reversedEdges, compact->getNodeCount(), sources[i]);
+            std::shared_ptr<const std::vector<double>> distances = cache.getDistances(compact, sources[i]);
+            for(NodeId n=0; n<compact->getNodeCount() && matches; n++)
+            {
+                matches = expected[n] == HopDistanceMatrix::UNREACHABLE ? std::isinf(distances->at(n)) : std::abs(distances->at(n) - expected[n] * uniformWeight) < EPSILON;
+            }
+        }
+
+        if(!matches)
+        {
+            mismatches++;
+            std::cout << "Multi-source BFS: Mismatch in instance " << instance << std::endl;
+        }
+    }
+    return mismatches;
+}
+
+/**
+ * @brief Checks that a heuristic is admissible (h(u) <= d(u, t)) and consistent (h(u) <= w(u, v) + h(v) for every edge)
+ *
+ * @tparam Heuristic Callable with the signature double(NodeId)
+ * @param pH The heuristic for the target
+ * @param pEdges The edges of the graph which can be used
+ * @param pDistances The exact distances of all nodes to the target
+ * @return true The heuristic is admissible and consistent
+ * @return false The heuristic overestimates somewhere
+ */
+template<class Heuristic> bool isAdmissibleAndConsistent(const Heuristic& pH, const std::vector<Edge>& pEdges, const std::vector<double>& pDistances)
+{
+    for(NodeId n=0; n<pDistances.size(); n++)
+    {
+        if(!std::isinf(pDistances[n]) && pH(n) > pDistances[n] + EPSILON)
+        {
+            return false;
+        }
+    }
+    for(const auto& [from, to, weight] : pEdges)
+    {
+        if(!std::isinf(pH(to)) && pH(from) > weight + pH(to) + EPSILON)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Checks that the ALT heuristic and the quantized distance matrices (on compact graphs with random and with uniform weights
+ * and on spiked lattices with obstacles) are admissible and consistent; Optimality of the searches and of CBS depends on both
+ *
+ * @param pRandom The random number generator
+ * @param pInstances The number of random instances
+ * @param pPool The threads to calculate the matrices on
+ * @return unsigned int The number of mismatches
+ */
+unsigned int checkAdmissibleHeuristics(std::mt19937& pRandom, unsigned int pInstances, ThreadPool& pPool)
+{
+    const std::vector<double> axisWeights = {1.0, 1.5, 2.0, 3.0};
+    unsigned int mismatches = 0;
+    for(unsigned int instance=0; instance<pInstances; instance++)
+    {
+        Graph g = createGraph(6 + instance % 80, pRandom, instance % 3 == 0 ? 2.0 : 0.0);
+        std::shared_ptr<const CompactGraph> compact = g.getCompactGraph();
+        std::uniform_int_distribution<NodeId> node(0, compact->getNodeCount() - 1);
+        std::vector<Edge> edges = getEdges(*compact);
+        std::vector<Edge> reversedEdges;
+        for(const auto& [from, to, weight] : edges)
+        {
+            reversedEdges.push_back(std::make_tuple(to, from, weight));
+        }
+
+        LandmarkHeuristic landmarks(1 + instance % 8, 2);
+        std::shared_ptr<DistanceMatrix> matrix = DistanceMatrix::compute(compact, pPool);
+        bool matches = true;
+        for(unsigned int t=0; t<3 && matches; t++)
+        {
+            NodeId target = node(pRandom);
+            std::vector<double> distances = getDistances(reversedEdges, compact->getNodeCount(), target);
+            matches = isAdmissibleAndConsistent(landmarks.getHeuristic(compact, target), edges, distances) &&
+                      isAdmissibleAndConsistent([&](NodeId pNode) { return matrix->getDistanceEstimate(pNode, target); }, edges, distances);
+        }
+
+        /*The matrix of a lattice with obstacles, only for some targets*/
+        std::uniform_int_distribution<size_t> axisWeight(0, axisWeights.size() - 1);
+        std::shared_ptr<LatticeGraph> lattice = std::make_shared<LatticeGraph>(3 + instance % 9, 3 + instance % 7, instance % 4 != 0, axisWeights[axisWeight(pRandom)], axisWeights[axisWeight(pRandom)], 1.75);
+        std::uniform_int_distribution<NodeId> latticeNode(0, lattice->getNodeCount() - 1);
+        std::bernoulli_distribution obstacle(0.15);
+        for(NodeId n=0; n<lattice->getNodeCount(); n++)
+        {
+            lattice->setBlocked(n, obstacle(pRandom));
+        }
+        std::vector<Edge> latticeEdges = getEdges(*lattice);
+        std::vector<Edge> reversedLatticeEdges;
+        for(const auto& [from, to, weight] : latticeEdges)
+        {
+            reversedLatticeEdges.push_back(std::make_tuple(to, from, weight));
+        }
+        std::vector<NodeId> targets = {latticeNode(pRandom), latticeNode(pRandom), latticeNode(pRandom)};
+        std::shared_ptr<DistanceMatrix> latticeMatrix = DistanceMatrix::compute(lattice, pPool, targets);
+        for(NodeId target : targets)
+        {
+            if(!matches || lattice->isBlocked(target))
+            {
+                continue;
+            }
+            std::vector<double> distances = getDistances(reversedLatticeEdges, lattice->getNodeCount(), target);
+            matches = isAdmissibleAndConsistent([&](NodeId pNode) { return latticeMatrix->getDistanceEstimate(pNode, target); }, latticeEdges, distances);
+        }
+
+        if(!matches)
+        {
+            mismatches++;
+            std::cout << "Admissible heuristics: Mismatch in instance " << instance << std::endl;
+        }
+    }
+    return mismatches;
+}
+
+/**
+ * @brief Compares the parallel delta-stepping with the Bellman-Ford algorithm on random graphs with random obstacles, in both
+ * directions and with different bucket widths
+ *
+ * @param pRandom The random number generator
+ * @param pInstances The number of random instances
+ * @param pPool The threads to run the delta-stepping on
+ * @return unsigned int The number of mismatches
+ */
+unsigned int checkParallelShortestPathTree(std::mt19937& pRandom, unsigned int pInstances, ThreadPool& pPool)
+{
+    const std::vector<double> deltas = {0.0, 0.5, 1.0, 3.0, 20.0};
+    unsigned int mismatches = 0;
+    for(unsigned int instance=0; instance<pInstances; instance++)
+    {
+        Graph g = createGraph(6 + instance % 150, pRandom);
+        std::shared_ptr<const CompactGraph> compact = g.getCompactGraph();
+        std::uniform_int_distribution<NodeId> node(0, compact->getNodeCount() - 1);
+        std::bernoulli_distribution obstacle(0.1);
+        NodeId source = node(pRandom);
+        bool backward = instance % 2 == 1;
+        double delta = deltas[instance % deltas.size()];
+
+        std::vector<bool> blocked(compact->getNodeCount(), false);
+        for(NodeId n=0; n<compact->getNodeCount(); n++)
+        {
+            blocked[n] = n != source && obstacle(pRandom);
+        }
+        std::vector<Edge> edges;
+        for(const auto& [from, to, weight] : getEdges(*compact))
+        {
+            if(!blocked[from] && !blocked[to])
+            {
+                edges.push_back(backward ? std::make_tuple(to, from, weight) : std::make_tuple(from, to, weight));
+            }
+        }
+        std::vector<double> expected = getDistances(edges, compact->getNodeCount(), source);
+
+        ShortestPathTree tree = ShortestPathTree::computeParallel(compact, source, pPool, blocked, backward, delta);
+        bool matches = true;
+        for(NodeId n=0; n<compact->getNodeCount() && matches; n++)
+        {
+            if(std::isinf(expected[n]))
+            {
+                matches = !tree.isReachable(n) && std::isinf(tree.getDistance(n));
+                continue;
+            }
+            /*The tree has to contain a path with the same costs*/
+            std::vector<NodeId> path = tree.getPath(n);
+            std::optional<double> costs = getTimedPathCosts(*compact, path, backward ? n : source, backward ? source : n, ReservationTable(), std::nullopt);
+            matches = std::abs(tree.getDistance(n) - expected[n]) < EPSILON && costs.has_value() && std::abs(costs.value() - expected[n]) < EPSILON;
+        }
+        if(!matches)
+        {
+            mismatches++;
+            std::cout << "Delta-stepping: Mismatch in instance " << instance << std::endl;
+        }
+    }
+    return mismatches;
+}
+
+/**
+ * @brief Compares the queries and the PHAST distances of contraction hierarchies with the Bellman-Ford algorithm on random graphs
+ *
+ * @param pRandom The random number generator
+ * @param pInstances The number of random instances
+ * @param pPool The threads to contract the nodes on
+ * @return unsigned int The number of mismatches
+ */
+unsigned int checkContractionHierarchy(std::mt19937& pRandom, unsigned int pInstances, ThreadPool& pPool)
+{
+    unsigned int mismatches = 0;
+    for(unsigned int instance=0; instance<pInstances; instance++)
+    {
+        Graph g = createGraph(6 + instance % 100, pRandom);
+        std::shared_ptr<const CompactGraph> compact = g.getCompactGraph();
+        std::uniform_int_distribution<NodeId> node(0, compact->getNodeCount() - 1);
+        std::vector<Edge> edges = getEdges(*compact);
+        std::vector<Edge> reversedEdges;
+        for(const auto& [from, to, weight] : edges)
+        {
+            reversedEdges.push_back(std::make_tuple(to, from, weight));
+        }
+
+        std::shared_ptr<ContractionHierarchy> hierarchy = ContractionHierarchy::build(compact, pPool);
+        ContractionHierarchyQuery query(*hierarchy);
+        bool matches = true;
+
+        /*Point-to-point queries*/
+        for(unsigned int q=0; q<10 && matches; q++)
+        {
+            NodeId start = node(pRandom);
+            NodeId target = node(pRandom);
+            double expected = getDistances(edges, compact->getNodeCount(), start)[target];
+            double distance = query.getDistance(start, target);
+            std::vector<NodeId> path = query.findPath(start, target);
+            if(std::isinf(expected))
+            {
+                matches = std::isinf(distance) && path.empty();
+                continue;
+            }
+            std::optional<double> costs = getTimedPathCosts(*compact, path, start, target, ReservationTable(), std::nullopt);
+            matches = std::abs(distance - expected) < EPSILON && costs.has_value() && std::abs(costs.value() - expected) < EPSILON;
+        }
+
+        /*Distances of all nodes to a target (PHAST)*/
+        NodeId target = node(pRandom);
+        std::vector<double> expected = getDistances(reversedEdges, compact->getNodeCount(), target);
+        std::shared_ptr<const std::vector<double>> distances = hierarchy->getDistances(target);
+        for(NodeId n=0; n<compact->getNodeCount() && matches; n++)
+        {
+            matches = std::isinf(expected[n]) ? std::isinf(distances->at(n)) : std::abs(distances->at(n) - expected[n]) < EPSILON;
+        }
+
+        if(!matches)
+        {
+            mismatches++;
+            std::cout << "Contraction hierarchy: Mismatch in instance " << instance << std::endl;
+        }
+    }
+    return mismatches;
+}
+
+/**
+ * @brief Main entry point for the test program; Runs all comparisons
+ *
+ * @param argc Argument count
+ * @param argv Argument values: [<number of instances per search>] [<seed>]
+ * @return int 0 if all searches matched their references, 1 otherwise
+ */
+int main(int argc, char* argv[])
+{
+    unsigned int numInstances = argc > 1 ? std::stoi(argv[1]) : 200;
+    unsigned int seed = argc > 2 ? std::stoi(argv[2]) : 7;
+    std::mt19937 random(seed);
+
+    unsigned int mismatches = 0;
+    mismatches += checkSafeIntervalSearch(random, numInstances);
+    mismatches += checkIncrementalSearch(random, numInstances);
+    mismatches += checkIncrementalGraphUpdate(random, numInstances);
+    mismatches += checkJumpPointSearch(random, numInstances);
+    mismatches += checkLatticeHeuristicCache(random, numInstances);
+    mismatches += checkLatticeHierarchy(random, numInstances);
+    mismatches += checkHopDistanceMatrix(random, numInstances);
+
+    ThreadPool pool(4);
+    mismatches += checkParallelShortestPathTree(random, numInstances, pool);
+    mismatches += checkContractionHierarchy(random, numInstances, pool);
+    mismatches += checkAdmissibleHeuristics(random, numInstances, pool);
+
+    std::cout << "Compared " << numInstances << " instances per search, " << mismatches << " mismatches" << std::endl;
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,292 @@
+/**
+ * @file SnapshotTest.cpp
+ * @author Lennart Hustermeier (lennart.hustermeier@gmx.de)
+ * @brief Contains a mini-program which stores random graphs as snapshots, maps them again and compares them with the original; Also
+ * checks that damaged snapshots are rejected
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "graph/graph.hpp"
+#include "graph/GraphSnapshot.hpp"
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <random>
+
+/**
+ * @brief The header of a snapshot file as it is described in GraphSnapshot.hpp
+ */
+struct SnapshotHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t flags;
+    uint64_t nodeCount;
+    uint64_t edgeCount;
+    uint64_t nameBytes;
+};
+
+/**
+ * @brief An edge as tuple (<node>, <neighbour>, <weight>)
+ */
+typedef std::tuple<NodeId, NodeId, double> Edge;
+
+/**
+ * @brief Creates a random directed graph with integer weights and node names of different lengths
+ *
+ * @param pNodeCount The number of nodes
+ * @param pRandom The random number generator
+ * @return Graph The constructed graph
+ */
+Graph createGraph(unsigned int pNodeCount, std::mt19937& pRandom)
+{
+    std::uniform_int_distribution<unsigned int> node(0, pNodeCount - 1);
+    std::uniform_int_distribution<unsigned int> weight(1, 9);
+    std::uniform_int_distribution<unsigned int> degree(0, 4);
+
+    std::set<NodeType> nodes;
+    std::set<std::tuple<NodeType, NodeType, double>> edges;
+    for(unsigned int n=0; n<pNodeCount; n++)
+    {
+        nodes.insert("n" + std::to_string(n * 37));
+    }
+    for(unsigned int n=0; n<pNodeCount; n++)
+    {
+        unsigned int count = degree(pRandom);
+        for(unsigned int e=0; e<count; e++)
+        {
+            edges.insert(std::make_tuple("n" + std::to_string(n * 37), "n" + std::to_string(node(pRandom) * 37), weight(pRandom)));
+        }
+    }
+    return Graph(nodes, edges);
+}
+
+/**
+ * @brief Collects the outgoing respectively incoming edges of all nodes of a graph
+ *
+ * @tparam GraphType CompactGraph or GraphSnapshot
+ * @param pGraph The graph
+ * @param pIncoming Collects the incoming edges if true, the outgoing ones else
+ * @return std::vector<Edge> The edges in the order of the node IDs
+ */
+template<class GraphType> std::vector<Edge> getEdges(const GraphType& pGraph, bool pIncoming)
+{
+    std::vector<Edge> edges;
+    for(NodeId n=0; n<pGraph.getNodeCount(); n++)
+    {
+        auto add = [&](NodeId pNeighbour, double pWeight) {
+            edges.push_back(std::make_tuple(n, pNeighbour, pWeight));
+        };
+        pIncoming ? pGraph.forEachIncoming(n, add) : pGraph.forEachOutgoing(n, add);
+    }
+    return edges;
+}
+
+/**
+ * @brief Returns the byte offsets of the sections of a snapshot in the order outOffsets, outTargets, outWeights, inOffsets,
+ * inSources, inWeights, nameOffsets, names, positions
+ *
+ * @param pHeader The header of the snapshot
+ * @return std::vector<size_t> The offsets
+ */
+std::vector<size_t> getSections(const SnapshotHeader& pHeader)
+{
+    const size_t sizes[9] = {
+        (pHeader.nodeCount + 1) * sizeof(uint32_t), pHeader.edgeCount * sizeof(NodeId), pHeader.edgeCount * sizeof(double),
+        (pHeader.nodeCount + 1) * sizeof(uint32_t), pHeader.edgeCount * sizeof(NodeId), pHeader.edgeCount * sizeof(double),
+        (pHeader.nodeCount + 1) * sizeof(uint32_t), pHeader.nameBytes, pHeader.nodeCount * 3 * sizeof(double)
+    };
+    std::vector<size_t> result;
+    size_t offset = sizeof(SnapshotHeader);
+    for(size_t size : sizes)
+    {
+        offset = (offset + 7) / 8 * 8;
+        result.push_back(offset);
+        offset += size;
+    }
+    return result;
+}
+
+/**
+ * @brief Reads a whole file
+ *
+ * @param pPath The path of the file
+ * @return std::vector<char> The content
+ */
+std::vector<char> readFile(const std::string& pPath)
+{
+    std::ifstream in(pPath, std::ios::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+/**
+ * @brief Writes a whole file
+ *
+ * @param pPath The path of the file
+ * @param pContent The content
+ */
+void writeFile(const std::string& pPath, const std::vector<char>& pContent)
+{
+    std::ofstream out(pPath, std::ios::binary | std::ios::trunc);
+    out.write(pContent.data(), static_cast<std::streamsize>(pContent.size()));
+}
+
+/**
+ * @brief Stores random graphs with and without positions, maps them again and compares the node names, the node IDs, the edges in
+ * both directions and the positions with the original
+ *
+ * @param pRandom The random number generator
+ * @param pInstances The number of random instances
+ * @param pPath The file to use
+ * @return unsigned int The number of mismatches
+ */
+unsigned int checkRoundTrip(std::mt19937& pRandom, unsigned int pInstances, const std::string& pPath)
+{
+    std::uniform_real_distribution<double> coordinate(-100.0, 100.0);
+    unsigned int mismatches = 0;
+    for(unsigned int instance=0; instance<pInstances; instance++)
+    {
+        Graph g = createGraph(1 + instance % 60, pRandom);
+        std::shared_ptr<const CompactGraph> compact = g.getCompactGraph();
+        std::vector<std::array<double, 3>> positions;
+        if(instance % 2 == 0)
+        {
+            for(NodeId n=0; n<compact->getNodeCount(); n++)
+            {
+                positions.push_back({coordinate(pRandom), coordinate(pRandom), coordinate(pRandom)});
+            }
+        }
+
+        GraphSnapshot::save(pPath, *compact, positions);
+        GraphSnapshot snapshot(pPath);
+
+        bool matches = snapshot.getNodeCount() == compact->getNodeCount() && snapshot.getEdgeCount() == compact->getEdgeCount() &&
+                       snapshot.hasPositions() == !positions.empty();
+        for(NodeId n=0; n<compact->getNodeCount() && matches; n++)
+        {
+            const NodeType& name = compact->getNodeName(n);
+            matches = snapshot.getNodeName(n) == name && snapshot.getNodeNameView(n) == name && snapshot.getNodeId(name) == n;
+            matches = matches && (positions.empty() || snapshot.getPosition(n) == positions[n]);
+        }
+        matches = matches && snapshot.getNodeId("unknown") == GraphSnapshot::INVALID_NODE;
+        matches = matches && getEdges(snapshot, false) == getEdges(*compact, false) && getEdges(snapshot, true) == getEdges(*compact, true);
+
+        if(!matches)
+        {
+            mismatches++;
+            std::cout << "Snapshot round trip: Mismatch in instance " << instance << std::endl;
+        }
+    }
+    return mismatches;
+}
+
+/**
+ * @brief Damages a valid snapshot in different ways (truncated, wrong magic, offsets out of range or decreasing, edges to unknown
+ * nodes, name offsets out of range) and checks that mapping it throws std::runtime_error
+ *
+ * @param pRandom The random number generator
+ * @param pPath The file to use
+ * @return unsigned int The number of damaged snapshots which were accepted
+ */
+unsigned int checkDamagedSnapshots(std::mt19937& pRandom, const std::string& pPath)
+{
+    Graph g = createGraph(20, pRandom);
+    std::shared_ptr<const CompactGraph> compact = g.getCompactGraph();
+    GraphSnapshot::save(pPath, *compact);
+    const std::vector<char> original = readFile(pPath);
+    SnapshotHeader header;
+    std::memcpy(&header, original.data(), sizeof(SnapshotHeader));
+    const std::vector<size_t> sections = getSections(header);
+    const uint32_t nodeCount = static_cast<uint32_t>(header.nodeCount);
+    const uint32_t edgeCount = static_cast<uint32_t>(header.edgeCount);
+
+    /*Writes a 32 bit value into a copy of the original*/
+    auto patch = [&](size_t pOffset, uint32_t pValue) {
+        std::vector<char> content = original;
+        std::memcpy(content.data() + pOffset, &pValue, sizeof(pValue));
+        return content;
+    };
+
+    const std::vector<std::pair<std::string, std::vector<char>>> damaged = {
+        {"empty file", std::vector<char>()},
+        {"truncated header", std::vector<char>(original.begin(), original.begin() + sizeof(SnapshotHeader) / 2)},
+        {"truncated sections", std::vector<char>(original.begin(), original.end() - 8)},
+        {"appended bytes", [&]() { std::vector<char> content = original; content.resize(content.size() + 8, 0); return content; }()},
+        {"wrong magic", patch(0, 0)},
+        {"wrong version", patch(offsetof(SnapshotHeader, version), 99)},
+        {"node count out of range", patch(offsetof(SnapshotHeader, nodeCount), nodeCount + 1)},
+        {"first out offset", patch(sections[0], 1)},
+        {"last out offset", patch(sections[0] + nodeCount * sizeof(uint32_t), edgeCount + 1)},
+        {"out offset out of range", patch(sections[0] + sizeof(uint32_t), edgeCount + 100)},
+        {"decreasing out offsets", patch(sections[0] + (nodeCount / 2) * sizeof(uint32_t), edgeCount)},
+        {"edge target out of range", patch(sections[1], nodeCount)},
+        {"last in offset", patch(sections[3] + nodeCount * sizeof(uint32_t), edgeCount - 1)},
+        {"decreasing in offsets", patch(sections[3] + (nodeCount / 2) * sizeof(uint32_t), edgeCount)},
+        {"edge source out of range", patch(sections[4] + (edgeCount - 1) * sizeof(NodeId), 0xFFFFFFFF)},
+        {"name offset out of range", patch(sections[6] + sizeof(uint32_t), static_cast<uint32_t>(header.nameBytes) + 1)},
+        {"last name offset", patch(sections[6] + nodeCount * sizeof(uint32_t), 0)}
+    };
+
+    unsigned int mismatches = 0;
+    for(const auto& [description, content] : damaged)
+    {
+        writeFile(pPath, content);
+        bool rejected = false;
+        try
+        {
+            GraphSnapshot snapshot(pPath);
+        }
+        catch(const std::runtime_error&)
+        {
+            rejected = true;
+        }
+        if(!rejected)
+        {
+            mismatches++;
+            std::cout << "Damaged snapshot: Accepted " << description << std::endl;
+        }
+    }
+
+    /*The undamaged file has to be accepted, else the checks above prove nothing*/
+    writeFile(pPath, original);
+    try
+    {
+        GraphSnapshot snapshot(pPath);
+    }
+    catch(const std::runtime_error&)
+    {
+        mismatches++;
+        std::cout << "Damaged snapshot: Rejected the original" << std::endl;
+    }
+    return mismatches;
+}
+
+/**
+ * @brief Main entry point for the test program; Runs all checks
+ *
+ * @param argc Argument count
+ * @param argv Argument values: [<number of round trip instances>] [<seed>]
+ * @return int 0 if all checks passed, 1 otherwise
+ */
+int main(int argc, char* argv[])
+{
+    unsigned int numInstances = argc > 1 ? std::stoi(argv[1]) : 100;
+    unsigned int seed = argc > 2 ? std::stoi(argv[2]) : 7;
+    std::mt19937 random(seed);
+    const std::string path = (std::filesystem::temp_directory_path() / ("SnapshotTest" + std::to_string(seed) + ".snp")).string();
+
+    unsigned int mismatches = 0;
+    mismatches += checkRoundTrip(random, numInstances, path);
+    mismatches += checkDamagedSnapshots(random, path);
+    std::filesystem::remove(path);
+
+    std::cout << "Compared " << numInstances << " snapshots, " << mismatches << " mismatches" << std::endl;
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,62 @@
+/**
+ * @file BidirectionalSearch.cpp
+ * @author Lennart Hustermeier (lennart.hustermeier@gmx.de)
+ * @brief Contains the non-template parts of the bidirectional A* and its instantiations
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "BidirectionalSearch.hpp"
+
+template<class GraphType> BasicBidirectionalSearch<GraphType>::BasicBidirectionalSearch(const GraphType& pGraph, std::pmr::memory_resource* pResource)
+: graph(pGraph), gForward(pResource), gBackward(pResource), parentForward(pResource), parentBackward(pResource), potentials(pResource),
+  touched(pResource), touchedNodes(pResource), forward(pResource), backward(pResource), expansions(0)
+{
+    const size_t nodeCount = this->graph.getNodeCount();
+    this->gForward.assign(nodeCount, std::numeric_limits<double>::infinity());
+    this->gBackward.assign(nodeCount, std::numeric_limits<double>::infinity());
+    this->parentForward.assign(nodeCount, CompactGraph::INVALID_NODE);
+    this->parentBackward.assign(nodeCount, CompactGraph::INVALID_NODE);
+    this->potentials.assign(nodeCount, 0.0);
+    this->touched.assign(nodeCount, false);
+}
+template<class GraphType> BasicBidirectionalSearch<GraphType>& BasicBidirectionalSearch<GraphType>::getThreadSearch(const std::shared_ptr<const GraphType>& pGraph)
+{
+    /*The graph is only referenced weakly, so a thread never keeps an outdated graph alive; Once it expired, the search is rebuilt
+    even if a new graph got the same address*/
+    thread_local std::weak_ptr<const GraphType> owner;
+    thread_local std::unique_ptr<BasicBidirectionalSearch<GraphType>> search;
+    if(!search || owner.expired() || owner.lock() != pGraph)
+    {
+        search.reset();
+        search = std::make_unique<BasicBidirectionalSearch<GraphType>>(*pGraph);
+        owner = pGraph;
+    }
+    return *search;
+}
+template<class GraphType> size_t BasicBidirectionalSearch<GraphType>::getExpansions() const
+{
+    return this->expansions;
+}
+template<class GraphType> void BasicBidirectionalSearch<GraphType>::reset()
+{
+    for(NodeId n : this->touchedNodes)
+    {
+        this->gForward[n] = std::numeric_limits<double>::infinity();
+        this->gBackward[n] = std::numeric_limits<double>::infinity();
+        this->parentForward[n] = CompactGraph::INVALID_NODE;
+        this->parentBackward[n] = CompactGraph::INVALID_NODE;
+        this->touched[n] = false;
+    }
+    this->touchedNodes.clear();
+    this->forward.clear();
+    this->backward.clear();
+    this->expansions = 0;
+}
+template class BasicBidirectionalSearch<CompactGraph>;
+template class BasicBidirectionalSearch<LatticeGraph>;
+template class BasicBidirectionalSearch<GraphSnapshot>;
+template class BasicBidirectionalSearch<BlockedGraph>;
@@ -0,0 +1,269 @@
+/**
+ * @file BidirectionalSearch.hpp
+ * @author Lennart Hustermeier (lennart.hustermeier@gmx.de)
+ * @brief Contains a bidirectional A* for point-to-point queries without temporal constraints
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include "BlockedGraph.hpp"
+#include "CompactGraph.hpp"
+#include "LatticeGraph.hpp"
+#include "GraphSnapshot.hpp"
+#include "IndexedHeap.hpp"
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+
+/**
+ * @brief Bidirectional A*: A forward search from the start node and a backward search from the target node run alternately until
+ * the best connection found so far can not be improved anymore. Both searches use the average potential
+ * p(v) = (hForward(v) - hBackward(v)) / 2, which turns them into a bidirectional Dijkstra on consistent reduced edge costs; The
+ * search thus stops as soon as <smallest forward key> + <smallest backward key> >= <costs of the best connection>. Without a
+ * heuristic this is a bidirectional Dijkstra. The search does not know timesteps, so it can only be used without constraints.
+ *
+ * @tparam GraphType The graph to search in; Has to provide getNodeCount(), isBlocked(<node>),
+ * forEachOutgoing(<node>, <callback(target, weight)>) and forEachIncoming(<node>, <callback(source, weight)>) (instantiated for
+ * CompactGraph, LatticeGraph, GraphSnapshot and BlockedGraph)
+ */
+template<class GraphType> class BasicBidirectionalSearch
+{
+public:
+    /**
+     * @brief Creates a new search on a graph; The instance can be reused for multiple searches on the same graph and only resets
+     * the nodes touched by the previous search
+     *
+     * @param pGraph The graph to search in
+     * @param pResource The memory resource for the per-node data (e.g. the SearchArena of the thread)
+     */
+    BasicBidirectionalSearch(const GraphType& pGraph, std::pmr::memory_resource* pResource=std::pmr::get_default_resource());
+
+    /**
+     * @brief Returns the search of the current thread for a graph; The per-node arrays are only allocated when the thread queries
+     * another graph than before, so repeated point-to-point queries only pay for the nodes they touch. The search must not be used
+     * recursively (e.g. from a heuristic of a query on the same graph).
+     *
+     * @param pGraph The graph to search in
+     * @return BasicBidirectionalSearch& The search of the thread; Valid until the thread queries another graph
+     */
+    static BasicBidirectionalSearch& getThreadSearch(const std::shared_ptr<const GraphType>& pGraph);
+
+    /**
+     * @brief Searches a cost optimal path from pStart to pTarget which avoids the obstacles
+     *
+     * @tparam ForwardHeuristic Callable with the signature double(NodeId); Estimated costs from a node to pTarget
+     * @tparam BackwardHeuristic Callable with the signature double(NodeId); Estimated costs from pStart to a node
+     * @param pStart The start node
+     * @param pTarget The target node
+     * @param pForwardH The consistent forward heuristic; Nodes with an infinite estimate are never expanded
+     * @param pBackwardH The consistent backward heuristic; Nodes with an infinite estimate are never expanded
+     * @param pBlocked Nodes which shall not be entered (indexed by node ID); May be empty if there are no obstacles
+     * @return std::vector<NodeId> The path or an empty vector if there is no such path
+     */
+    template<class ForwardHeuristic, class BackwardHeuristic> std::vector<NodeId> findPath(NodeId pStart, NodeId pTarget, const ForwardHeuristic& pForwardH, const BackwardHeuristic& pBackwardH, const std::vector<bool>& pBlocked=std::vector<bool>())
+    {
+        this->reset();
+
+        const size_t nodeCount = this->graph.getNodeCount();
+        if(pStart >= nodeCount || pTarget >= nodeCount || this->graph.isBlocked(pStart) || this->graph.isBlocked(pTarget) ||
+           (!pBlocked.empty() && (pBlocked[pStart] || pBlocked[pTarget])))
+        {
+            return std::vector<NodeId>();
+        }
+        if(pStart == pTarget)
+        {
+            return std::vector<NodeId>{pStart};
+        }
+
+        /*Calculates the potential of a node on first use; Nodes from which the target can not be reached or which can not be
+        reached from the start get an infinite potential and are skipped by both searches*/
+        auto potential = [&](NodeId pNode) {
+            if(!this->touched[pNode])
+            {
+                this->touched[pNode] = true;
+                this->touchedNodes.push_back(pNode);
+                const double hForward = pForwardH(pNode);
+                const double hBackward = pBackwardH(pNode);
+                if(hForward == std::numeric_limits<double>::infinity() || hBackward == std::numeric_limits<double>::infinity())
+                {
+                    this->potentials[pNode] = std::numeric_limits<double>::infinity();
+                }
+                else
+                {
+                    this->potentials[pNode] = (hForward - hBackward) / 2;
+                }
+            }
+            return this->potentials[pNode];
+        };
+
+        if(potential(pStart) == std::numeric_limits<double>::infinity() || potential(pTarget) == std::numeric_limits<double>::infinity())
+        {
+            return std::vector<NodeId>();
+        }
+        this->gForward[pStart] = 0.0;
+        this->forward.push(pStart, potential(pStart));
+        this->gBackward[pTarget] = 0.0;
+        this->backward.push(pTarget, -potential(pTarget));
+
+        double best = std::numeric_limits<double>::infinity();
+        NodeId meeting = CompactGraph::INVALID_NODE;
+
+        /*Relaxes the edge to pNext in one direction; pNext is settled in the other direction if its costs there are finite*/
+        auto relax = [&](NodeId pCurrent, NodeId pNext, double pWeight, std::pmr::vector<double>& pG, const std::pmr::vector<double>& pOtherG,
+                         std::pmr::vector<NodeId>& pParent, IndexedHeap<double>& pOpen, double pSign) {
+            if(!pBlocked.empty() && pBlocked[pNext])
+            {
+                return;
+            }
+            const double p = potential(pNext);
+            if(p == std::numeric_limits<double>::infinity())
+            {
+                return;
+            }
+            const double tentativeG = pG[pCurrent] + pWeight;
+            if(tentativeG >= pG[pNext])
+            {
+                return;
+            }
+            pG[pNext] = tentativeG;
+            pParent[pNext] = pCurrent;
+            if(pOpen.contains(pNext))
+            {
+                pOpen.decreaseKey(pNext, tentativeG + pSign * p);
+            }
+            else
+            {
+                pOpen.push(pNext, tentativeG + pSign * p);
+            }
+            if(tentativeG + pOtherG[pNext] < best)
+            {
+                best = tentativeG + pOtherG[pNext];
+                meeting = pNext;
+            }
+        };
+
+        while(!this->forward.empty() && !this->backward.empty())
+        {
+            if(this->forward.topKey() + this->backward.topKey() >= best)
+            {
+                /*No connection through a node which is not settled in both directions can be cheaper*/
+                break;
+            }
+
+            this->expansions++;
+            if(this->forward.topKey() <= this->backward.topKey())
+            {
+                const NodeId current = this->forward.pop();
+                this->graph.forEachOutgoing(current, [&](NodeId pNext, double pWeight) {
+                    relax(current, pNext, pWeight, this->gForward, this->gBackward, this->parentForward, this->forward, 1.0);
+                });
+            }
+            else
+            {
+                const NodeId current = this->backward.pop();
+                this->graph.forEachIncoming(current, [&](NodeId pNext, double pWeight) {
+                    relax(current, pNext, pWeight, this->gBackward, this->gForward, this->parentBackward, this->backward, -1.0);
+                });
+            }
+        }
+
+        if(meeting == CompactGraph::INVALID_NODE)
+        {
+            return std::vector<NodeId>();
+        }
+
+        /*Join the forward path to the meeting node and the backward path from it*/
+        std::vector<NodeId> result;
+        for(NodeId n = meeting; n != CompactGraph::INVALID_NODE; n = this->parentForward[n])
+        {
+            result.push_back(n);
+        }
+        std::reverse(result.begin(), result.end());
+        for(NodeId n = this->parentBackward[meeting]; n != CompactGraph::INVALID_NODE; n = this->parentBackward[n])
+        {
+            result.push_back(n);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Returns the number of nodes expanded by the last search (in both directions)
+     *
+     * @return size_t Number of expansions
+     */
+    size_t getExpansions() const;
+protected:
+    /**
+     * @brief Resets the nodes touched by the last search
+     */
+    void reset();
+
+    /**
+     * @brief The graph to search in
+     */
+    const GraphType& graph;
+
+    /**
+     * @brief The costs from the start node and to the target node
+     */
+    std::pmr::vector<double> gForward;
+    std::pmr::vector<double> gBackward;
+
+    /**
+     * @brief The predecessors in the forward search and the successors in the backward search
+     */
+    std::pmr::vector<NodeId> parentForward;
+    std::pmr::vector<NodeId> parentBackward;
+
+    /**
+     * @brief The potential of every touched node
+     */
+    std::pmr::vector<double> potentials;
+
+    /**
+     * @brief Marks the nodes which were touched by the current search
+     */
+    std::pmr::vector<bool> touched;
+
+    /**
+     * @brief The nodes which were touched by the current search
+     */
+    std::pmr::vector<NodeId> touchedNodes;
+
+    /**
+     * @brief The open lists of both directions
+     */
+    IndexedHeap<double> forward;
+    IndexedHeap<double> backward;
+
+    /**
+     * @brief Counts the expansions of the last search
+     */
+    size_t expansions;
+};
+
+/**
+ * @brief The bidirectional A* on compact graphs
+ */
+typedef BasicBidirectionalSearch<CompactGraph> BidirectionalSearch;
+
+/**
+ * @brief The bidirectional A* on implicit lattices
+ */
+typedef BasicBidirectionalSearch<LatticeGraph> LatticeBidirectionalSearch;
+
+/**
+ * @brief The bidirectional A* on memory-mapped graph snapshots
+ */
+typedef BasicBidirectionalSearch<GraphSnapshot> SnapshotBidirectionalSearch;
+
+/**
+ * @brief The bidirectional A* on compact graphs with blocked nodes and edges
+ */
+typedef BasicBidirectionalSearch<BlockedGraph> BlockedBidirectionalSearch;
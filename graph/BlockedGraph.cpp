@@ -0,0 +1,154 @@
+/**
+ * @file BlockedGraph.cpp
+ * @author Lennart Hustermeier (lennart.hustermeier@gmx.de)
+ * @brief Contains the implementation of the dynamic obstacle layer
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "BlockedGraph.hpp"
+#include <algorithm>
+
+BlockedGraph::BlockedGraph(std::shared_ptr<const CompactGraph> pGraph)
+: graph(pGraph), blockedNodes((pGraph->getNodeCount() + 63) / 64, 0), blockedOutgoing((pGraph->getEdgeCount() + 63) / 64, 0),
+  blockedIncoming((pGraph->getEdgeCount() + 63) / 64, 0), blockedCount(0)
+{
+
+}
+BlockedGraph::BlockedGraph(std::shared_ptr<const CompactGraph> pGraph, const BlockedGraph& pOther)
+: BlockedGraph(pGraph)
+{
+    if(pOther.blockedCount == 0)
+    {
+        return;
+    }
+    const CompactGraph& other = *pOther.graph;
+    for(NodeId n = 0; n < other.getNodeCount(); n++)
+    {
+        const NodeId id = this->graph->getNodeId(other.getNodeName(n));
+        if(id == CompactGraph::INVALID_NODE)
+        {
+            continue;
+        }
+        if(pOther.isBlocked(n))
+        {
+            this->setBlocked(id, true);
+        }
+        std::span<const NodeId> targets = other.getOutgoing(n);
+        for(size_t i = 0; i < targets.size(); i++)
+        {
+            if(isSet(pOther.blockedOutgoing, other.getOutgoingOffset(n) + i))
+            {
+                const NodeId to = this->graph->getNodeId(other.getNodeName(targets[i]));
+                if(to != CompactGraph::INVALID_NODE)
+                {
+                    this->setEdgeBlocked(id, to, true);
+                }
+            }
+        }
+    }
+}
+const std::shared_ptr<const CompactGraph>& BlockedGraph::getGraph() const
+{
+    return this->graph;
+}
+size_t BlockedGraph::getNodeCount() const
+{
+    return this->graph->getNodeCount();
+}
+NodeId BlockedGraph::getNodeId(const NodeType& pNode) const
+{
+    return this->graph->getNodeId(pNode);
+}
+const NodeType& BlockedGraph::getNodeName(NodeId pNode) const
+{
+    return this->graph->getNodeName(pNode);
+}
+void BlockedGraph::setBlocked(NodeId pNode, bool pBlocked)
+{
+    if(assign(this->blockedNodes, pNode, pBlocked))
+    {
+        this->blockedCount = pBlocked ? this->blockedCount + 1 : this->blockedCount - 1;
+    }
+}
+bool BlockedGraph::setEdgeBlocked(NodeId pFrom, NodeId pTo, bool pBlocked)
+{
+    const uint32_t outgoing = this->findOutgoing(pFrom, pTo);
+    if(outgoing == CompactGraph::INVALID_NODE)
+    {
+        return false;
+    }
+    if(assign(this->blockedOutgoing, outgoing, pBlocked))
+    {
+        this->blockedCount = pBlocked ? this->blockedCount + 1 : this->blockedCount - 1;
+    }
+
+    /*The edge also exists in the incoming order of its end node*/
+    std::span<const NodeId> sources = this->graph->getIncoming(pTo);
+    const size_t i = std::lower_bound(sources.begin(), sources.end(), pFrom) - sources.begin();
+    assign(this->blockedIncoming, this->graph->getIncomingOffset(pTo) + i, pBlocked);
+    return true;
+}
+bool BlockedGraph::isEdgeBlocked(NodeId pFrom, NodeId pTo) const
+{
+    const uint32_t outgoing = this->findOutgoing(pFrom, pTo);
+    return outgoing != CompactGraph::INVALID_NODE && isSet(this->blockedOutgoing, outgoing);
+}
+size_t BlockedGraph::getBlockedCount() const
+{
+    return this->blockedCount;
+}
+void BlockedGraph::clear()
+{
+    std::fill(this->blockedNodes.begin(), this->blockedNodes.end(), 0);
+    std::fill(this->blockedOutgoing.begin(), this->blockedOutgoing.end(), 0);
+    std::fill(this->blockedIncoming.begin(), this->blockedIncoming.end(), 0);
+    this->blockedCount = 0;
+}
+std::vector<bool> BlockedGraph::getBlockedNodes() const
+{
+    std::vector<bool> result(this->graph->getNodeCount(), false);
+    for(NodeId n = 0; n < result.size(); n++)
+    {
+        result[n] = this->isBlocked(n);
+    }
+    return result;
+}
+std::optional<double> BlockedGraph::getWeight(NodeId pFrom, NodeId pTo) const
+{
+    if(this->isBlocked(pFrom) || this->isBlocked(pTo) || this->isEdgeBlocked(pFrom, pTo))
+    {
+        return std::optional<double>();
+    }
+    return this->graph->getWeight(pFrom, pTo);
+}
+double BlockedGraph::getPathCost(const std::vector<NodeId>& pPath) const
+{
+    return this->graph->getPathCost(pPath);
+}
+bool BlockedGraph::assign(std::vector<uint64_t>& pBits, size_t pIndex, bool pValue)
+{
+    if(isSet(pBits, pIndex) == pValue)
+    {
+        return false;
+    }
+    pBits[pIndex >> 6] ^= (1ULL << (pIndex & 63));
+    return true;
+}
+uint32_t BlockedGraph::findOutgoing(NodeId pFrom, NodeId pTo) const
+{
+    if(pFrom >= this->graph->getNodeCount())
+    {
+        return CompactGraph::INVALID_NODE;
+    }
+    std::span<const NodeId> targets = this->graph->getOutgoing(pFrom);
+    std::span<const NodeId>::iterator e = std::lower_bound(targets.begin(), targets.end(), pTo);
+    if(e == targets.end() || *e != pTo)
+    {
+        return CompactGraph::INVALID_NODE;
+    }
+    return this->graph->getOutgoingOffset(pFrom) + static_cast<uint32_t>(e - targets.begin());
+}
@@ -0,0 +1,250 @@
+/**
+ * @file BlockedGraph.hpp
+ * @author Lennart Hustermeier (lennart.hustermeier@gmx.de)
+ * @brief Contains a dynamic obstacle layer (blocked nodes and edges) on top of an immutable compact graph
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include "CompactGraph.hpp"
+#include <memory>
+
+/**
+ * @brief A CompactGraph together with one bit per node and one bit per edge which marks it as blocked. Blocking and unblocking
+ * only flips a bit, so no-fly zones and temporarily occupied nodes can change without rebuilding or copying the graph. Blocked
+ * nodes can neither be entered nor left and blocked edges are skipped by forEachOutgoing() and forEachIncoming(), so the search
+ * kernels (which are instantiated for this class) check the bits instead of looking up obstacle sets.
+ *
+ * Every edge has a bit in the outgoing and one in the incoming order of the compact graph; setEdgeBlocked() keeps both in sync.
+ * The layer must not be modified while searches run on it.
+ */
+class BlockedGraph
+{
+public:
+    /**
+     * @brief Creates a layer on a graph in which nothing is blocked
+     *
+     * @param pGraph The graph
+     */
+    BlockedGraph(std::shared_ptr<const CompactGraph> pGraph);
+
+    /**
+     * @brief Creates a layer on a graph which blocks the same nodes and edges (by name) as another layer; Used to keep the
+     * obstacles when the structure of a graph changed
+     *
+     * @param pGraph The graph
+     * @param pOther The layer to take the obstacles from; Obstacles which are not part of pGraph are dropped
+     */
+    BlockedGraph(std::shared_ptr<const CompactGraph> pGraph, const BlockedGraph& pOther);
+
+    /**
+     * @brief Returns the graph below the layer
+     *
+     * @return const std::shared_ptr<const CompactGraph>& The graph
+     */
+    const std::shared_ptr<const CompactGraph>& getGraph() const;
+
+    /**
+     * @brief Returns the number of nodes (including blocked ones)
+     *
+     * @return size_t Number of nodes
+     */
+    size_t getNodeCount() const;
+
+    /**
+     * @brief Returns the ID of a node
+     *
+     * @param pNode The name of the node
+     * @return NodeId The ID or CompactGraph::INVALID_NODE if the node is not part of the graph
+     */
+    NodeId getNodeId(const NodeType& pNode) const;
+
+    /**
+     * @brief Returns the name of a node
+     *
+     * @param pNode The ID of the node
+     * @return const NodeType& The name
+     */
+    const NodeType& getNodeName(NodeId pNode) const;
+
+    /**
+     * @brief Blocks or unblocks a node
+     *
+     * @param pNode The node (has to be valid)
+     * @param pBlocked true to block the node, false to unblock it
+     */
+    void setBlocked(NodeId pNode, bool pBlocked);
+
+    /**
+     * @brief Returns if a node is blocked
+     *
+     * @param pNode The node (has to be valid)
+     * @return true The node is an obstacle
+     * @return false The node can be entered
+     */
+    bool isBlocked(NodeId pNode) const
+    {
+        return (this->blockedNodes[pNode >> 6] >> (pNode & 63)) & 1;
+    }
+
+    /**
+     * @brief Blocks or unblocks an edge
+     *
+     * @param pFrom The start node of the edge
+     * @param pTo The end node of the edge
+     * @param pBlocked true to block the edge, false to unblock it
+     * @return true The edge was found
+     * @return false There is no such edge
+     */
+    bool setEdgeBlocked(NodeId pFrom, NodeId pTo, bool pBlocked);
+
+    /**
+     * @brief Returns if an edge is blocked
+     *
+     * @param pFrom The start node of the edge
+     * @param pTo The end node of the edge
+     * @return true The edge exists and is blocked
+     * @return false The edge does not exist or is not blocked
+     */
+    bool isEdgeBlocked(NodeId pFrom, NodeId pTo) const;
+
+    /**
+     * @brief Returns the number of blocked nodes and edges; 0 if the layer does not restrict the graph
+     *
+     * @return size_t Number of blocked nodes plus number of blocked edges
+     */
+    size_t getBlockedCount() const;
+
+    /**
+     * @brief Unblocks all nodes and edges
+     */
+    void clear();
+
+    /**
+     * @brief Returns the blocked nodes as vector of flags (as used by ShortestPathTree and HopDistanceMatrix)
+     *
+     * @return std::vector<bool> true for every blocked node
+     */
+    std::vector<bool> getBlockedNodes() const;
+
+    /**
+     * @brief Calls pCallback(<target>, <weight>) for every outgoing edge of a node which is not blocked and leads to a node that
+     * is not blocked
+     *
+     * @tparam Callback Callable with the signature void(NodeId, double)
+     * @param pNode The node (has to be valid and not blocked)
+     * @param pCallback The callback to call for every edge
+     */
+    template<class Callback> void forEachOutgoing(NodeId pNode, Callback&& pCallback) const
+    {
+        std::span<const NodeId> targets = this->graph->getOutgoing(pNode);
+        std::span<const double> weights = this->graph->getOutgoingWeights(pNode);
+        const uint32_t offset = this->graph->getOutgoingOffset(pNode);
+        for(size_t i = 0; i < targets.size(); i++)
+        {
+            if(!this->isBlocked(targets[i]) && !isSet(this->blockedOutgoing, offset + i))
+            {
+                pCallback(targets[i], weights[i]);
+            }
+        }
+    }
+
+    /**
+     * @brief Calls pCallback(<source>, <weight>) for every incoming edge of a node which is not blocked and comes from a node
+     * that is not blocked
+     *
+     * @tparam Callback Callable with the signature void(NodeId, double)
+     * @param pNode The node (has to be valid and not blocked)
+     * @param pCallback The callback to call for every edge
+     */
+    template<class Callback> void forEachIncoming(NodeId pNode, Callback&& pCallback) const
+    {
+        std::span<const NodeId> sources = this->graph->getIncoming(pNode);
+        std::span<const double> weights = this->graph->getIncomingWeights(pNode);
+        const uint32_t offset = this->graph->getIncomingOffset(pNode);
+        for(size_t i = 0; i < sources.size(); i++)
+        {
+            if(!this->isBlocked(sources[i]) && !isSet(this->blockedIncoming, offset + i))
+            {
+                pCallback(sources[i], weights[i]);
+            }
+        }
+    }
+
+    /**
+     * @brief Returns the weight of an edge
+     *
+     * @param pFrom The start node of the edge
+     * @param pTo The end node of the edge
+     * @return std::optional<double> The weight of the edge or an empty optional if there is no such edge (or it or one of its nodes
+     * is blocked)
+     */
+    std::optional<double> getWeight(NodeId pFrom, NodeId pTo) const;
+
+    /**
+     * @brief Returns the costs of a path in the graph below the layer (obstacles do not change the costs)
+     *
+     * @param pPath The path as a vector of node IDs
+     * @return double The costs of the path
+     */
+    double getPathCost(const std::vector<NodeId>& pPath) const;
+protected:
+    /**
+     * @brief Returns if a bit of a bitset is set
+     *
+     * @param pBits The bitset
+     * @param pIndex The index of the bit
+     * @return true The bit is set
+     * @return false The bit is not set
+     */
+    static bool isSet(const std::vector<uint64_t>& pBits, size_t pIndex)
+    {
+        return (pBits[pIndex >> 6] >> (pIndex & 63)) & 1;
+    }
+
+    /**
+     * @brief Sets or clears a bit of a bitset
+     *
+     * @param pBits The bitset
+     * @param pIndex The index of the bit
+     * @param pValue The new value of the bit
+     * @return true The value of the bit changed
+     * @return false The bit already had this value
+     */
+    static bool assign(std::vector<uint64_t>& pBits, size_t pIndex, bool pValue);
+
+    /**
+     * @brief Returns the index of an outgoing edge in the order of the compact graph
+     *
+     * @param pFrom The start node of the edge
+     * @param pTo The end node of the edge
+     * @return uint32_t The index or CompactGraph::INVALID_NODE if there is no such edge
+     */
+    uint32_t findOutgoing(NodeId pFrom, NodeId pTo) const;
+
+    /**
+     * @brief The graph below the layer
+     */
+    std::shared_ptr<const CompactGraph> graph;
+
+    /**
+     * @brief One bit per node, set if the node is blocked
+     */
+    std::vector<uint64_t> blockedNodes;
+
+    /**
+     * @brief One bit per edge in the outgoing respectively incoming order of the compact graph, set if the edge is blocked
+     */
+    std::vector<uint64_t> blockedOutgoing;
+    std::vector<uint64_t> blockedIncoming;
+
+    /**
+     * @brief The number of blocked nodes plus the number of blocked edges
+     */
+    size_t blockedCount;
+};
@@ -0,0 +1,167 @@
+/**
+ * @file CompactGraph.cpp
+ * @author Lennart Hustermeier (lennart.hustermeier@gmx.de)
+ * @brief Contains the implementation of the compressed sparse row graph representation
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "CompactGraph.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+CompactGraph::CompactGraph(const std::set<NodeType>& pNodes, const std::map<NodeType, std::set<NodeType>>& pEdges, const std::map<std::pair<NodeType, NodeType>, double>& pWeights)
+: names(pNodes.begin(), pNodes.end())
+{
+    /*The node names are sorted, thus the IDs follow the order of the std::set used by Graph*/
+    this->outOffsets.reserve(this->names.size() + 1);
+    this->outOffsets.push_back(0);
+    for(const NodeType& n : this->names)
+    {
+        std::map<NodeType, std::set<NodeType>>::const_iterator e = pEdges.find(n);
+        if(e != pEdges.end())
+        {
+            for(const NodeType& to : e->second)
+            {
+                NodeId toId = this->getNodeId(to);
+                if(toId == INVALID_NODE)
+                {
+                    continue;
+                }
+                /*The targets are visited in sorted order, thus every range is sorted by ID*/
+                this->outTargets.push_back(toId);
+                this->outWeights.push_back(pWeights.at(std::make_pair(n, to)));
+            }
+        }
+        this->outOffsets.push_back(static_cast<uint32_t>(this->outTargets.size()));
+    }
+
+    /*Build the incoming edges by counting the in-degree of each node first*/
+    this->inOffsets.assign(this->names.size() + 1, 0);
+    for(NodeId to : this->outTargets)
+    {
+        this->inOffsets[to + 1]++;
+    }
+    for(size_t n = 0; n < this->names.size(); n++)
+    {
+        this->inOffsets[n + 1] += this->inOffsets[n];
+    }
+    this->inSources.resize(this->outTargets.size());
+    this->inWeights.resize(this->outTargets.size());
+
+    std::vector<uint32_t> fill(this->inOffsets.begin(), this->inOffsets.end() - 1);
+    for(NodeId from = 0; from < this->names.size(); from++)
+    {
+        /*Sources are visited in ascending order, thus the incoming ranges are sorted as well*/
+        for(uint32_t e = this->outOffsets[from]; e < this->outOffsets[from + 1]; e++)
+        {
+            uint32_t slot = fill[this->outTargets[e]]++;
+            this->inSources[slot] = from;
+            this->inWeights[slot] = this->outWeights[e];
+        }
+    }
+}
+size_t CompactGraph::getNodeCount() const
+{
+    return this->names.size();
+}
+size_t CompactGraph::getEdgeCount() const
+{
+    return this->outTargets.size();
+}
+NodeId CompactGraph::getNodeId(const NodeType& pNode) const
+{
+    std::vector<NodeType>::const_iterator i = std::lower_bound(this->names.begin(), this->names.end(), pNode);
+    if(i == this->names.end() || *i != pNode)
+    {
+        return INVALID_NODE;
+    }
+    return static_cast<NodeId>(i - this->names.begin());
+}
+const NodeType& CompactGraph::getNodeName(NodeId pNode) const
+{
+    return this->names[pNode];
+}
+std::span<const NodeId> CompactGraph::getOutgoing(NodeId pNode) const
+{
+    return std::span<const NodeId>(this->outTargets.data() + this->outOffsets[pNode], this->outOffsets[pNode + 1] - this->outOffsets[pNode]);
+}
+std::span<const double> CompactGraph::getOutgoingWeights(NodeId pNode) const
+{
+    return std::span<const double>(this->outWeights.data() + this->outOffsets[pNode], this->outOffsets[pNode + 1] - this->outOffsets[pNode]);
+}
+std::span<const NodeId> CompactGraph::getIncoming(NodeId pNode) const
+{
+    return std::span<const NodeId>(this->inSources.data() + this->inOffsets[pNode], this->inOffsets[pNode + 1] - this->inOffsets[pNode]);
+}
+std::span<const double> CompactGraph::getIncomingWeights(NodeId pNode) const
+{
+    return std::span<const double>(this->inWeights.data() + this->inOffsets[pNode], this->inOffsets[pNode + 1] - this->inOffsets[pNode]);
+}
+std::optional<double> CompactGraph::getWeight(NodeId pFrom, NodeId pTo) const
+{
+    if(pFrom >= this->names.size())
+    {
+        return {};
+    }
+    std::span<const NodeId> outgoing = this->getOutgoing(pFrom);
+    std::span<const NodeId>::iterator i = std::lower_bound(outgoing.begin(), outgoing.end(), pTo);
+    if(i == outgoing.end() || *i != pTo)
+    {
+        return {};
+    }
+    return this->getOutgoingWeights(pFrom)[i - outgoing.begin()];
+}
+std::optional<double> CompactGraph::getUniformWeight() const
+{
+    if(this->outWeights.empty())
+    {
+        return 0.0;
+    }
+    for(double w : this->outWeights)
+    {
+        if(w != this->outWeights.front())
+        {
+            return {};
+        }
+    }
+    return this->outWeights.front();
+}
+double CompactGraph::getPathCost(const std::vector<NodeId>& pPath) const
+{
+    double sum = 0.0;
+    size_t cntr;
+    for(cntr = 1; cntr < pPath.size(); cntr++)
+    {
+        std::optional<double> w = this->getWeight(pPath[cntr - 1], pPath[cntr]);
+        if(!w.has_value())
+        {
+            throw(std::out_of_range("CompactGraph::getPathCost(): The path contains an edge which is not part of the graph!"));
+        }
+        sum += w.value();
+    }
+    return sum;
+}
+std::vector<NodeId> CompactGraph::toNodeIds(const std::vector<NodeType>& pPath) const
+{
+    std::vector<NodeId> result;
+    result.reserve(pPath.size());
+    for(const NodeType& n : pPath)
+    {
+        result.push_back(this->getNodeId(n));
+    }
+    return result;
+}
+std::vector<NodeType> CompactGraph::toNodeNames(const std::vector<NodeId>& pPath) const
+{
+    std::vector<NodeType> result;
+    result.reserve(pPath.size());
+    for(NodeId n : pPath)
+    {
+        result.push_back(this->names[n]);
+    }
+    return result;
+}
@@ -0,0 +1,255 @@
+/**
+ * @file CompactGraph.hpp
+ * @author Lennart Hustermeier (lennart.hustermeier@gmx.de)
+ * @brief Contains an immutable, integer indexed graph representation (compressed sparse row) used by the search algorithms
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <optional>
+#include <set>
+#include <span>
+#include <string>
+#include <vector>
+
+/**
+ * @brief The type used to identify nodes at the API boundary of a Graph
+ */
+typedef std::string NodeType;
+
+/**
+ * @brief A dense node index as used inside of a CompactGraph; Node IDs are in the range [0, <number of nodes>)
+ */
+typedef uint32_t NodeId;
+
+/**
+ * @brief An immutable compressed sparse row (CSR) representation of a Graph. All nodes are interned to dense IDs, the outgoing
+ * and incoming edges of a node are stored as contiguous ranges of neighbour IDs and weights. Node IDs are assigned in the
+ * lexicographic order of the node names, so iterating over IDs visits the nodes in the same order as the Graph does.
+ */
+class CompactGraph
+{
+public:
+    /**
+     * @brief Marks an invalid node ID (e.g. the result of a lookup of a node which is not part of the graph)
+     */
+    static constexpr NodeId INVALID_NODE = std::numeric_limits<NodeId>::max();
+
+    /**
+     * @brief Constructs a compact graph from the representation used by Graph
+     *
+     * @param pNodes The nodes of the graph
+     * @param pEdges A mapping <from> -> <to (set)> containing all edges
+     * @param pWeights A mapping (<from>, <to>) -> <weight> containing all edge weights
+     */
+    CompactGraph(const std::set<NodeType>& pNodes, const std::map<NodeType, std::set<NodeType>>& pEdges, const std::map<std::pair<NodeType, NodeType>, double>& pWeights);
+
+    /**
+     * @brief Returns the number of nodes in the graph
+     *
+     * @return size_t Number of nodes
+     */
+    size_t getNodeCount() const;
+
+    /**
+     * @brief Returns the number of (directed) edges in the graph
+     *
+     * @return size_t Number of edges
+     */
+    size_t getEdgeCount() const;
+
+    /**
+     * @brief Returns the ID of a node
+     *
+     * @param pNode The name of the node
+     * @return NodeId The ID of the node or INVALID_NODE if the node is not part of the graph
+     */
+    NodeId getNodeId(const NodeType& pNode) const;
+
+    /**
+     * @brief Returns the name of a node
+     *
+     * @param pNode The ID of the node (has to be valid)
+     * @return const NodeType& The name of the node
+     */
+    const NodeType& getNodeName(NodeId pNode) const;
+
+    /**
+     * @brief Returns the targets of all outgoing edges of a node (sorted by ID)
+     *
+     * @param pNode The node to get the outgoing edges for
+     * @return std::span<const NodeId> The targets of the outgoing edges
+     */
+    std::span<const NodeId> getOutgoing(NodeId pNode) const;
+
+    /**
+     * @brief Returns the weights of all outgoing edges of a node in the same order as getOutgoing()
+     *
+     * @param pNode The node to get the outgoing edge weights for
+     * @return std::span<const double> The weights of the outgoing edges
+     */
+    std::span<const double> getOutgoingWeights(NodeId pNode) const;
+
+    /**
+     * @brief Calls pCallback(<target>, <weight>) for every outgoing edge of a node (same interface as LatticeGraph)
+     *
+     * @tparam Callback Callable with the signature void(NodeId, double)
+     * @param pNode The node to iterate the outgoing edges of
+     * @param pCallback The callback to call for every edge
+     */
+    template<class Callback> void forEachOutgoing(NodeId pNode, Callback&& pCallback) const
+    {
+        for(uint32_t e = this->outOffsets[pNode]; e < this->outOffsets[pNode + 1]; e++)
+        {
+            pCallback(this->outTargets[e], this->outWeights[e]);
+        }
+    }
+
+    /**
+     * @brief Returns the sources of all incoming edges of a node (sorted by ID)
+     *
+     * @param pNode The node to get the incoming edges for
+     * @return std::span<const NodeId> The sources of the incoming edges
+     */
+    std::span<const NodeId> getIncoming(NodeId pNode) const;
+
+    /**
+     * @brief Returns the weights of all incoming edges of a node in the same order as getIncoming()
+     *
+     * @param pNode The node to get the incoming edge weights for
+     * @return std::span<const double> The weights of the incoming edges
+     */
+    std::span<const double> getIncomingWeights(NodeId pNode) const;
+
+    /**
+     * @brief Calls pCallback(<source>, <weight>) for every incoming edge of a node (same interface as LatticeGraph)
+     *
+     * @tparam Callback Callable with the signature void(NodeId, double)
+     * @param pNode The node to iterate the incoming edges of
+     * @param pCallback The callback to call for every edge
+     */
+    template<class Callback> void forEachIncoming(NodeId pNode, Callback&& pCallback) const
+    {
+        for(uint32_t e = this->inOffsets[pNode]; e < this->inOffsets[pNode + 1]; e++)
+        {
+            pCallback(this->inSources[e], this->inWeights[e]);
+        }
+    }
+
+    /**
+     * @brief Returns the index of the first outgoing edge of a node; The i-th element of getOutgoing(pNode) is the edge
+     * getOutgoingOffset(pNode) + i, so per-edge data can be stored in arrays of size getEdgeCount()
+     *
+     * @param pNode The node
+     * @return uint32_t The index of the first outgoing edge
+     */
+    uint32_t getOutgoingOffset(NodeId pNode) const
+    {
+        return this->outOffsets[pNode];
+    }
+
+    /**
+     * @brief Returns the index of the first incoming edge of a node; The i-th element of getIncoming(pNode) is the incoming edge
+     * getIncomingOffset(pNode) + i
+     *
+     * @param pNode The node
+     * @return uint32_t The index of the first incoming edge
+     */
+    uint32_t getIncomingOffset(NodeId pNode) const
+    {
+        return this->inOffsets[pNode];
+    }
+
+    /**
+     * @brief Returns if a node is blocked; Compact graphs have no obstacles (same interface as LatticeGraph)
+     *
+     * @return false Always
+     */
+    constexpr bool isBlocked(NodeId) const
+    {
+        return false;
+    }
+
+    /**
+     * @brief Returns the weight of an edge
+     *
+     * @param pFrom The start node of the edge
+     * @param pTo The end node of the edge
+     * @return std::optional<double> The weight of the edge or an empty optional if there is no such edge
+     */
+    std::optional<double> getWeight(NodeId pFrom, NodeId pTo) const;
+
+    /**
+     * @brief Checks if all edges have the same weight, so distances are proportional to the number of hops
+     *
+     * @return std::optional<double> The weight of every edge (0 if there are no edges) or an empty optional if the weights differ
+     */
+    std::optional<double> getUniformWeight() const;
+
+    /**
+     * @brief Returns the costs of a path in this graph
+     *
+     * @param pPath The path as a vector of node IDs
+     * @return double The costs of the path; Throws std::out_of_range if two consecutive nodes are not connected by an edge
+     */
+    double getPathCost(const std::vector<NodeId>& pPath) const;
+
+    /**
+     * @brief Translates a path of node names to node IDs
+     *
+     * @param pPath The path as vector of node names
+     * @return std::vector<NodeId> The path as vector of node IDs; Unknown nodes are translated to INVALID_NODE
+     */
+    std::vector<NodeId> toNodeIds(const std::vector<NodeType>& pPath) const;
+
+    /**
+     * @brief Translates a path of node IDs to node names
+     *
+     * @param pPath The path as vector of node IDs
+     * @return std::vector<NodeType> The path as vector of node names
+     */
+    std::vector<NodeType> toNodeNames(const std::vector<NodeId>& pPath) const;
+protected:
+    /**
+     * @brief The interning table ID -> name; Sorted, so it can also be used for the lookup name -> ID
+     */
+    std::vector<NodeType> names;
+
+    /**
+     * @brief Offsets into outTargets/outWeights; The outgoing edges of node n are stored in [outOffsets[n], outOffsets[n+1])
+     */
+    std::vector<uint32_t> outOffsets;
+
+    /**
+     * @brief Targets of the outgoing edges of all nodes
+     */
+    std::vector<NodeId> outTargets;
+
+    /**
+     * @brief Weights of the outgoing edges of all nodes
+     */
+    std::vector<double> outWeights;
+
+    /**
+     * @brief Offsets into inSources/inWeights; The incoming edges of node n are stored in [inOffsets[n], inOffsets[n+1])
+     */
+    std::vector<uint32_t> inOffsets;
+
+    /**
+     * @brief Sources of the incoming edges of all nodes
+     */
+    std::vector<NodeId> inSources;
+
+    /**
+     * @brief Weights of the incoming edges of all nodes
+     */
+    std::vector<double> inWeights;
+};
@@ -0,0 +1,611 @@
+/**
+ * @file ContractionHierarchy.cpp
+ * @author Lennart Hustermeier (lennart.hustermeier@gmx.de)
+ * @brief Contains the preprocessing and the queries of contraction hierarchies
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "ContractionHierarchy.hpp"
+#include "LowLevelPlanner.hpp"
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+
+namespace
+{
+    /*The maximum number of nodes a witness search settles; If it gives up, the shortcut is added, which is never wrong but may be
+    redundant. The priorities only need an estimate of the shortcuts, so their simulated contractions search less*/
+    constexpr size_t WITNESS_SETTLE_LIMIT = 500;
+    constexpr size_t SIMULATION_SETTLE_LIMIT = 15;
+
+    /*An edge of the graph which is still being contracted*/
+    struct DynamicEdge
+    {
+        NodeId node;
+        double weight;
+        NodeId middle;
+    };
+
+    /*A shortcut which replaces the path from -> middle -> to*/
+    struct Shortcut
+    {
+        NodeId from;
+        NodeId to;
+        double weight;
+        NodeId middle;
+    };
+
+    typedef std::vector<std::vector<DynamicEdge>> DynamicGraph;
+
+    /*A bounded Dijkstra on the remaining graph which looks for paths that make a shortcut unnecessary; One instance per thread*/
+    class WitnessSearch
+    {
+    public:
+        WitnessSearch(size_t pNodeCount)
+        : distances(pNodeCount, std::numeric_limits<double>::infinity()), targets(pNodeCount, false)
+        {
+
+        }
+
+        /*Runs until the costs exceed pLimit, pSettleLimit nodes are settled or the targets are settled; The targets are the nodes
+        marked with setTarget()*/
+        template<class Skip> void run(const DynamicGraph& pOut, NodeId pSource, double pLimit, size_t pSettleLimit, size_t pTargetCount, const Skip& pSkip)
+        {
+            for(NodeId n : this->touchedNodes)
+            {
+                this->distances[n] = std::numeric_limits<double>::infinity();
+            }
+            this->touchedNodes.clear();
+            this->open.clear();
+
+            this->distances[pSource] = 0.0;
+            this->touchedNodes.push_back(pSource);
+            this->open.push(pSource, 0.0);
+            size_t settled = 0;
+            while(!this->open.empty() && this->open.topKey() <= pLimit && settled < pSettleLimit)
+            {
+                const NodeId current = this->open.pop();
+                settled++;
+                if(this->targets[current] && --pTargetCount == 0)
+                {
+                    break;
+                }
+                for(const DynamicEdge& e : pOut[current])
+                {
+                    const double distance = this->distances[current] + e.weight;
+                    if(pSkip(e.node) || distance >= this->distances[e.node])
+                    {
+                        continue;
+                    }
+                    if(this->distances[e.node] == std::numeric_limits<double>::infinity())
+                    {
+                        this->touchedNodes.push_back(e.node);
+                    }
+                    this->distances[e.node] = distance;
+                    if(this->open.contains(e.node))
+                    {
+                        this->open.decreaseKey(e.node, distance);
+                    }
+                    else
+                    {
+                        this->open.push(e.node, distance);
+                    }
+                }
+            }
+        }
+
+        void setTarget(NodeId pNode, bool pTarget)
+        {
+            this->targets[pNode] = pTarget;
+        }
+
+        /*Tentative distances are costs of real paths, so they are valid witnesses even if the search stopped early*/
+        double getDistance(NodeId pNode) const
+        {
+            return this->distances[pNode];
+        }
+    protected:
+        std::vector<double> distances;
+        std::vector<bool> targets;
+        std::vector<NodeId> touchedNodes;
+        IndexedHeap<double> open;
+    };
+
+    /*Collects the shortcuts which are needed if pNode is contracted; The witness searches do not enter nodes for which pSkip
+    returns true (at least pNode itself)*/
+    template<class Skip> void findShortcuts(const DynamicGraph& pIn, const DynamicGraph& pOut, NodeId pNode, WitnessSearch& pSearch, size_t pSettleLimit, const Skip& pSkip, std::vector<Shortcut>& pResult)
+    {
+        double maxOut = 0.0;
+        for(const DynamicEdge& o : pOut[pNode])
+        {
+            maxOut = std::max(maxOut, o.weight);
+            pSearch.setTarget(o.node, true);
+        }
+        for(const DynamicEdge& i : pIn[pNode])
+        {
+            pSearch.run(pOut, i.node, i.weight + maxOut, pSettleLimit, pOut[pNode].size(), pSkip);
+            for(const DynamicEdge& o : pOut[pNode])
+            {
+                if(o.node != i.node && pSearch.getDistance(o.node) > i.weight + o.weight)
+                {
+                    pResult.push_back(Shortcut{i.node, o.node, i.weight + o.weight, pNode});
+                }
+            }
+        }
+        for(const DynamicEdge& o : pOut[pNode])
+        {
+            pSearch.setTarget(o.node, false);
+        }
+    }
+
+    /*Removes the edge to pNode from a list of edges*/
+    void removeEdge(std::vector<DynamicEdge>& pEdges, NodeId pNode)
+    {
+        pEdges.erase(std::remove_if(pEdges.begin(), pEdges.end(), [pNode](const DynamicEdge& e) { return e.node == pNode; }), pEdges.end());
+    }
+
+    /*Inserts an edge into a list of edges or lowers the weight of the existing edge*/
+    void insertEdge(std::vector<DynamicEdge>& pEdges, NodeId pNode, double pWeight, NodeId pMiddle)
+    {
+        for(DynamicEdge& e : pEdges)
+        {
+            if(e.node == pNode)
+            {
+                if(pWeight < e.weight)
+                {
+                    e.weight = pWeight;
+                    e.middle = pMiddle;
+                }
+                return;
+            }
+        }
+        pEdges.push_back(DynamicEdge{pNode, pWeight, pMiddle});
+    }
+}
+
+std::shared_ptr<ContractionHierarchy> ContractionHierarchy::build(std::shared_ptr<const CompactGraph> pGraph, ThreadPool& pPool)
+{
+    std::shared_ptr<ContractionHierarchy> result(new ContractionHierarchy(pGraph));
+    result->contract(pPool);
+    return result;
+}
+ContractionHierarchy::ContractionHierarchy(std::shared_ptr<const CompactGraph> pGraph)
+: graph(pGraph), shortcutCount(0)
+{
+
+}
+const std::shared_ptr<const CompactGraph>& ContractionHierarchy::getGraph() const
+{
+    return this->graph;
+}
+size_t ContractionHierarchy::getShortcutCount() const
+{
+    return this->shortcutCount;
+}
+void ContractionHierarchy::contract(ThreadPool& pPool)
+{
+    const size_t nodeCount = this->graph->getNodeCount();
+    DynamicGraph in(nodeCount);
+    DynamicGraph out(nodeCount);
+    for(NodeId n = 0; n < nodeCount; n++)
+    {
+        std::span<const NodeId> targets = this->graph->getOutgoing(n);
+        std::span<const double> weights = this->graph->getOutgoingWeights(n);
+        for(size_t i = 0; i < targets.size(); i++)
+        {
+            if(targets[i] != n)
+            {
+                out[n].push_back(DynamicEdge{targets[i], weights[i], NO_NODE});
+                in[targets[i]].push_back(DynamicEdge{n, weights[i], NO_NODE});
+            }
+        }
+    }
+
+    std::vector<WitnessSearch> searches(pPool.getThreadCount(), WitnessSearch(nodeCount));
+    std::vector<int64_t> priorities(nodeCount);
+    std::vector<int64_t> deletedNeighbours(nodeCount, 0);
+
+    /*Edge difference (shortcuts - removed edges) plus the number of contracted neighbours, which spreads the contraction evenly
+    over the graph*/
+    auto updatePriorities = [&](const std::vector<NodeId>& pNodes) {
+        pPool.parallelFor(pNodes.size(), [&](size_t pBegin, size_t pEnd, unsigned int pThread) {
+            std::vector<Shortcut> shortcuts;
+            for(size_t i = pBegin; i < pEnd; i++)
+            {
+                const NodeId n = pNodes[i];
+                shortcuts.clear();
+                findShortcuts(in, out, n, searches[pThread], SIMULATION_SETTLE_LIMIT, [n](NodeId pOther) { return pOther == n; }, shortcuts);
+                priorities[n] = 2 * (static_cast<int64_t>(shortcuts.size()) - static_cast<int64_t>(in[n].size() + out[n].size())) + deletedNeighbours[n];
+            }
+        });
+    };
+
+    std::vector<NodeId> remaining(nodeCount);
+    for(NodeId n = 0; n < nodeCount; n++)
+    {
+        remaining[n] = n;
+    }
+    updatePriorities(remaining);
+
+    /*0: remaining, 1: contracted in the current round, 2: contracted*/
+    std::vector<uint8_t> state(nodeCount, 0);
+    std::vector<std::vector<DynamicEdge>> upEdges(nodeCount);
+    std::vector<std::vector<DynamicEdge>> downEdges(nodeCount);
+    this->ranks.assign(nodeCount, NO_NODE);
+    this->nodes.clear();
+    this->nodes.reserve(nodeCount);
+    while(!remaining.empty())
+    {
+        /*Nodes whose priority is smaller than the one of all nodes within two hops; Ties are broken by ID. Selecting only one node
+        per two hops keeps the short detours around a node (the typical witnesses) free of other nodes of the round*/
+        auto before = [&](NodeId pA, NodeId pB) {
+            return pA == pB || priorities[pA] < priorities[pB] || (priorities[pA] == priorities[pB] && pA < pB);
+        };
+        auto isMinimum = [&](NodeId pNode, NodeId pOther) {
+            return before(pNode, pOther) &&
+                   std::all_of(in[pOther].begin(), in[pOther].end(), [&](const DynamicEdge& e) { return before(pNode, e.node); }) &&
+                   std::all_of(out[pOther].begin(), out[pOther].end(), [&](const DynamicEdge& e) { return before(pNode, e.node); });
+        };
+        std::vector<NodeId> selected;
+        for(NodeId n : remaining)
+        {
+            bool minimum = std::all_of(in[n].begin(), in[n].end(), [&](const DynamicEdge& e) { return isMinimum(n, e.node); }) &&
+                           std::all_of(out[n].begin(), out[n].end(), [&](const DynamicEdge& e) { return isMinimum(n, e.node); });
+            if(minimum)
+            {
+                selected.push_back(n);
+                state[n] = 1;
+            }
+        }
+
+        /*The witness searches avoid all nodes of the round, so every witness still exists after the round*/
+        std::vector<std::vector<Shortcut>> shortcuts(selected.size());
+        pPool.parallelFor(selected.size(), [&](size_t pBegin, size_t pEnd, unsigned int pThread) {
+            for(size_t i = pBegin; i < pEnd; i++)
+            {
+                findShortcuts(in, out, selected[i], searches[pThread], WITNESS_SETTLE_LIMIT, [&state](NodeId pOther) { return state[pOther] == 1; }, shortcuts[i]);
+            }
+        });
+
+        std::vector<NodeId> neighbours;
+        for(NodeId n : selected)
+        {
+            this->ranks[n] = static_cast<uint32_t>(this->nodes.size());
+            this->nodes.push_back(n);
+            for(const DynamicEdge& e : out[n])
+            {
+                removeEdge(in[e.node], n);
+                deletedNeighbours[e.node]++;
+                neighbours.push_back(e.node);
+            }
+            for(const DynamicEdge& e : in[n])
+            {
+                removeEdge(out[e.node], n);
+                deletedNeighbours[e.node]++;
+                neighbours.push_back(e.node);
+            }
+            /*All remaining neighbours get a higher rank*/
+            upEdges[n] = std::move(out[n]);
+            downEdges[n] = std::move(in[n]);
+            out[n] = std::vector<DynamicEdge>();
+            in[n] = std::vector<DynamicEdge>();
+            state[n] = 2;
+        }
+        for(const std::vector<Shortcut>& s : shortcuts)
+        {
+            for(const Shortcut& shortcut : s)
+            {
+                insertEdge(out[shortcut.from], shortcut.to, shortcut.weight, shortcut.middle);
+                insertEdge(in[shortcut.to], shortcut.from, shortcut.weight, shortcut.middle);
+            }
+        }
+
+        std::sort(neighbours.begin(), neighbours.end());
+        neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+        updatePriorities(neighbours);
+        remaining.erase(std::remove_if(remaining.begin(), remaining.end(), [&state](NodeId n) { return state[n] == 2; }), remaining.end());
+    }
+
+    /*Store the edges in rank order*/
+    auto store = [&](const std::vector<std::vector<DynamicEdge>>& pEdges, std::vector<uint32_t>& pOffsets, std::vector<uint32_t>& pOthers,
+                     std::vector<double>& pWeights, std::vector<uint32_t>& pMiddles) {
+        pOffsets.assign(1, 0);
+        std::vector<DynamicEdge> edges;
+        for(uint32_t r = 0; r < nodeCount; r++)
+        {
+            edges = pEdges[this->nodes[r]];
+            for(DynamicEdge& e : edges)
+            {
+                e.node = this->ranks[e.node];
+                e.middle = e.middle == NO_NODE ? NO_NODE : this->ranks[e.middle];
+                if(e.middle != NO_NODE)
+                {
+                    this->shortcutCount++;
+                }
+            }
+            std::sort(edges.begin(), edges.end(), [](const DynamicEdge& a, const DynamicEdge& b) { return a.node < b.node; });
+            for(const DynamicEdge& e : edges)
+            {
+                pOthers.push_back(e.node);
+                pWeights.push_back(e.weight);
+                pMiddles.push_back(e.middle);
+            }
+            pOffsets.push_back(static_cast<uint32_t>(pOthers.size()));
+        }
+    };
+    store(upEdges, this->upOffsets, this->upTargets, this->upWeights, this->upMiddles);
+    store(downEdges, this->downOffsets, this->downSources, this->downWeights, this->downMiddles);
+}
+uint32_t ContractionHierarchy::findEdge(uint32_t pLower, uint32_t pHigher, bool pUpward) const
+{
+    const std::vector<uint32_t>& offsets = pUpward ? this->upOffsets : this->downOffsets;
+    const std::vector<uint32_t>& others = pUpward ? this->upTargets : this->downSources;
+    std::vector<uint32_t>::const_iterator e = std::lower_bound(others.begin() + offsets[pLower], others.begin() + offsets[pLower + 1], pHigher);
+    if(e == others.begin() + offsets[pLower + 1] || *e != pHigher)
+    {
+        throw(std::logic_error("ContractionHierarchy::findEdge(): A shortcut refers to an edge which does not exist!"));
+    }
+    return static_cast<uint32_t>(e - others.begin());
+}
+void ContractionHierarchy::unpack(uint32_t pFrom, uint32_t pTo, uint32_t pMiddle, std::vector<NodeId>& pPath) const
+{
+    /*A shortcut from -> to over middle consists of the edges from -> middle (downward edge of middle) and middle -> to (upward edge
+    of middle); Resolve them depth first, the first half before the second one*/
+    std::vector<std::array<uint32_t, 3>> stack = {{pFrom, pTo, pMiddle}};
+    while(!stack.empty())
+    {
+        const std::array<uint32_t, 3> edge = stack.back();
+        stack.pop_back();
+        if(edge[2] == NO_NODE)
+        {
+            pPath.push_back(this->nodes[edge[1]]);
+            continue;
+        }
+        const uint32_t second = this->findEdge(edge[2], edge[1], true);
+        const uint32_t first = this->findEdge(edge[2], edge[0], false);
+        stack.push_back({edge[2], edge[1], this->upMiddles[second]});
+        stack.push_back({edge[0], edge[2], this->downMiddles[first]});
+    }
+}
+std::shared_ptr<const std::vector<double>> ContractionHierarchy::getDistances(NodeId pTarget)
+{
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        std::unordered_map<NodeId, std::shared_ptr<const std::vector<double>>>::const_iterator d = this->distances.find(pTarget);
+        if(d != this->distances.end())
+        {
+            return d->second;
+        }
+    }
+
+    /*Backward search upwards from the target, then one sweep from the highest to the lowest rank: Every node takes the best of its
+    upward edges, whose targets are final at that point*/
+    const size_t nodeCount = this->nodes.size();
+    std::vector<double> byRank(nodeCount, std::numeric_limits<double>::infinity());
+    IndexedHeap<double> open;
+    byRank[this->ranks[pTarget]] = 0.0;
+    open.push(this->ranks[pTarget], 0.0);
+    while(!open.empty())
+    {
+        const uint32_t current = open.pop();
+        this->forEachDownward(current, [&](uint32_t pSource, double pWeight, uint32_t) {
+            if(byRank[current] + pWeight < byRank[pSource])
+            {
+                if(open.contains(pSource))
+                {
+                    open.decreaseKey(pSource, byRank[current] + pWeight);
+                }
+                else
+                {
+                    open.push(pSource, byRank[current] + pWeight);
+                }
+                byRank[pSource] = byRank[current] + pWeight;
+            }
+        });
+    }
+    std::vector<double> byNode(nodeCount);
+    for(uint32_t r = static_cast<uint32_t>(nodeCount); r-- > 0;)
+    {
+        this->forEachUpward(r, [&](uint32_t pHigher, double pWeight, uint32_t) {
+            byRank[r] = std::min(byRank[r], pWeight + byRank[pHigher]);
+        });
+        byNode[this->nodes[r]] = byRank[r];
+    }
+
+    std::shared_ptr<const std::vector<double>> result = std::make_shared<const std::vector<double>>(std::move(byNode));
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->distances.try_emplace(pTarget, result).first->second;
+}
+std::function<double(NodeId)> ContractionHierarchy::getHeuristic(const std::shared_ptr<const CompactGraph>& pGraph, NodeId pTarget)
+{
+    if(pGraph != this->graph)
+    {
+        return this->fallback.getHeuristic(pGraph, pTarget);
+    }
+    std::shared_ptr<const std::vector<double>> d = this->getDistances(pTarget);
+    return [d](NodeId pNode) { return (*d)[pNode]; };
+}
+std::shared_ptr<const LowLevelPlanner> ContractionHierarchy::createPlanner(const std::shared_ptr<const CompactGraph>& pGraph, LowLevelAlgorithm pAlgorithm)
+{
+    if(pGraph != this->graph)
+    {
+        return this->fallback.createPlanner(pGraph, pAlgorithm);
+    }
+    return makeLowLevelPlanner(pGraph, [this](const std::shared_ptr<const CompactGraph>&, NodeId pTarget) {
+        std::shared_ptr<const std::vector<double>> d = this->getDistances(pTarget);
+        return [d](NodeId pNode) { return (*d)[pNode]; };
+    }, pAlgorithm);
+}
+void ContractionHierarchy::prepare(const std::shared_ptr<const CompactGraph>& pGraph, const std::vector<NodeId>& pTargets)
+{
+    if(pGraph != this->graph)
+    {
+        this->fallback.prepare(pGraph, pTargets);
+        return;
+    }
+    for(NodeId t : pTargets)
+    {
+        if(t < this->nodes.size())
+        {
+            this->getDistances(t);
+        }
+    }
+}
+
+ContractionHierarchyQuery::ContractionHierarchyQuery(const ContractionHierarchy& pHierarchy)
+: hierarchy(pHierarchy), dForward(pHierarchy.getGraph()->getNodeCount(), std::numeric_limits<double>::infinity()),
+  dBackward(pHierarchy.getGraph()->getNodeCount(), std::numeric_limits<double>::infinity()),
+  parentForward(pHierarchy.getGraph()->getNodeCount(), ContractionHierarchy::NO_NODE),
+  parentBackward(pHierarchy.getGraph()->getNodeCount(), ContractionHierarchy::NO_NODE),
+  middleForward(pHierarchy.getGraph()->getNodeCount(), ContractionHierarchy::NO_NODE),
+  middleBackward(pHierarchy.getGraph()->getNodeCount(), ContractionHierarchy::NO_NODE), touchedRanks(), forward(), backward(),
+  meeting(ContractionHierarchy::NO_NODE), expansions(0)
+{
+
+}
+double ContractionHierarchyQuery::getDistance(NodeId pStart, NodeId pTarget)
+{
+    return this->search(pStart, pTarget);
+}
+std::vector<NodeId> ContractionHierarchyQuery::findPath(NodeId pStart, NodeId pTarget)
+{
+    if(this->search(pStart, pTarget) == std::numeric_limits<double>::infinity())
+    {
+        return std::vector<NodeId>();
+    }
+
+    /*Upward path from the start to the meeting rank, then the downward path to the target; Both are unpacked edge by edge*/
+    std::vector<uint32_t> upward;
+    for(uint32_t r = this->meeting; r != ContractionHierarchy::NO_NODE; r = this->parentForward[r])
+    {
+        upward.push_back(r);
+    }
+    std::reverse(upward.begin(), upward.end());
+    std::vector<NodeId> result{this->hierarchy.getNode(upward.front())};
+    for(size_t i = 1; i < upward.size(); i++)
+    {
+        this->hierarchy.unpack(upward[i - 1], upward[i], this->middleForward[upward[i]], result);
+    }
+    for(uint32_t r = this->meeting; this->parentBackward[r] != ContractionHierarchy::NO_NODE; r = this->parentBackward[r])
+    {
+        this->hierarchy.unpack(r, this->parentBackward[r], this->middleBackward[r], result);
+    }
+    return result;
+}
+size_t ContractionHierarchyQuery::getExpansions() const
+{
+    return this->expansions;
+}
+double ContractionHierarchyQuery::search(NodeId pStart, NodeId pTarget)
+{
+    this->reset();
+
+    const size_t nodeCount = this->dForward.size();
+    if(pStart >= nodeCount || pTarget >= nodeCount)
+    {
+        return std::numeric_limits<double>::infinity();
+    }
+
+    auto relax = [this](uint32_t pRank, double pDistance, uint32_t pParent, uint32_t pMiddle, std::vector<double>& pD,
+                        std::vector<uint32_t>& pParents, std::vector<uint32_t>& pMiddles, IndexedHeap<double>& pOpen) {
+        if(pDistance >= pD[pRank])
+        {
+            return;
+        }
+        if(pD[pRank] == std::numeric_limits<double>::infinity())
+        {
+            this->touchedRanks.push_back(pRank);
+        }
+        pD[pRank] = pDistance;
+        pParents[pRank] = pParent;
+        pMiddles[pRank] = pMiddle;
+        if(pOpen.contains(pRank))
+        {
+            pOpen.decreaseKey(pRank, pDistance);
+        }
+        else
+        {
+            pOpen.push(pRank, pDistance);
+        }
+    };
+    relax(this->hierarchy.getRank(pStart), 0.0, ContractionHierarchy::NO_NODE, ContractionHierarchy::NO_NODE, this->dForward,
+          this->parentForward, this->middleForward, this->forward);
+    relax(this->hierarchy.getRank(pTarget), 0.0, ContractionHierarchy::NO_NODE, ContractionHierarchy::NO_NODE, this->dBackward,
+          this->parentBackward, this->middleBackward, this->backward);
+
+    double best = std::numeric_limits<double>::infinity();
+    while(true)
+    {
+        /*A direction is finished once its smallest key can not improve the best connection anymore*/
+        const bool forwardActive = !this->forward.empty() && this->forward.topKey() < best;
+        const bool backwardActive = !this->backward.empty() && this->backward.topKey() < best;
+        if(!forwardActive && !backwardActive)
+        {
+            break;
+        }
+        const bool isForward = forwardActive && (!backwardActive || this->forward.topKey() <= this->backward.topKey());
+        std::vector<double>& d = isForward ? this->dForward : this->dBackward;
+        const std::vector<double>& otherD = isForward ? this->dBackward : this->dForward;
+        const uint32_t current = isForward ? this->forward.pop() : this->backward.pop();
+        this->expansions++;
+
+        if(d[current] + otherD[current] < best)
+        {
+            best = d[current] + otherD[current];
+            this->meeting = current;
+        }
+
+        /*Stall-on-demand: A node which is reached cheaper over an edge from a higher rank is not on a shortest upward path*/
+        bool stalled = false;
+        auto stall = [&](uint32_t pOther, double pWeight, uint32_t) {
+            stalled = stalled || d[pOther] + pWeight < d[current];
+        };
+        if(isForward)
+        {
+            this->hierarchy.forEachDownward(current, stall);
+        }
+        else
+        {
+            this->hierarchy.forEachUpward(current, stall);
+        }
+        if(stalled)
+        {
+            continue;
+        }
+
+        if(isForward)
+        {
+            this->hierarchy.forEachUpward(current, [&](uint32_t pNext, double pWeight, uint32_t pMiddle) {
+                relax(pNext, d[current] + pWeight, current, pMiddle, this->dForward, this->parentForward, this->middleForward, this->forward);
+            });
+        }
+        else
+        {
+            this->hierarchy.forEachDownward(current, [&](uint32_t pNext, double pWeight, uint32_t pMiddle) {
+                relax(pNext, d[current] + pWeight, current, pMiddle, this->dBackward, this->parentBackward, this->middleBackward, this->backward);
+            });
+        }
+    }
+    return best;
+}
+void ContractionHierarchyQuery::reset()
+{
+    for(uint32_t r : this->touchedRanks)
+    {
+        this->dForward[r] = std::numeric_limits<double>::infinity();
+        this->dBackward[r] = std::numeric_limits<double>::infinity();
+        this->parentForward[r] = ContractionHierarchy::NO_NODE;
+        this->parentBackward[r] = ContractionHierarchy::NO_NODE;
+        this->middleForward[r] = ContractionHierarchy::NO_NODE;
+        this->middleBackward[r] = ContractionHierarchy::NO_NODE;
+    }
+    this->touchedRanks.clear();
+    this->forward.clear();
+    this->backward.clear();
+    this->meeting = ContractionHierarchy::NO_NODE;
+    this->expansions = 0;
+}
@@ -0,0 +1,337 @@
+/**
+ * @file ContractionHierarchy.hpp
+ * @author Lennart Hustermeier (lennart.hustermeier@gmx.de)
+ * @brief Contains contraction hierarchies for exact distance queries on static graphs
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include "HeuristicCache.hpp"
+#include "IndexedHeap.hpp"
+#include "ThreadPool.hpp"
+#include <limits>
+#include <memory>
+
+/**
+ * @brief A contraction hierarchy (CH) of a CompactGraph: The nodes are contracted one after another in the order of their rank; When
+ * a node is contracted, shortcuts are added between its neighbours for all shortest paths which lead over it (unless a witness
+ * search finds another path which is at most as expensive). Afterwards every shortest path can be found by searching upwards
+ * (to higher ranks) from both of its ends.
+ *
+ * The preprocessing runs on a ThreadPool: In every round the nodes whose priority is a local minimum among their neighbours are
+ * contracted in parallel; Their witness searches avoid all nodes of the round, so the shortcuts stay valid. Queries are answered
+ * by ContractionHierarchyQuery. The distances from all nodes to a target are calculated by a backward upward search followed by
+ * one linear sweep over the nodes in descending rank order (PHAST); As HeuristicProvider the hierarchy caches these distances
+ * like a HeuristicCache, other graphs are answered by an internal HeuristicCache.
+ *
+ * Internally the nodes are stored in rank order, so the sweep runs over contiguous memory.
+ */
+class ContractionHierarchy : public HeuristicProvider
+{
+public:
+    /**
+     * @brief Marks an edge which is no shortcut respectively an invalid rank
+     */
+    static constexpr uint32_t NO_NODE = std::numeric_limits<uint32_t>::max();
+
+    /**
+     * @brief Builds the hierarchy of a graph
+     *
+     * @param pGraph The graph; Has to stay unchanged as long as the hierarchy is used
+     * @param pPool The threads to contract the nodes on
+     * @return std::shared_ptr<ContractionHierarchy> The hierarchy
+     */
+    static std::shared_ptr<ContractionHierarchy> build(std::shared_ptr<const CompactGraph> pGraph, ThreadPool& pPool);
+
+    /**
+     * @brief Returns the graph the hierarchy belongs to
+     *
+     * @return const std::shared_ptr<const CompactGraph>& The graph
+     */
+    const std::shared_ptr<const CompactGraph>& getGraph() const;
+
+    /**
+     * @brief Returns the rank of a node (the position in the contraction order)
+     *
+     * @param pNode The node
+     * @return uint32_t The rank
+     */
+    uint32_t getRank(NodeId pNode) const
+    {
+        return this->ranks[pNode];
+    }
+
+    /**
+     * @brief Returns the node with a rank
+     *
+     * @param pRank The rank
+     * @return NodeId The node
+     */
+    NodeId getNode(uint32_t pRank) const
+    {
+        return this->nodes[pRank];
+    }
+
+    /**
+     * @brief Returns the number of shortcuts which were added by the contraction
+     *
+     * @return size_t Number of shortcuts
+     */
+    size_t getShortcutCount() const;
+
+    /**
+     * @brief Calls pCallback(<rank>, <weight>, <middle rank>) for every edge from the node with rank pRank to a node with a higher
+     * rank; The middle rank is NO_NODE for edges of the graph
+     *
+     * @tparam Callback Callable with the signature void(uint32_t, double, uint32_t)
+     * @param pRank The rank of the node
+     * @param pCallback The callback to call for every edge
+     */
+    template<class Callback> void forEachUpward(uint32_t pRank, Callback&& pCallback) const
+    {
+        for(uint32_t e = this->upOffsets[pRank]; e < this->upOffsets[pRank + 1]; e++)
+        {
+            pCallback(this->upTargets[e], this->upWeights[e], this->upMiddles[e]);
+        }
+    }
+
+    /**
+     * @brief Calls pCallback(<rank>, <weight>, <middle rank>) for every edge from a node with a higher rank to the node with rank
+     * pRank; The middle rank is NO_NODE for edges of the graph
+     *
+     * @tparam Callback Callable with the signature void(uint32_t, double, uint32_t)
+     * @param pRank The rank of the node
+     * @param pCallback The callback to call for every edge
+     */
+    template<class Callback> void forEachDownward(uint32_t pRank, Callback&& pCallback) const
+    {
+        for(uint32_t e = this->downOffsets[pRank]; e < this->downOffsets[pRank + 1]; e++)
+        {
+            pCallback(this->downSources[e], this->downWeights[e], this->downMiddles[e]);
+        }
+    }
+
+    /**
+     * @brief Appends the nodes of the path which an edge of the hierarchy represents to a vector (without its first node)
+     *
+     * @param pFrom The rank of the start of the edge
+     * @param pTo The rank of the end of the edge
+     * @param pMiddle The middle rank of the edge (NO_NODE for edges of the graph)
+     * @param pPath The path to append the nodes to
+     */
+    void unpack(uint32_t pFrom, uint32_t pTo, uint32_t pMiddle, std::vector<NodeId>& pPath) const;
+
+    /**
+     * @brief Returns the distances from all nodes to a target node, calculating them with PHAST if necessary
+     *
+     * @param pTarget The target node
+     * @return std::shared_ptr<const std::vector<double>> Distances indexed by node ID (infinity if pTarget can not be reached)
+     */
+    std::shared_ptr<const std::vector<double>> getDistances(NodeId pTarget);
+
+    /**
+     * @brief Returns a heuristic which looks up the exact distance to pTarget
+     *
+     * @param pGraph The graph in which the search takes place
+     * @param pTarget The target node of the search
+     * @return std::function<double(NodeId)> The heuristic
+     */
+    std::function<double(NodeId)> getHeuristic(const std::shared_ptr<const CompactGraph>& pGraph, NodeId pTarget) override;
+
+    /**
+     * @brief Lattices are planned on with the arithmetic distance estimate of the provider base class
+     */
+    using HeuristicProvider::createPlanner;
+
+    /**
+     * @brief Creates a planner which looks up the distances directly instead of through std::function
+     *
+     * @param pGraph The graph to plan on
+     * @param pAlgorithm The low level search to run
+     * @return std::shared_ptr<const LowLevelPlanner> The planner
+     */
+    std::shared_ptr<const LowLevelPlanner> createPlanner(const std::shared_ptr<const CompactGraph>& pGraph, LowLevelAlgorithm pAlgorithm) override;
+
+    /**
+     * @brief Calculates the distances to all targets which are not cached yet
+     *
+     * @param pGraph The graph in which the distances shall be calculated
+     * @param pTargets The target nodes
+     */
+    void prepare(const std::shared_ptr<const CompactGraph>& pGraph, const std::vector<NodeId>& pTargets) override;
+protected:
+    /**
+     * @brief Constructs an empty hierarchy; Use build()
+     *
+     * @param pGraph The graph
+     */
+    ContractionHierarchy(std::shared_ptr<const CompactGraph> pGraph);
+
+    /**
+     * @brief Contracts all nodes and stores the resulting upward and downward edges
+     *
+     * @param pPool The threads to run on
+     */
+    void contract(ThreadPool& pPool);
+
+    /**
+     * @brief Returns the index of the edge between two ranks in the upward respectively downward edges of the lower rank
+     *
+     * @param pLower The lower rank
+     * @param pHigher The higher rank
+     * @param pUpward true for the edge pLower -> pHigher, false for the edge pHigher -> pLower
+     * @return uint32_t The index of the edge
+     */
+    uint32_t findEdge(uint32_t pLower, uint32_t pHigher, bool pUpward) const;
+
+    /**
+     * @brief The graph the hierarchy belongs to
+     */
+    std::shared_ptr<const CompactGraph> graph;
+
+    /**
+     * @brief The rank of every node and the node of every rank
+     */
+    std::vector<uint32_t> ranks;
+    std::vector<NodeId> nodes;
+
+    /**
+     * @brief The edges to higher ranks, indexed by rank and sorted by target rank; The edges of rank r are stored in
+     * [upOffsets[r], upOffsets[r+1])
+     */
+    std::vector<uint32_t> upOffsets;
+    std::vector<uint32_t> upTargets;
+    std::vector<double> upWeights;
+    std::vector<uint32_t> upMiddles;
+
+    /**
+     * @brief The edges from higher ranks, indexed by rank and sorted by source rank; The edges of rank r are stored in
+     * [downOffsets[r], downOffsets[r+1])
+     */
+    std::vector<uint32_t> downOffsets;
+    std::vector<uint32_t> downSources;
+    std::vector<double> downWeights;
+    std::vector<uint32_t> downMiddles;
+
+    /**
+     * @brief The number of shortcuts
+     */
+    size_t shortcutCount;
+
+    /**
+     * @brief Protects the cached distances as the hierarchy is shared between the threads of CBS
+     */
+    mutable std::mutex mutex;
+
+    /**
+     * @brief Maps a target node to the distances of all nodes to it
+     */
+    std::unordered_map<NodeId, std::shared_ptr<const std::vector<double>>> distances;
+
+    /**
+     * @brief Answers requests for other graphs
+     */
+    HeuristicCache fallback;
+};
+
+/**
+ * @brief The bidirectional query on a ContractionHierarchy: A forward search from the start node and a backward search from the
+ * target node which both only follow edges to higher ranks; Nodes which are reached cheaper from a higher rank are not expanded
+ * (stall-on-demand). The shortcuts of the resulting path are unpacked into the edges of the graph.
+ *
+ * The instance can be reused for multiple queries on the same hierarchy and only resets the nodes touched by the previous query;
+ * Every thread needs an instance of its own.
+ */
+class ContractionHierarchyQuery
+{
+public:
+    /**
+     * @brief Creates a new query on a hierarchy
+     *
+     * @param pHierarchy The hierarchy
+     */
+    ContractionHierarchyQuery(const ContractionHierarchy& pHierarchy);
+
+    /**
+     * @brief Calculates the costs of the shortest path from pStart to pTarget
+     *
+     * @param pStart The start node
+     * @param pTarget The target node
+     * @return double The costs; Infinity if there is no path
+     */
+    double getDistance(NodeId pStart, NodeId pTarget);
+
+    /**
+     * @brief Searches a shortest path from pStart to pTarget
+     *
+     * @param pStart The start node
+     * @param pTarget The target node
+     * @return std::vector<NodeId> The path or an empty vector if there is no such path
+     */
+    std::vector<NodeId> findPath(NodeId pStart, NodeId pTarget);
+
+    /**
+     * @brief Returns the number of nodes expanded by the last query (in both directions)
+     *
+     * @return size_t Number of expansions
+     */
+    size_t getExpansions() const;
+protected:
+    /**
+     * @brief Runs both searches; Afterwards meeting contains the rank where the best paths meet
+     *
+     * @return double The costs of the shortest path
+     */
+    double search(NodeId pStart, NodeId pTarget);
+
+    /**
+     * @brief Resets the nodes touched by the last query
+     */
+    void reset();
+
+    /**
+     * @brief The hierarchy
+     */
+    const ContractionHierarchy& hierarchy;
+
+    /**
+     * @brief The costs from the start and to the target, indexed by rank
+     */
+    std::vector<double> dForward;
+    std::vector<double> dBackward;
+
+    /**
+     * @brief The predecessors in the forward search and the successors in the backward search together with the middle rank of
+     * the edge to them
+     */
+    std::vector<uint32_t> parentForward;
+    std::vector<uint32_t> parentBackward;
+    std::vector<uint32_t> middleForward;
+    std::vector<uint32_t> middleBackward;
+
+    /**
+     * @brief The ranks which were touched by the current query
+     */
+    std::vector<uint32_t> touchedRanks;
+
+    /**
+     * @brief The open lists of both directions
+     */
+    IndexedHeap<double> forward;
+    IndexedHeap<double> backward;
+
+    /**
+     * @brief The rank where the best paths of the last query meet
+     */
+    uint32_t meeting;
+
+    /**
+     * @brief Counts the expansions of the last query
+     */
+    size_t expansions;
+};
@@ -0,0 +1,426 @@
+/**
+ * @file DistanceMatrix.cpp
+ * @author Lennart Hustermeier (lennart.hustermeier@gmx.de)
+ * @brief Contains the calculation, serialization and lookup of the quantized distance matrix
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "DistanceMatrix.hpp"
+#include "HopDistanceMatrix.hpp"
+#include "LatticeGraph.hpp"
+#include "LowLevelPlanner.hpp"
+#include "ShortestPathTree.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <type_traits>
+
+namespace
+{
+    /*Identifies the file format*/
+    constexpr char MAGIC[8] = {'D', 'I', 'S', 'T', 'M', 'A', 'T', '\0'};
+    constexpr uint32_t VERSION = 1;
+}
+
+DistanceMatrix::DistanceMatrix(std::shared_ptr<const CompactGraph> pGraph, std::shared_ptr<const LatticeGraph> pLattice, std::vector<uint8_t> pBuffer, std::unique_ptr<MappedFile> pFile)
+: graph(pGraph), lattice(pLattice), buffer(std::move(pBuffer)), file(std::move(pFile))
+{
+    this->data = this->file ? this->file->getData() : this->buffer.data();
+    this->size = this->file ? this->file->getSize() : this->buffer.size();
+
+    Header header;
+    std::memcpy(&header, this->data, sizeof(Header));
+    this->nodeCount = header.nodeCount;
+    this->targetCount = header.targetCount;
+
+    std::pair<size_t, size_t> offsets = DistanceMatrix::getOffsets(this->targetCount);
+    this->targets = reinterpret_cast<const NodeId*>(this->data + sizeof(Header));
+    this->multipliers = reinterpret_cast<const double*>(this->data + offsets.first);
+    this->distances = reinterpret_cast<const uint16_t*>(this->data + offsets.second);
+
+    this->targetIndex.assign(this->nodeCount, NOT_A_TARGET);
+    for(size_t i = 0; i < this->targetCount; i++)
+    {
+        this->targetIndex[this->targets[i]] = static_cast<uint32_t>(i);
+    }
+}
+std::shared_ptr<DistanceMatrix> DistanceMatrix::compute(std::shared_ptr<const CompactGraph> pGraph, ThreadPool& pPool, const std::vector<NodeId>& pTargets)
+{
+    return DistanceMatrix::computeMatrix(pGraph, pPool, pTargets);
+}
+std::shared_ptr<DistanceMatrix> DistanceMatrix::compute(std::shared_ptr<const LatticeGraph> pGraph, ThreadPool& pPool, const std::vector<NodeId>& pTargets)
+{
+    return DistanceMatrix::computeMatrix(pGraph, pPool, pTargets);
+}
+template<class GraphType> std::shared_ptr<DistanceMatrix> DistanceMatrix::computeMatrix(const std::shared_ptr<const GraphType>& pGraph, ThreadPool& pPool, const std::vector<NodeId>& pTargets)
+{
+    const size_t nodeCount = pGraph->getNodeCount();
+
+    /*Collect the targets without duplicates*/
+    std::vector<NodeId> targets;
+    std::vector<bool> isTarget(nodeCount, false);
+    if(pTargets.empty())
+    {
+        targets.resize(nodeCount);
+        for(NodeId n = 0; n < nodeCount; n++)
+        {
+            targets[n] = n;
+        }
+    }
+    for(NodeId t : pTargets)
+    {
+        if(t >= nodeCount)
+        {
+            throw(std::out_of_range("DistanceMatrix::compute(): The target is not part of the graph!"));
+        }
+        if(!isTarget[t])
+        {
+            isTarget[t] = true;
+            targets.push_back(t);
+        }
+    }
+
+    /*The smallest positive edge weight bounds how much the rounding may be compensated per edge (see below)*/
+    double minWeight = std::numeric_limits<double>::infinity();
+    for(NodeId n = 0; n < nodeCount; n++)
+    {
+        if(pGraph->isBlocked(n))
+        {
+            continue;
+        }
+        pGraph->forEachOutgoing(n, [&minWeight](NodeId, double pWeight) {
+            if(pWeight > 0.0)
+            {
+                minWeight = std::min(minWeight, pWeight);
+            }
+        });
+    }
+
+    std::pair<size_t, size_t> offsets = DistanceMatrix::getOffsets(targets.size());
+    std::vector<uint8_t> buffer(offsets.second + targets.size() * nodeCount * sizeof(uint16_t), 0);
+    Header header;
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.nodeCount = static_cast<uint32_t>(nodeCount);
+    header.targetCount = static_cast<uint32_t>(targets.size());
+    header.reserved = 0;
+    header.fingerprint = DistanceMatrix::getFingerprint(*pGraph);
+    std::memcpy(buffer.data(), &header, sizeof(Header));
+    std::memcpy(buffer.data() + sizeof(Header), targets.data(), targets.size() * sizeof(NodeId));
+    double* multipliers = reinterpret_cast<double*>(buffer.data() + offsets.first);
+    uint16_t* rows = reinterpret_cast<uint16_t*>(buffer.data() + offsets.second);
+
+    /*Rounding every distance down to a multiple of the scale s keeps the estimate admissible, but the difference of two
+    neighbours can exceed the edge weight w by up to s. Multiplying with w_min / (w_min + s) removes that excess for every
+    w >= w_min, so the estimate stays consistent. Every row is written by one thread only.*/
+    auto quantize = [&](size_t pRow, const std::vector<double>& pDistances) {
+        double max = 0.0;
+        for(double d : pDistances)
+        {
+            if(d != std::numeric_limits<double>::infinity())
+            {
+                max = std::max(max, d);
+            }
+        }
+        const double scale = max > 0.0 ? max / (UNREACHABLE - 1) : 1.0;
+        uint16_t* row = rows + pRow * nodeCount;
+        for(size_t n = 0; n < nodeCount; n++)
+        {
+            if(pDistances[n] == std::numeric_limits<double>::infinity())
+            {
+                row[n] = UNREACHABLE;
+                continue;
+            }
+            double q = std::min<double>(std::floor(pDistances[n] / scale), UNREACHABLE - 1);
+            if(q * scale > pDistances[n])
+            {
+                q--;
+            }
+            row[n] = static_cast<uint16_t>(q);
+        }
+        multipliers[pRow] = minWeight == std::numeric_limits<double>::infinity() ? scale : scale * minWeight / (minWeight + scale);
+    };
+
+    /*Lattices have different weights on their axes, only compact graphs can have uniform weights*/
+    std::optional<double> uniformWeight;
+    if constexpr(std::is_same_v<GraphType, CompactGraph>)
+    {
+        uniformWeight = pGraph->getUniformWeight();
+    }
+    if(uniformWeight.has_value())
+    {
+        if constexpr(std::is_same_v<GraphType, CompactGraph>)
+        {
+            /*64 targets per bit-parallel BFS*/
+            pPool.parallelFor((targets.size() + 63) / 64, [&](size_t pBegin, size_t pEnd, unsigned int) {
+                for(size_t batch = pBegin; batch < pEnd; batch++)
+                {
+                    const size_t first = batch * 64;
+                    std::vector<NodeId> sources(targets.begin() + first, targets.begin() + std::min(first + 64, targets.size()));
+                    HopDistanceMatrix hops = HopDistanceMatrix::compute(pGraph, sources, std::vector<bool>(), true);
+                    for(size_t i = 0; i < sources.size(); i++)
+                    {
+                        quantize(first + i, hops.getDistances(i, uniformWeight.value()));
+                    }
+                }
+            }, 1);
+        }
+    }
+    else
+    {
+        pPool.parallelFor(targets.size(), [&](size_t pBegin, size_t pEnd, unsigned int) {
+            for(size_t i = pBegin; i < pEnd; i++)
+            {
+                quantize(i, ShortestPathTree::compute(pGraph, targets[i], std::vector<bool>(), CompactGraph::INVALID_NODE, true).getDistances());
+            }
+        }, 1);
+    }
+
+    return DistanceMatrix::create(pGraph, std::move(buffer), nullptr);
+}
+std::shared_ptr<DistanceMatrix> DistanceMatrix::load(const std::string& pPath, std::shared_ptr<const CompactGraph> pGraph)
+{
+    return DistanceMatrix::loadMatrix(pPath, pGraph);
+}
+std::shared_ptr<DistanceMatrix> DistanceMatrix::load(const std::string& pPath, std::shared_ptr<const LatticeGraph> pGraph)
+{
+    return DistanceMatrix::loadMatrix(pPath, pGraph);
+}
+template<class GraphType> std::shared_ptr<DistanceMatrix> DistanceMatrix::loadMatrix(const std::string& pPath, const std::shared_ptr<const GraphType>& pGraph)
+{
+    std::unique_ptr<MappedFile> file = std::make_unique<MappedFile>(pPath);
+
+    Header header;
+    if(file->getSize() < sizeof(Header))
+    {
+        throw(std::runtime_error("DistanceMatrix::load(): " + pPath + " is no distance matrix!"));
+    }
+    std::memcpy(&header, file->getData(), sizeof(Header));
+    if(std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION)
+    {
+        throw(std::runtime_error("DistanceMatrix::load(): " + pPath + " is no distance matrix!"));
+    }
+    if(header.nodeCount != pGraph->getNodeCount() || header.fingerprint != DistanceMatrix::getFingerprint(*pGraph))
+    {
+        throw(std::runtime_error("DistanceMatrix::load(): " + pPath + " belongs to another graph!"));
+    }
+    std::pair<size_t, size_t> offsets = DistanceMatrix::getOffsets(header.targetCount);
+    if(file->getSize() != offsets.second + static_cast<size_t>(header.targetCount) * header.nodeCount * sizeof(uint16_t))
+    {
+        throw(std::runtime_error("DistanceMatrix::load(): " + pPath + " is damaged!"));
+    }
+    const NodeId* targets = reinterpret_cast<const NodeId*>(file->getData() + sizeof(Header));
+    for(size_t i = 0; i < header.targetCount; i++)
+    {
+        if(targets[i] >= header.nodeCount)
+        {
+            throw(std::runtime_error("DistanceMatrix::load(): " + pPath + " is damaged!"));
+        }
+    }
+
+    return DistanceMatrix::create(pGraph, std::vector<uint8_t>(), std::move(file));
+}
+std::shared_ptr<DistanceMatrix> DistanceMatrix::loadOrCompute(const std::string& pPath, std::shared_ptr<const CompactGraph> pGraph, ThreadPool& pPool, const std::vector<NodeId>& pTargets)
+{
+    return DistanceMatrix::loadOrComputeMatrix(pPath, pGraph, pPool, pTargets);
+}
+std::shared_ptr<DistanceMatrix> DistanceMatrix::loadOrCompute(const std::string& pPath, std::shared_ptr<const LatticeGraph> pGraph, ThreadPool& pPool, const std::vector<NodeId>& pTargets)
+{
+    return DistanceMatrix::loadOrComputeMatrix(pPath, pGraph, pPool, pTargets);
+}
+template<class GraphType> std::shared_ptr<DistanceMatrix> DistanceMatrix::loadOrComputeMatrix(const std::string& pPath, const std::shared_ptr<const GraphType>& pGraph, ThreadPool& pPool, const std::vector<NodeId>& pTargets)
+{
+    try
+    {
+        std::shared_ptr<DistanceMatrix> result = DistanceMatrix::load(pPath, pGraph);
+        bool complete = pTargets.empty() ? result->targetCount == pGraph->getNodeCount() :
+                        std::all_of(pTargets.begin(), pTargets.end(), [&](NodeId t) { return t < result->nodeCount && result->contains(t); });
+        if(complete)
+        {
+            return result;
+        }
+    }
+    catch(const std::runtime_error&)
+    {
+        /*Missing or outdated -> calculate it*/
+    }
+
+    std::shared_ptr<DistanceMatrix> result = DistanceMatrix::compute(pGraph, pPool, pTargets);
+    try
+    {
+        result->save(pPath);
+    }
+    catch(const std::runtime_error&)
+    {
+        /*The matrix is still usable, it just has to be calculated again next time*/
+    }
+    return result;
+}
+void DistanceMatrix::save(const std::string& pPath) const
+{
+    std::ofstream out(pPath, std::ios::binary | std::ios::trunc);
+    if(!out)
+    {
+        throw(std::runtime_error("DistanceMatrix::save(): Can not open " + pPath + "!"));
+    }
+    out.write(reinterpret_cast<const char*>(this->data), static_cast<std::streamsize>(this->size));
+    if(!out)
+    {
+        throw(std::runtime_error("DistanceMatrix::save(): Can not write " + pPath + "!"));
+    }
+}
+bool DistanceMatrix::contains(NodeId pTarget) const
+{
+    return pTarget < this->nodeCount && this->targetIndex[pTarget] != NOT_A_TARGET;
+}
+std::vector<NodeId> DistanceMatrix::getTargets() const
+{
+    return std::vector<NodeId>(this->targets, this->targets + this->targetCount);
+}
+const std::shared_ptr<const CompactGraph>& DistanceMatrix::getGraph() const
+{
+    return this->graph;
+}
+const std::shared_ptr<const LatticeGraph>& DistanceMatrix::getLattice() const
+{
+    return this->lattice;
+}
+std::function<double(NodeId)> DistanceMatrix::getHeuristic(const std::shared_ptr<const CompactGraph>& pGraph, NodeId pTarget)
+{
+    if(!this->isGraph(pGraph) || !this->contains(pTarget))
+    {
+        return this->fallback.getHeuristic(pGraph, pTarget);
+    }
+    return [this, pTarget](NodeId pNode) { return this->getDistanceEstimate(pNode, pTarget); };
+}
+std::shared_ptr<const LowLevelPlanner> DistanceMatrix::createPlanner(const std::shared_ptr<const CompactGraph>& pGraph, LowLevelAlgorithm pAlgorithm)
+{
+    return this->createMatrixPlanner(pGraph, pAlgorithm);
+}
+std::shared_ptr<const LowLevelPlanner> DistanceMatrix::createPlanner(const std::shared_ptr<const LatticeGraph>& pGraph, LowLevelAlgorithm pAlgorithm)
+{
+    return this->createMatrixPlanner(pGraph, pAlgorithm);
+}
+template<class GraphType> std::shared_ptr<const LowLevelPlanner> DistanceMatrix::createMatrixPlanner(const std::shared_ptr<const GraphType>& pGraph, LowLevelAlgorithm pAlgorithm)
+{
+    if(!this->isGraph(pGraph))
+    {
+        return this->fallback.createPlanner(pGraph, pAlgorithm);
+    }
+    /*Look up the row directly; Targets outside of the matrix get the distances of the fallback*/
+    return makeLowLevelPlanner(pGraph, [this](const std::shared_ptr<const GraphType>& pG, NodeId pTarget) {
+        const uint16_t* row = nullptr;
+        double multiplier = 0.0;
+        std::shared_ptr<const std::vector<double>> exact;
+        if(this->contains(pTarget))
+        {
+            row = this->distances + static_cast<size_t>(this->targetIndex[pTarget]) * this->nodeCount;
+            multiplier = this->multipliers[this->targetIndex[pTarget]];
+        }
+        else
+        {
+            exact = this->fallback.getDistances(pG, pTarget);
+        }
+        return [row, multiplier, exact](NodeId pNode) {
+            if(row == nullptr)
+            {
+                return (*exact)[pNode];
+            }
+            return row[pNode] == UNREACHABLE ? std::numeric_limits<double>::infinity() : row[pNode] * multiplier;
+        };
+    }, pAlgorithm);
+}
+void DistanceMatrix::prepare(const std::shared_ptr<const CompactGraph>& pGraph, const std::vector<NodeId>& pTargets)
+{
+    std::vector<NodeId> missing;
+    for(NodeId t : pTargets)
+    {
+        if(!this->isGraph(pGraph) || !this->contains(t))
+        {
+            missing.push_back(t);
+        }
+    }
+    if(!missing.empty())
+    {
+        this->fallback.prepare(pGraph, missing);
+    }
+}
+std::shared_ptr<DistanceMatrix> DistanceMatrix::create(const std::shared_ptr<const CompactGraph>& pGraph, std::vector<uint8_t> pBuffer, std::unique_ptr<MappedFile> pFile)
+{
+    return std::shared_ptr<DistanceMatrix>(new DistanceMatrix(pGraph, nullptr, std::move(pBuffer), std::move(pFile)));
+}
+std::shared_ptr<DistanceMatrix> DistanceMatrix::create(const std::shared_ptr<const LatticeGraph>& pGraph, std::vector<uint8_t> pBuffer, std::unique_ptr<MappedFile> pFile)
+{
+    return std::shared_ptr<DistanceMatrix>(new DistanceMatrix(nullptr, pGraph, std::move(pBuffer), std::move(pFile)));
+}
+std::pair<size_t, size_t> DistanceMatrix::getOffsets(size_t pTargetCount)
+{
+    size_t multiplierOffset = sizeof(Header) + pTargetCount * sizeof(NodeId);
+    multiplierOffset = (multiplierOffset + alignof(double) - 1) / alignof(double) * alignof(double);
+    return std::make_pair(multiplierOffset, multiplierOffset + pTargetCount * sizeof(double));
+}
+uint64_t DistanceMatrix::getFingerprint(const CompactGraph& pGraph)
+{
+    /*FNV-1a over the node names, the edges and the bit patterns of the weights*/
+    uint64_t hash = 14695981039346656037ull;
+    auto add = [&hash](const void* pData, size_t pSize) {
+        const uint8_t* bytes = static_cast<const uint8_t*>(pData);
+        for(size_t i = 0; i < pSize; i++)
+        {
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
+        }
+    };
+    for(NodeId n = 0; n < pGraph.getNodeCount(); n++)
+    {
+        const NodeType& name = pGraph.getNodeName(n);
+        add(name.data(), name.size() + 1);
+        std::span<const NodeId> outgoing = pGraph.getOutgoing(n);
+        std::span<const double> weights = pGraph.getOutgoingWeights(n);
+        add(outgoing.data(), outgoing.size_bytes());
+        add(weights.data(), weights.size_bytes());
+    }
+    return hash;
+}
+uint64_t DistanceMatrix::getFingerprint(const LatticeGraph& pGraph)
+{
+    /*FNV-1a over the sizes, the weights and the edges of all nodes which are not blocked; Blocked nodes have no edges and are not
+    reached by the edges of their neighbours, so the obstacles are part of the hash as well*/
+    uint64_t hash = 14695981039346656037ull;
+    auto add = [&hash](const void* pData, size_t pSize) {
+        const uint8_t* bytes = static_cast<const uint8_t*>(pData);
+        for(size_t i = 0; i < pSize; i++)
+        {
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
+        }
+    };
+    const uint32_t sizes[3] = {pGraph.getSizeX(), pGraph.getSizeY(), pGraph.hasSpikes() ? 1u : 0u};
+    add(sizes, sizeof(sizes));
+    for(NodeId n = 0; n < pGraph.getNodeCount(); n++)
+    {
+        const uint8_t blocked = pGraph.isBlocked(n) ? 1 : 0;
+        add(&blocked, sizeof(blocked));
+        if(blocked != 0)
+        {
+            continue;
+        }
+        pGraph.forEachOutgoing(n, [&add](NodeId pTarget, double pWeight) {
+            add(&pTarget, sizeof(pTarget));
+            add(&pWeight, sizeof(pWeight));
+        });
+    }
+    return hash;
+}
+bool DistanceMatrix::isGraph(const std::shared_ptr<const CompactGraph>& pGraph) const
+{
+    return pGraph == this->graph;
+}
+bool DistanceMatrix::isGraph(const std::shared_ptr<const LatticeGraph>& pGraph) const
+{
+    return pGraph == this->lattice;
+}
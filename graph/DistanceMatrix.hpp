@@ -0,0 +1,323 @@
+/**
+ * @file DistanceMatrix.hpp
+ * @author Lennart Hustermeier (lennart.hustermeier@gmx.de)
+ * @brief Contains a precomputed, quantized matrix of distances to target nodes which can be stored in and mapped from a file
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include "HeuristicCache.hpp"
+#include "MappedFile.hpp"
+#include "ThreadPool.hpp"
+#include <limits>
+#include <memory>
+#include <string>
+
+/**
+ * @brief The distances from all nodes to a set of target nodes (or all nodes) of a CompactGraph or of an implicit lattice, quantized
+ * to 16 bit per entry.
+ * Every row (target) has its own scale, the stored values are rounded down and shrunk slightly so the dequantized estimate stays
+ * admissible and consistent. The matrix can be saved to a file and mapped from it read-only, so the heuristic of a static
+ * environment is available without any search at startup and the operating system only loads the rows which are used.
+ *
+ * As HeuristicProvider the matrix is bound to the graph it was computed for; Other graphs and targets which are not part of the
+ * matrix are answered by an internal HeuristicCache.
+ */
+class DistanceMatrix : public HeuristicProvider
+{
+public:
+    /**
+     * @brief Marks a node from which the target can not be reached
+     */
+    static constexpr uint16_t UNREACHABLE = std::numeric_limits<uint16_t>::max();
+
+    /**
+     * @brief Calculates the matrix with one backward search per target on all threads of a pool; On graphs with uniform edge
+     * weights 64 targets share a bit-parallel BFS
+     *
+     * @param pGraph The graph to calculate the distances in
+     * @param pPool The threads to run on
+     * @param pTargets The target nodes; Empty selects all nodes (all-pairs). Throws std::out_of_range for an invalid node
+     * @return std::shared_ptr<DistanceMatrix> The matrix
+     */
+    static std::shared_ptr<DistanceMatrix> compute(std::shared_ptr<const CompactGraph> pGraph, ThreadPool& pPool, const std::vector<NodeId>& pTargets=std::vector<NodeId>());
+
+    /**
+     * @brief Calculates the matrix of a lattice with one backward search per target on all threads of a pool; The obstacles of the
+     * lattice are respected, so the matrix has to be calculated again if they change
+     *
+     * @param pGraph The lattice to calculate the distances in
+     * @param pPool The threads to run on
+     * @param pTargets The target nodes; Empty selects all nodes (all-pairs). Throws std::out_of_range for an invalid node
+     * @return std::shared_ptr<DistanceMatrix> The matrix
+     */
+    static std::shared_ptr<DistanceMatrix> compute(std::shared_ptr<const LatticeGraph> pGraph, ThreadPool& pPool, const std::vector<NodeId>& pTargets=std::vector<NodeId>());
+
+    /**
+     * @brief Maps a matrix from a file; Throws std::runtime_error if the file can not be read, is damaged or was calculated for
+     * another graph
+     *
+     * @param pPath The path of the file
+     * @param pGraph The graph the matrix has to belong to
+     * @return std::shared_ptr<DistanceMatrix> The matrix
+     */
+    static std::shared_ptr<DistanceMatrix> load(const std::string& pPath, std::shared_ptr<const CompactGraph> pGraph);
+
+    /**
+     * @brief Maps the matrix of a lattice from a file; Throws std::runtime_error if the file can not be read, is damaged or was
+     * calculated for another lattice (other sizes, weights or obstacles)
+     *
+     * @param pPath The path of the file
+     * @param pGraph The lattice the matrix has to belong to
+     * @return std::shared_ptr<DistanceMatrix> The matrix
+     */
+    static std::shared_ptr<DistanceMatrix> load(const std::string& pPath, std::shared_ptr<const LatticeGraph> pGraph);
+
+    /**
+     * @brief Maps a matrix from a file if it belongs to the graph and contains all targets, else calculates it and tries to store
+     * it in the file for the next start
+     *
+     * @param pPath The path of the file
+     * @param pGraph The graph to calculate the distances in
+     * @param pPool The threads to run on if the matrix has to be calculated
+     * @param pTargets The target nodes; Empty selects all nodes (all-pairs)
+     * @return std::shared_ptr<DistanceMatrix> The matrix
+     */
+    static std::shared_ptr<DistanceMatrix> loadOrCompute(const std::string& pPath, std::shared_ptr<const CompactGraph> pGraph, ThreadPool& pPool, const std::vector<NodeId>& pTargets=std::vector<NodeId>());
+
+    /**
+     * @brief Maps the matrix of a lattice from a file if it belongs to the lattice and contains all targets, else calculates it and
+     * tries to store it in the file for the next start
+     *
+     * @param pPath The path of the file
+     * @param pGraph The lattice to calculate the distances in
+     * @param pPool The threads to run on if the matrix has to be calculated
+     * @param pTargets The target nodes; Empty selects all nodes (all-pairs)
+     * @return std::shared_ptr<DistanceMatrix> The matrix
+     */
+    static std::shared_ptr<DistanceMatrix> loadOrCompute(const std::string& pPath, std::shared_ptr<const LatticeGraph> pGraph, ThreadPool& pPool, const std::vector<NodeId>& pTargets=std::vector<NodeId>());
+
+    /**
+     * @brief Stores the matrix in a file; Throws std::runtime_error if the file can not be written
+     *
+     * @param pPath The path of the file
+     */
+    void save(const std::string& pPath) const;
+
+    /**
+     * @brief Checks if the distances to a target are part of the matrix
+     *
+     * @param pTarget The target node
+     * @return true The matrix contains the target
+     * @return false The target is unknown
+     */
+    bool contains(NodeId pTarget) const;
+
+    /**
+     * @brief Returns the estimated costs from a node to a target; A lower bound which is at most one quantization step below the
+     * exact distance
+     *
+     * @param pNode The node
+     * @param pTarget The target node (has to be part of the matrix)
+     * @return double The estimate (infinity if pTarget can not be reached from pNode)
+     */
+    double getDistanceEstimate(NodeId pNode, NodeId pTarget) const
+    {
+        const uint32_t row = this->targetIndex[pTarget];
+        const uint16_t q = this->distances[static_cast<size_t>(row) * this->nodeCount + pNode];
+        return q == UNREACHABLE ? std::numeric_limits<double>::infinity() : q * this->multipliers[row];
+    }
+
+    /**
+     * @brief Returns the target nodes
+     *
+     * @return std::vector<NodeId> The targets in the order of the rows
+     */
+    std::vector<NodeId> getTargets() const;
+
+    /**
+     * @brief Returns the graph the matrix belongs to
+     *
+     * @return const std::shared_ptr<const CompactGraph>& The graph (nullptr if the matrix belongs to a lattice)
+     */
+    const std::shared_ptr<const CompactGraph>& getGraph() const;
+
+    /**
+     * @brief Returns the lattice the matrix belongs to
+     *
+     * @return const std::shared_ptr<const LatticeGraph>& The lattice (nullptr if the matrix belongs to a compact graph)
+     */
+    const std::shared_ptr<const LatticeGraph>& getLattice() const;
+
+    /**
+     * @brief Returns a heuristic which looks up the distances to pTarget
+     *
+     * @param pGraph The graph in which the search takes place
+     * @param pTarget The target node of the search
+     * @return std::function<double(NodeId)> The heuristic
+     */
+    std::function<double(NodeId)> getHeuristic(const std::shared_ptr<const CompactGraph>& pGraph, NodeId pTarget) override;
+
+    /**
+     * @brief Obstacle layers are planned on with the heuristics of the graph below through the provider base class
+     */
+    using HeuristicProvider::createPlanner;
+
+    /**
+     * @brief Creates a planner which looks up the matrix directly instead of through std::function
+     *
+     * @param pGraph The graph to plan on
+     * @param pAlgorithm The low level search to run
+     * @return std::shared_ptr<const LowLevelPlanner> The planner
+     */
+    std::shared_ptr<const LowLevelPlanner> createPlanner(const std::shared_ptr<const CompactGraph>& pGraph, LowLevelAlgorithm pAlgorithm) override;
+
+    /**
+     * @brief Creates a planner on a lattice which looks up the matrix directly; Other lattices get the exact distances of the
+     * internal HeuristicCache
+     *
+     * @param pGraph The lattice to plan on
+     * @param pAlgorithm The low level search to run
+     * @return std::shared_ptr<const LowLevelPlanner> The planner
+     */
+    std::shared_ptr<const LowLevelPlanner> createPlanner(const std::shared_ptr<const LatticeGraph>& pGraph, LowLevelAlgorithm pAlgorithm) override;
+
+    /**
+     * @brief Lets the internal HeuristicCache calculate the targets which are not part of the matrix
+     *
+     * @param pGraph The graph in which the searches will take place
+     * @param pTargets The target nodes
+     */
+    void prepare(const std::shared_ptr<const CompactGraph>& pGraph, const std::vector<NodeId>& pTargets) override;
+protected:
+    /**
+     * @brief Marks a node which is no target in targetIndex
+     */
+    static constexpr uint32_t NOT_A_TARGET = std::numeric_limits<uint32_t>::max();
+
+    /**
+     * @brief The layout of the file: <Header> <targets (uint32)> <padding to 8 bytes> <multipliers (double)> <rows (uint16)>
+     */
+    struct Header
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t nodeCount;
+        uint32_t targetCount;
+        uint32_t reserved;
+        uint64_t fingerprint;
+    };
+
+    /**
+     * @brief Constructs a matrix on top of its serialized form
+     *
+     * @param pGraph The graph the matrix belongs to (nullptr for a lattice)
+     * @param pLattice The lattice the matrix belongs to (nullptr for a compact graph)
+     * @param pBuffer The serialized matrix if it is held in memory
+     * @param pFile The mapped file if the matrix was loaded
+     */
+    DistanceMatrix(std::shared_ptr<const CompactGraph> pGraph, std::shared_ptr<const LatticeGraph> pLattice, std::vector<uint8_t> pBuffer, std::unique_ptr<MappedFile> pFile);
+
+    /**
+     * @brief Calculates the matrix on a compact graph or a lattice (see compute())
+     */
+    template<class GraphType> static std::shared_ptr<DistanceMatrix> computeMatrix(const std::shared_ptr<const GraphType>& pGraph, ThreadPool& pPool, const std::vector<NodeId>& pTargets);
+
+    /**
+     * @brief Maps the matrix of a compact graph or a lattice from a file (see load())
+     */
+    template<class GraphType> static std::shared_ptr<DistanceMatrix> loadMatrix(const std::string& pPath, const std::shared_ptr<const GraphType>& pGraph);
+
+    /**
+     * @brief Maps or calculates the matrix of a compact graph or a lattice (see loadOrCompute())
+     */
+    template<class GraphType> static std::shared_ptr<DistanceMatrix> loadOrComputeMatrix(const std::string& pPath, const std::shared_ptr<const GraphType>& pGraph, ThreadPool& pPool, const std::vector<NodeId>& pTargets);
+
+    /**
+     * @brief Creates a planner on the graph of the matrix which looks up the rows directly (see createPlanner())
+     */
+    template<class GraphType> std::shared_ptr<const LowLevelPlanner> createMatrixPlanner(const std::shared_ptr<const GraphType>& pGraph, LowLevelAlgorithm pAlgorithm);
+
+    /**
+     * @brief Wraps a serialized matrix of a compact graph respectively of a lattice
+     */
+    static std::shared_ptr<DistanceMatrix> create(const std::shared_ptr<const CompactGraph>& pGraph, std::vector<uint8_t> pBuffer, std::unique_ptr<MappedFile> pFile);
+    static std::shared_ptr<DistanceMatrix> create(const std::shared_ptr<const LatticeGraph>& pGraph, std::vector<uint8_t> pBuffer, std::unique_ptr<MappedFile> pFile);
+
+    /**
+     * @brief Returns the byte offsets of the multipliers and of the rows in the serialized form
+     *
+     * @param pTargetCount The number of targets
+     * @return std::pair<size_t, size_t> (<offset of the multipliers>, <offset of the rows>)
+     */
+    static std::pair<size_t, size_t> getOffsets(size_t pTargetCount);
+
+    /**
+     * @brief Calculates a hash of the nodes, edges and weights of a graph to detect files which belong to another graph
+     *
+     * @param pGraph The graph
+     * @return uint64_t The hash
+     */
+    static uint64_t getFingerprint(const CompactGraph& pGraph);
+
+    /**
+     * @brief Calculates a hash of the sizes, weights, obstacles and edges of a lattice to detect files which belong to another
+     * lattice
+     *
+     * @param pGraph The lattice
+     * @return uint64_t The hash
+     */
+    static uint64_t getFingerprint(const LatticeGraph& pGraph);
+
+    /**
+     * @brief Checks if a graph respectively a lattice is the one the matrix belongs to
+     */
+    bool isGraph(const std::shared_ptr<const CompactGraph>& pGraph) const;
+    bool isGraph(const std::shared_ptr<const LatticeGraph>& pGraph) const;
+
+    /**
+     * @brief The graph the matrix belongs to (nullptr for a lattice)
+     */
+    std::shared_ptr<const CompactGraph> graph;
+
+    /**
+     * @brief The lattice the matrix belongs to (nullptr for a compact graph)
+     */
+    std::shared_ptr<const LatticeGraph> lattice;
+
+    /**
+     * @brief The serialized matrix if it was calculated
+     */
+    std::vector<uint8_t> buffer;
+
+    /**
+     * @brief The mapped file if the matrix was loaded
+     */
+    std::unique_ptr<MappedFile> file;
+
+    /**
+     * @brief Points into the serialized matrix (either buffer or file)
+     */
+    const uint8_t* data;
+    size_t size;
+    const NodeId* targets;
+    const double* multipliers;
+    const uint16_t* distances;
+    size_t nodeCount;
+    size_t targetCount;
+
+    /**
+     * @brief Maps a node to its row (NOT_A_TARGET if it is no target)
+     */
+    std::vector<uint32_t> targetIndex;
+
+    /**
+     * @brief Answers the targets which are not part of the matrix
+     */
+    HeuristicCache fallback;
+};
@@ -0,0 +1,269 @@
+/**
+ * @file GraphSnapshot.cpp
+ * @author Lennart Hustermeier (lennart.hustermeier@gmx.de)
+ * @brief Contains the serialization of graph snapshots and the access to mapped snapshots
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "GraphSnapshot.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+namespace
+{
+    /*Identifies the file format*/
+    constexpr char MAGIC[8] = {'G', 'R', 'A', 'P', 'H', 'S', 'N', 'P'};
+    constexpr uint32_t VERSION = 1;
+
+    /*Rounds an offset up to the next multiple of 8*/
+    constexpr size_t align(size_t pOffset)
+    {
+        return (pOffset + 7) / 8 * 8;
+    }
+}
+
+GraphSnapshot::GraphSnapshot(const std::string& pPath)
+: file(pPath)
+{
+    Header header;
+    if(this->file.getSize() < sizeof(Header))
+    {
+        throw(std::runtime_error("GraphSnapshot::GraphSnapshot(): " + pPath + " is no graph snapshot!"));
+    }
+    std::memcpy(&header, this->file.getData(), sizeof(Header));
+    if(std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION)
+    {
+        throw(std::runtime_error("GraphSnapshot::GraphSnapshot(): " + pPath + " is no graph snapshot of version " + std::to_string(VERSION) + "!"));
+    }
+    if(header.nodeCount >= INVALID_NODE || header.edgeCount > std::numeric_limits<uint32_t>::max() || header.nameBytes > std::numeric_limits<uint32_t>::max())
+    {
+        throw(std::runtime_error("GraphSnapshot::GraphSnapshot(): " + pPath + " is damaged!"));
+    }
+    std::array<size_t, 10> layout = GraphSnapshot::getLayout(header);
+    if(this->file.getSize() != layout[9])
+    {
+        throw(std::runtime_error("GraphSnapshot::GraphSnapshot(): " + pPath + " is damaged!"));
+    }
+
+    const uint8_t* data = this->file.getData();
+    this->nodeCount = header.nodeCount;
+    this->edgeCount = header.edgeCount;
+    this->outOffsets = reinterpret_cast<const uint32_t*>(data + layout[0]);
+    this->outTargets = reinterpret_cast<const NodeId*>(data + layout[1]);
+    this->outWeights = reinterpret_cast<const double*>(data + layout[2]);
+    this->inOffsets = reinterpret_cast<const uint32_t*>(data + layout[3]);
+    this->inSources = reinterpret_cast<const NodeId*>(data + layout[4]);
+    this->inWeights = reinterpret_cast<const double*>(data + layout[5]);
+    this->nameOffsets = reinterpret_cast<const uint32_t*>(data + layout[6]);
+    this->names = reinterpret_cast<const char*>(data + layout[7]);
+    this->positions = (header.flags & FLAG_POSITIONS) ? reinterpret_cast<const double*>(data + layout[8]) : nullptr;
+
+    /*Every range has to lie inside of its section and every edge has to end in a node of the graph; One read-only pass over the
+    offsets and the edges, nothing is copied*/
+    if(this->outOffsets[0] != 0 || this->inOffsets[0] != 0 || this->nameOffsets[0] != 0 || this->outOffsets[this->nodeCount] != this->edgeCount ||
+       this->inOffsets[this->nodeCount] != this->edgeCount || this->nameOffsets[this->nodeCount] != header.nameBytes)
+    {
+        throw(std::runtime_error("GraphSnapshot::GraphSnapshot(): " + pPath + " is damaged!"));
+    }
+    for(size_t n = 0; n < this->nodeCount; n++)
+    {
+        if(this->outOffsets[n] > this->outOffsets[n + 1] || this->inOffsets[n] > this->inOffsets[n + 1] || this->nameOffsets[n] > this->nameOffsets[n + 1])
+        {
+            throw(std::runtime_error("GraphSnapshot::GraphSnapshot(): " + pPath + " is damaged!"));
+        }
+    }
+    for(size_t e = 0; e < this->edgeCount; e++)
+    {
+        if(this->outTargets[e] >= this->nodeCount || this->inSources[e] >= this->nodeCount)
+        {
+            throw(std::runtime_error("GraphSnapshot::GraphSnapshot(): " + pPath + " is damaged!"));
+        }
+    }
+}
+void GraphSnapshot::save(const std::string& pPath, const CompactGraph& pGraph, const std::vector<std::array<double, 3>>& pPositions)
+{
+    const size_t nodeCount = pGraph.getNodeCount();
+    if(!pPositions.empty() && pPositions.size() != nodeCount)
+    {
+        throw(std::invalid_argument("GraphSnapshot::save(): There has to be one position per node!"));
+    }
+
+    Header header;
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.flags = pPositions.empty() ? 0 : FLAG_POSITIONS;
+    header.nodeCount = nodeCount;
+    header.edgeCount = pGraph.getEdgeCount();
+    header.nameBytes = 0;
+
+    /*Flatten the CSR ranges of the compact graph and the names into the sections*/
+    std::vector<uint32_t> outOffsets(1, 0);
+    std::vector<NodeId> outTargets;
+    std::vector<double> outWeights;
+    std::vector<uint32_t> inOffsets(1, 0);
+    std::vector<NodeId> inSources;
+    std::vector<double> inWeights;
+    std::vector<uint32_t> nameOffsets(1, 0);
+    std::string names;
+    for(NodeId n = 0; n < nodeCount; n++)
+    {
+        outTargets.insert(outTargets.end(), pGraph.getOutgoing(n).begin(), pGraph.getOutgoing(n).end());
+        outWeights.insert(outWeights.end(), pGraph.getOutgoingWeights(n).begin(), pGraph.getOutgoingWeights(n).end());
+        outOffsets.push_back(static_cast<uint32_t>(outTargets.size()));
+        inSources.insert(inSources.end(), pGraph.getIncoming(n).begin(), pGraph.getIncoming(n).end());
+        inWeights.insert(inWeights.end(), pGraph.getIncomingWeights(n).begin(), pGraph.getIncomingWeights(n).end());
+        inOffsets.push_back(static_cast<uint32_t>(inSources.size()));
+        names += pGraph.getNodeName(n);
+        nameOffsets.push_back(static_cast<uint32_t>(names.size()));
+    }
+    header.nameBytes = names.size();
+
+    std::ofstream out(pPath, std::ios::binary | std::ios::trunc);
+    if(!out)
+    {
+        throw(std::runtime_error("GraphSnapshot::save(): Can not open " + pPath + "!"));
+    }
+    std::array<size_t, 10> layout = GraphSnapshot::getLayout(header);
+    size_t written = 0;
+    auto write = [&](size_t pOffset, const void* pData, size_t pSize) {
+        /*Pad up to the start of the section*/
+        static const char zeros[8] = {};
+        out.write(zeros, static_cast<std::streamsize>(pOffset - written));
+        out.write(static_cast<const char*>(pData), static_cast<std::streamsize>(pSize));
+        written = pOffset + pSize;
+    };
+    write(0, &header, sizeof(Header));
+    write(layout[0], outOffsets.data(), outOffsets.size() * sizeof(uint32_t));
+    write(layout[1], outTargets.data(), outTargets.size() * sizeof(NodeId));
+    write(layout[2], outWeights.data(), outWeights.size() * sizeof(double));
+    write(layout[3], inOffsets.data(), inOffsets.size() * sizeof(uint32_t));
+    write(layout[4], inSources.data(), inSources.size() * sizeof(NodeId));
+    write(layout[5], inWeights.data(), inWeights.size() * sizeof(double));
+    write(layout[6], nameOffsets.data(), nameOffsets.size() * sizeof(uint32_t));
+    write(layout[7], names.data(), names.size());
+    write(layout[8], pPositions.data(), pPositions.size() * sizeof(std::array<double, 3>));
+    write(layout[9], nullptr, 0);
+    if(!out)
+    {
+        throw(std::runtime_error("GraphSnapshot::save(): Can not write " + pPath + "!"));
+    }
+}
+size_t GraphSnapshot::getNodeCount() const
+{
+    return this->nodeCount;
+}
+size_t GraphSnapshot::getEdgeCount() const
+{
+    return this->edgeCount;
+}
+NodeId GraphSnapshot::getNodeId(std::string_view pNode) const
+{
+    /*The names are sorted like the IDs of the compact graph*/
+    size_t first = 0;
+    size_t count = this->nodeCount;
+    while(count > 0)
+    {
+        size_t step = count / 2;
+        if(this->getNodeNameView(static_cast<NodeId>(first + step)) < pNode)
+        {
+            first += step + 1;
+            count -= step + 1;
+        }
+        else
+        {
+            count = step;
+        }
+    }
+    if(first == this->nodeCount || this->getNodeNameView(static_cast<NodeId>(first)) != pNode)
+    {
+        return INVALID_NODE;
+    }
+    return static_cast<NodeId>(first);
+}
+std::string_view GraphSnapshot::getNodeNameView(NodeId pNode) const
+{
+    return std::string_view(this->names + this->nameOffsets[pNode], this->nameOffsets[pNode + 1] - this->nameOffsets[pNode]);
+}
+NodeType GraphSnapshot::getNodeName(NodeId pNode) const
+{
+    return NodeType(this->getNodeNameView(pNode));
+}
+std::optional<double> GraphSnapshot::getWeight(NodeId pFrom, NodeId pTo) const
+{
+    if(pFrom >= this->nodeCount)
+    {
+        return {};
+    }
+    std::span<const NodeId> outgoing = this->getOutgoing(pFrom);
+    std::span<const NodeId>::iterator i = std::lower_bound(outgoing.begin(), outgoing.end(), pTo);
+    if(i == outgoing.end() || *i != pTo)
+    {
+        return {};
+    }
+    return this->getOutgoingWeights(pFrom)[i - outgoing.begin()];
+}
+double GraphSnapshot::getPathCost(const std::vector<NodeId>& pPath) const
+{
+    double sum = 0.0;
+    for(size_t cntr = 1; cntr < pPath.size(); cntr++)
+    {
+        std::optional<double> w = this->getWeight(pPath[cntr - 1], pPath[cntr]);
+        if(!w.has_value())
+        {
+            throw(std::out_of_range("GraphSnapshot::getPathCost(): The path contains an edge which is not part of the graph!"));
+        }
+        sum += w.value();
+    }
+    return sum;
+}
+bool GraphSnapshot::hasPositions() const
+{
+    return this->positions != nullptr;
+}
+std::array<double, 3> GraphSnapshot::getPosition(NodeId pNode) const
+{
+    if(this->positions == nullptr || pNode >= this->nodeCount)
+    {
+        throw(std::out_of_range("GraphSnapshot::getPosition(): There is no position for the node!"));
+    }
+    return {this->positions[3 * pNode], this->positions[3 * pNode + 1], this->positions[3 * pNode + 2]};
+}
+Graph GraphSnapshot::toGraph() const
+{
+    std::set<NodeType> nodes;
+    std::set<std::tuple<NodeType, NodeType, double>> edges;
+    for(NodeId n = 0; n < this->nodeCount; n++)
+    {
+        NodeType name = this->getNodeName(n);
+        nodes.insert(name);
+        this->forEachOutgoing(n, [&](NodeId pTarget, double pWeight) {
+            edges.insert(std::make_tuple(name, this->getNodeName(pTarget), pWeight));
+        });
+    }
+    return Graph(nodes, edges);
+}
+std::array<size_t, 10> GraphSnapshot::getLayout(const Header& pHeader)
+{
+    std::array<size_t, 10> result;
+    const size_t sizes[9] = {
+        (pHeader.nodeCount + 1) * sizeof(uint32_t), pHeader.edgeCount * sizeof(NodeId), pHeader.edgeCount * sizeof(double),
+        (pHeader.nodeCount + 1) * sizeof(uint32_t), pHeader.edgeCount * sizeof(NodeId), pHeader.edgeCount * sizeof(double),
+        (pHeader.nodeCount + 1) * sizeof(uint32_t), pHeader.nameBytes,
+        (pHeader.flags & FLAG_POSITIONS) ? pHeader.nodeCount * 3 * sizeof(double) : 0
+    };
+    size_t offset = sizeof(Header);
+    for(size_t i = 0; i < 9; i++)
+    {
+        result[i] = align(offset);
+        offset = result[i] + sizes[i];
+    }
+    result[9] = offset;
+    return result;
+}
@@ -0,0 +1,274 @@
+/**
+ * @file GraphSnapshot.hpp
+ * @author Lennart Hustermeier (lennart.hustermeier@gmx.de)
+ * @brief Contains a frozen graph which is stored in a binary file and used directly from a read-only memory mapping
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include "CompactGraph.hpp"
+#include "MappedFile.hpp"
+#include "graph.hpp"
+#include <array>
+#include <memory>
+#include <string_view>
+
+/**
+ * @brief A CompactGraph frozen into a versioned binary file: The CSR arrays of the outgoing and incoming edges, the weights, a
+ * string table of the node names and optionally a position per node. Loading a snapshot maps the file and points into it, nothing
+ * is parsed, allocated or copied; The ranges and edges are only validated in one pass, afterwards the operating system only loads
+ * the pages which are accessed.
+ *
+ * The snapshot provides the same interface as CompactGraph towards the search kernels (getNodeCount(), isBlocked(),
+ * forEachOutgoing(), forEachIncoming(), ...), so they can run on it directly.
+ */
+class GraphSnapshot
+{
+public:
+    /**
+     * @brief Marks an invalid node ID (e.g. the result of a lookup of a node which is not part of the graph)
+     */
+    static constexpr NodeId INVALID_NODE = CompactGraph::INVALID_NODE;
+
+    /**
+     * @brief Maps a snapshot; Throws std::runtime_error if the file can not be read or is no valid snapshot
+     *
+     * @param pPath The path of the file
+     */
+    GraphSnapshot(const std::string& pPath);
+
+    /**
+     * @brief Writes a snapshot of a graph; Throws std::runtime_error if the file can not be written and std::invalid_argument if
+     * the number of positions does not match the number of nodes
+     *
+     * @param pPath The path of the file
+     * @param pGraph The graph to store
+     * @param pPositions The (x, y, z) position of every node indexed by node ID; May be empty
+     */
+    static void save(const std::string& pPath, const CompactGraph& pGraph, const std::vector<std::array<double, 3>>& pPositions=std::vector<std::array<double, 3>>());
+
+    /**
+     * @brief Returns the number of nodes in the graph
+     *
+     * @return size_t Number of nodes
+     */
+    size_t getNodeCount() const;
+
+    /**
+     * @brief Returns the number of (directed) edges in the graph
+     *
+     * @return size_t Number of edges
+     */
+    size_t getEdgeCount() const;
+
+    /**
+     * @brief Returns the ID of a node
+     *
+     * @param pNode The name of the node
+     * @return NodeId The ID of the node or INVALID_NODE if the node is not part of the graph
+     */
+    NodeId getNodeId(std::string_view pNode) const;
+
+    /**
+     * @brief Returns the name of a node as a view into the mapped file
+     *
+     * @param pNode The ID of the node (has to be valid)
+     * @return std::string_view The name of the node
+     */
+    std::string_view getNodeNameView(NodeId pNode) const;
+
+    /**
+     * @brief Returns the name of a node
+     *
+     * @param pNode The ID of the node (has to be valid)
+     * @return NodeType The name of the node
+     */
+    NodeType getNodeName(NodeId pNode) const;
+
+    /**
+     * @brief Returns the targets of all outgoing edges of a node (sorted by ID)
+     *
+     * @param pNode The node to get the outgoing edges for
+     * @return std::span<const NodeId> The targets of the outgoing edges
+     */
+    std::span<const NodeId> getOutgoing(NodeId pNode) const
+    {
+        return std::span<const NodeId>(this->outTargets + this->outOffsets[pNode], this->outOffsets[pNode + 1] - this->outOffsets[pNode]);
+    }
+
+    /**
+     * @brief Returns the weights of all outgoing edges of a node in the same order as getOutgoing()
+     *
+     * @param pNode The node to get the outgoing edge weights for
+     * @return std::span<const double> The weights of the outgoing edges
+     */
+    std::span<const double> getOutgoingWeights(NodeId pNode) const
+    {
+        return std::span<const double>(this->outWeights + this->outOffsets[pNode], this->outOffsets[pNode + 1] - this->outOffsets[pNode]);
+    }
+
+    /**
+     * @brief Returns the sources of all incoming edges of a node (sorted by ID)
+     *
+     * @param pNode The node to get the incoming edges for
+     * @return std::span<const NodeId> The sources of the incoming edges
+     */
+    std::span<const NodeId> getIncoming(NodeId pNode) const
+    {
+        return std::span<const NodeId>(this->inSources + this->inOffsets[pNode], this->inOffsets[pNode + 1] - this->inOffsets[pNode]);
+    }
+
+    /**
+     * @brief Returns the weights of all incoming edges of a node in the same order as getIncoming()
+     *
+     * @param pNode The node to get the incoming edge weights for
+     * @return std::span<const double> The weights of the incoming edges
+     */
+    std::span<const double> getIncomingWeights(NodeId pNode) const
+    {
+        return std::span<const double>(this->inWeights + this->inOffsets[pNode], this->inOffsets[pNode + 1] - this->inOffsets[pNode]);
+    }
+
+    /**
+     * @brief Calls pCallback(<target>, <weight>) for every outgoing edge of a node (same interface as CompactGraph)
+     *
+     * @tparam Callback Callable with the signature void(NodeId, double)
+     * @param pNode The node to iterate the outgoing edges of
+     * @param pCallback The callback to call for every edge
+     */
+    template<class Callback> void forEachOutgoing(NodeId pNode, Callback&& pCallback) const
+    {
+        for(uint32_t e = this->outOffsets[pNode]; e < this->outOffsets[pNode + 1]; e++)
+        {
+            pCallback(this->outTargets[e], this->outWeights[e]);
+        }
+    }
+
+    /**
+     * @brief Calls pCallback(<source>, <weight>) for every incoming edge of a node (same interface as CompactGraph)
+     *
+     * @tparam Callback Callable with the signature void(NodeId, double)
+     * @param pNode The node to iterate the incoming edges of
+     * @param pCallback The callback to call for every edge
+     */
+    template<class Callback> void forEachIncoming(NodeId pNode, Callback&& pCallback) const
+    {
+        for(uint32_t e = this->inOffsets[pNode]; e < this->inOffsets[pNode + 1]; e++)
+        {
+            pCallback(this->inSources[e], this->inWeights[e]);
+        }
+    }
+
+    /**
+     * @brief Returns if a node is blocked; Snapshots have no obstacles (same interface as CompactGraph)
+     *
+     * @return false Always
+     */
+    constexpr bool isBlocked(NodeId) const
+    {
+        return false;
+    }
+
+    /**
+     * @brief Returns the weight of an edge
+     *
+     * @param pFrom The start node of the edge
+     * @param pTo The end node of the edge
+     * @return std::optional<double> The weight of the edge or an empty optional if there is no such edge
+     */
+    std::optional<double> getWeight(NodeId pFrom, NodeId pTo) const;
+
+    /**
+     * @brief Returns the costs of a path in this graph
+     *
+     * @param pPath The path as a vector of node IDs
+     * @return double The costs of the path; Throws std::out_of_range if two consecutive nodes are not connected by an edge
+     */
+    double getPathCost(const std::vector<NodeId>& pPath) const;
+
+    /**
+     * @brief Checks if the snapshot contains the positions of the nodes
+     *
+     * @return true There is a position for every node
+     * @return false The snapshot was saved without positions
+     */
+    bool hasPositions() const;
+
+    /**
+     * @brief Returns the position of a node; Throws std::out_of_range if the snapshot has no positions or the node is invalid
+     *
+     * @param pNode The node
+     * @return std::array<double, 3> The (x, y, z) position
+     */
+    std::array<double, 3> getPosition(NodeId pNode) const;
+
+    /**
+     * @brief Creates a Graph with the same nodes and edges, e.g. to use the API on node names
+     *
+     * @return Graph The graph
+     */
+    Graph toGraph() const;
+protected:
+    /**
+     * @brief The header of the file; The sections follow in the order of the members below, every one aligned to 8 bytes
+     */
+    struct Header
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t flags;
+        uint64_t nodeCount;
+        uint64_t edgeCount;
+        uint64_t nameBytes;
+    };
+
+    /**
+     * @brief Set in Header::flags if the positions section exists
+     */
+    static constexpr uint32_t FLAG_POSITIONS = 1;
+
+    /**
+     * @brief Returns the byte offsets of all sections and the size of the file
+     *
+     * @param pHeader The header describing the snapshot
+     * @return std::array<size_t, 10> The offsets of the sections in the order of the members and the size of the file
+     */
+    static std::array<size_t, 10> getLayout(const Header& pHeader);
+
+    /**
+     * @brief The mapped file
+     */
+    MappedFile file;
+
+    /**
+     * @brief The sizes of the graph
+     */
+    size_t nodeCount;
+    size_t edgeCount;
+
+    /**
+     * @brief The CSR arrays inside of the mapped file (see CompactGraph)
+     */
+    const uint32_t* outOffsets;
+    const NodeId* outTargets;
+    const double* outWeights;
+    const uint32_t* inOffsets;
+    const NodeId* inSources;
+    const double* inWeights;
+
+    /**
+     * @brief The string table: The name of node n is made of the bytes [nameOffsets[n], nameOffsets[n+1]) of names, sorted by name
+     */
+    const uint32_t* nameOffsets;
+    const char* names;
+
+    /**
+     * @brief The positions (3 values per node) or nullptr
+     */
+    const double* positions;
+};
@@ -0,0 +1,143 @@
+/**
+ * @file HeuristicCache.cpp
+ * @author Lennart Hustermeier (lennart.hustermeier@gmx.de)
+ * @brief Contains the implementation of the cache of exact distances to target nodes
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "HeuristicCache.hpp"
+#include "LowLevelPlanner.hpp"
+#include "ShortestPathTree.hpp"
+#include "HopDistanceMatrix.hpp"
+#include <algorithm>
+
+HeuristicCache::HeuristicCache()
+{
+
+}
+std::shared_ptr<const std::vector<double>> HeuristicCache::getDistances(const std::shared_ptr<const CompactGraph>& pGraph, NodeId pTarget)
+{
+    return this->lookup(pGraph, pTarget);
+}
+std::shared_ptr<const std::vector<double>> HeuristicCache::getDistances(const std::shared_ptr<const LatticeGraph>& pGraph, NodeId pTarget)
+{
+    return this->lookup(pGraph, pTarget);
+}
+template<class GraphType> std::shared_ptr<const std::vector<double>> HeuristicCache::lookup(const std::shared_ptr<const GraphType>& pGraph, NodeId pTarget)
+{
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        if(this->graph != pGraph)
+        {
+            /*The graph changed -> all cached distances are outdated*/
+            this->distances.clear();
+            this->graph = pGraph;
+        }
+
+        std::unordered_map<NodeId, std::shared_ptr<const std::vector<double>>>::const_iterator d = this->distances.find(pTarget);
+        if(d != this->distances.end())
+        {
+            return d->second;
+        }
+    }
+
+    /*A backward search from the target yields the distances of all nodes to the target; The cache is not locked meanwhile, so
+    other threads can keep reading*/
+    ShortestPathTree tree = ShortestPathTree::compute(pGraph, pTarget, std::vector<bool>(), GraphType::INVALID_NODE, true);
+    std::shared_ptr<const std::vector<double>> result = std::make_shared<const std::vector<double>>(tree.getDistances());
+
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if(this->graph != pGraph)
+    {
+        /*The cache was switched to another graph in the meantime -> the distances are still valid for pGraph, but not cached*/
+        return result;
+    }
+    /*Another thread may have calculated the same target meanwhile; Its distances are kept, so all callers share one array*/
+    return this->distances.try_emplace(pTarget, result).first->second;
+}
+std::function<double(NodeId)> HeuristicCache::getHeuristic(const std::shared_ptr<const CompactGraph>& pGraph, NodeId pTarget)
+{
+    std::shared_ptr<const std::vector<double>> d = this->getDistances(pGraph, pTarget);
+    return [d](NodeId pNode) { return (*d)[pNode]; };
+}
+std::shared_ptr<const LowLevelPlanner> HeuristicCache::createPlanner(const std::shared_ptr<const CompactGraph>& pGraph, LowLevelAlgorithm pAlgorithm)
+{
+    return makeLowLevelPlanner(pGraph, [this](const std::shared_ptr<const CompactGraph>& pG, NodeId pTarget) {
+        std::shared_ptr<const std::vector<double>> d = this->getDistances(pG, pTarget);
+        return [d](NodeId pNode) { return (*d)[pNode]; };
+    }, pAlgorithm);
+}
+std::shared_ptr<const LowLevelPlanner> HeuristicCache::createPlanner(const std::shared_ptr<const LatticeGraph>& pGraph, LowLevelAlgorithm pAlgorithm)
+{
+    return makeLowLevelPlanner(pGraph, [this](const std::shared_ptr<const LatticeGraph>& pG, NodeId pTarget) {
+        std::shared_ptr<const std::vector<double>> d = this->getDistances(pG, pTarget);
+        return [d](NodeId pNode) { return (*d)[pNode]; };
+    }, pAlgorithm);
+}
+std::shared_ptr<const LowLevelPlanner> HeuristicCache::createPlanner(const std::shared_ptr<const BlockedGraph>& pGraph, LowLevelAlgorithm pAlgorithm)
+{
+    return makeLowLevelPlanner(pGraph, [this](const std::shared_ptr<const BlockedGraph>& pG, NodeId pTarget) {
+        std::shared_ptr<const std::vector<double>> d = this->getDistances(pG->getGraph(), pTarget);
+        return [d](NodeId pNode) { return (*d)[pNode]; };
+    }, pAlgorithm);
+}
+void HeuristicCache::prepare(const std::shared_ptr<const CompactGraph>& pGraph, const std::vector<NodeId>& pTargets)
+{
+    std::optional<double> weight = pGraph->getUniformWeight();
+    if(!weight.has_value())
+    {
+        /*The hops are no distances -> fall back to one Dijkstra per target on demand*/
+        return;
+    }
+
+    std::vector<NodeId> missing;
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        if(this->graph != pGraph)
+        {
+            this->distances.clear();
+            this->graph = pGraph;
+        }
+        for(NodeId t : pTargets)
+        {
+            if(t < pGraph->getNodeCount() && this->distances.find(t) == this->distances.end() &&
+               std::find(missing.begin(), missing.end(), t) == missing.end())
+            {
+                missing.push_back(t);
+            }
+        }
+    }
+    if(missing.empty())
+    {
+        return;
+    }
+
+    /*Backward BFS from all targets at once; The cache is not locked meanwhile, so other threads can keep reading*/
+    HopDistanceMatrix matrix = HopDistanceMatrix::compute(pGraph, missing, std::vector<bool>(), true);
+
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if(this->graph != pGraph)
+    {
+        /*The cache was switched to another graph in the meantime*/
+        return;
+    }
+    for(size_t i = 0; i < missing.size(); i++)
+    {
+        this->distances.try_emplace(missing[i], std::make_shared<const std::vector<double>>(matrix.getDistances(i, weight.value())));
+    }
+}
+void HeuristicCache::clear()
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->distances.clear();
+    this->graph.reset();
+}
+size_t HeuristicCache::size() const
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->distances.size();
+}
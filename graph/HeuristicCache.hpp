@@ -0,0 +1,133 @@
+/**
+ * @file HeuristicCache.hpp
+ * @author Lennart Hustermeier (lennart.hustermeier@gmx.de)
+ * @brief Contains a cache of exact distances to target nodes which is used as perfect heuristic for A*
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include "HeuristicProvider.hpp"
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Caches the true distances from every node to a target node. The distances are calculated by one backward Dijkstra per
+ * distinct target and stored as dense array indexed by node ID. The cache is bound to one graph (a compact graph or an implicit
+ * lattice); If it is used with another graph (e.g. because the environment changed) all entries are dropped. Obstacles which are set
+ * on a lattice afterwards are not detected, clear() the cache in that case. The cache can be used from multiple threads; The
+ * searches run without holding the lock, so a missing target does not block lookups of other threads.
+ */
+class HeuristicCache : public HeuristicProvider
+{
+public:
+    /**
+     * @brief Constructs a new empty cache
+     */
+    HeuristicCache();
+
+    /**
+     * @brief Returns the distances from all nodes to a target node, calculating them if necessary
+     *
+     * @param pGraph The graph in which the distances shall be calculated
+     * @param pTarget The target node
+     * @return std::shared_ptr<const std::vector<double>> Distances indexed by node ID (infinity if pTarget can not be reached)
+     */
+    std::shared_ptr<const std::vector<double>> getDistances(const std::shared_ptr<const CompactGraph>& pGraph, NodeId pTarget);
+
+    /**
+     * @brief Returns the distances from all nodes of a lattice to a target node, calculating them if necessary
+     *
+     * @param pGraph The lattice in which the distances shall be calculated
+     * @param pTarget The target node
+     * @return std::shared_ptr<const std::vector<double>> Distances indexed by node ID (infinity if pTarget can not be reached)
+     */
+    std::shared_ptr<const std::vector<double>> getDistances(const std::shared_ptr<const LatticeGraph>& pGraph, NodeId pTarget);
+
+    /**
+     * @brief Returns a heuristic which looks up the exact distance to pTarget
+     *
+     * @param pGraph The graph in which the search takes place
+     * @param pTarget The target node of the search
+     * @return std::function<double(NodeId)> The heuristic
+     */
+    std::function<double(NodeId)> getHeuristic(const std::shared_ptr<const CompactGraph>& pGraph, NodeId pTarget) override;
+
+    /**
+     * @brief Creates a planner which looks up the cached distances directly instead of through std::function
+     *
+     * @param pGraph The graph to plan on
+     * @param pAlgorithm The low level search to run
+     * @return std::shared_ptr<const LowLevelPlanner> The planner
+     */
+    std::shared_ptr<const LowLevelPlanner> createPlanner(const std::shared_ptr<const CompactGraph>& pGraph, LowLevelAlgorithm pAlgorithm) override;
+
+    /**
+     * @brief Creates a planner on a lattice which looks up the exact cached distances instead of the arithmetic estimate
+     *
+     * @param pGraph The lattice to plan on
+     * @param pAlgorithm The low level search to run
+     * @return std::shared_ptr<const LowLevelPlanner> The planner
+     */
+    std::shared_ptr<const LowLevelPlanner> createPlanner(const std::shared_ptr<const LatticeGraph>& pGraph, LowLevelAlgorithm pAlgorithm) override;
+
+    /**
+     * @brief Creates a planner on an obstacle layer which looks up the cached distances of the graph below the layer directly
+     *
+     * @param pGraph The obstacle layer to plan on
+     * @param pAlgorithm The low level search to run
+     * @return std::shared_ptr<const LowLevelPlanner> The planner
+     */
+    std::shared_ptr<const LowLevelPlanner> createPlanner(const std::shared_ptr<const BlockedGraph>& pGraph, LowLevelAlgorithm pAlgorithm) override;
+
+    /**
+     * @brief Calculates the distances to all targets which are not cached yet; On graphs with uniform edge weights all of them
+     * are calculated by one bit-parallel BFS (64 targets per pass) instead of one Dijkstra per target
+     *
+     * @param pGraph The graph in which the distances shall be calculated
+     * @param pTargets The target nodes
+     */
+    void prepare(const std::shared_ptr<const CompactGraph>& pGraph, const std::vector<NodeId>& pTargets) override;
+
+    /**
+     * @brief Drops all cached distances
+     */
+    void clear();
+
+    /**
+     * @brief Returns the number of targets for which distances are cached
+     *
+     * @return size_t Number of cached targets
+     */
+    size_t size() const;
+protected:
+    /**
+     * @brief Looks up the distances to a target on any graph ShortestPathTree can search, calculating them if necessary
+     *
+     * @param pGraph The graph in which the distances shall be calculated
+     * @param pTarget The target node
+     * @return std::shared_ptr<const std::vector<double>> Distances indexed by node ID
+     */
+    template<class GraphType> std::shared_ptr<const std::vector<double>> lookup(const std::shared_ptr<const GraphType>& pGraph, NodeId pTarget);
+
+    /**
+     * @brief Protects the cache as it is shared between the threads of CBS
+     */
+    mutable std::mutex mutex;
+
+    /**
+     * @brief The graph for which the distances are cached (a compact graph or a lattice); Kept alive so its identity can not be
+     * reused by another graph
+     */
+    std::shared_ptr<const void> graph;
+
+    /**
+     * @brief Maps a target node to the distances of all nodes to it
+     */
+    std::unordered_map<NodeId, std::shared_ptr<const std::vector<double>>> distances;
+};
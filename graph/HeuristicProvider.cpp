@@ -0,0 +1,34 @@
+/**
+ * @file HeuristicProvider.cpp
+ * @author Lennart Hustermeier (lennart.hustermeier@gmx.de)
+ * @brief Contains the default implementation of the planner creation of heuristic providers
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "HeuristicProvider.hpp"
+#include "LowLevelPlanner.hpp"
+
+std::shared_ptr<const LowLevelPlanner> HeuristicProvider::createPlanner(const std::shared_ptr<const CompactGraph>& pGraph, LowLevelAlgorithm pAlgorithm)
+{
+    return makeLowLevelPlanner(pGraph, [this](const std::shared_ptr<const CompactGraph>& pG, NodeId pTarget) {
+        return this->getHeuristic(pG, pTarget);
+    }, pAlgorithm);
+}
+std::shared_ptr<const LowLevelPlanner> HeuristicProvider::createPlanner(const std::shared_ptr<const LatticeGraph>& pGraph, LowLevelAlgorithm pAlgorithm)
+{
+    return makeLowLevelPlanner(pGraph, LatticeHeuristicFactory(), pAlgorithm);
+}
+std::shared_ptr<const LowLevelPlanner> HeuristicProvider::createPlanner(const std::shared_ptr<const BlockedGraph>& pGraph, LowLevelAlgorithm pAlgorithm)
+{
+    return makeLowLevelPlanner(pGraph, [this](const std::shared_ptr<const BlockedGraph>& pG, NodeId pTarget) {
+        return this->getHeuristic(pG->getGraph(), pTarget);
+    }, pAlgorithm);
+}
+void HeuristicProvider::prepare(const std::shared_ptr<const CompactGraph>&, const std::vector<NodeId>&)
+{
+
+}
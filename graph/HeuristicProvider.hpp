@@ -0,0 +1,86 @@
+/**
+ * @file HeuristicProvider.hpp
+ * @author Lennart Hustermeier (lennart.hustermeier@gmx.de)
+ * @brief Contains the interface of heuristics which are evaluated on node IDs of compact graphs
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include "CompactGraph.hpp"
+#include <functional>
+#include <memory>
+
+class BlockedGraph;
+class LatticeGraph;
+class LowLevelPlanner;
+enum LowLevelAlgorithm : int;
+
+/**
+ * @brief A source of heuristics for A*: For a graph and a target node it provides a function which estimates the costs from any
+ * node to that target. Implementations may precompute data per graph and per target, the returned function only needs to stay
+ * valid as long as the provider and the graph are alive.
+ */
+class HeuristicProvider
+{
+public:
+    /**
+     * @brief Destroys the heuristic provider
+     */
+    virtual ~HeuristicProvider() = default;
+
+    /**
+     * @brief Returns a heuristic which estimates the costs from a node to pTarget
+     *
+     * @param pGraph The graph in which the search takes place
+     * @param pTarget The target node of the search
+     * @return std::function<double(NodeId)> The heuristic; Returns infinity for nodes from which pTarget can not be reached
+     */
+    virtual std::function<double(NodeId)> getHeuristic(const std::shared_ptr<const CompactGraph>& pGraph, NodeId pTarget) = 0;
+
+    /**
+     * @brief Creates a low level planner which runs pAlgorithm on pGraph with the heuristics of this provider. The default
+     * implementation calls the heuristic returned by getHeuristic() through std::function; Providers override it to hand their
+     * heuristic to the search with its concrete type. The provider has to outlive the planner.
+     *
+     * @param pGraph The graph to plan on
+     * @param pAlgorithm The low level search to run
+     * @return std::shared_ptr<const LowLevelPlanner> The planner
+     */
+    virtual std::shared_ptr<const LowLevelPlanner> createPlanner(const std::shared_ptr<const CompactGraph>& pGraph, LowLevelAlgorithm pAlgorithm);
+
+    /**
+     * @brief Creates a low level planner which runs pAlgorithm on an implicit lattice with the heuristics of this provider. The
+     * default implementation uses the arithmetic distance estimate of the lattice; Providers which can calculate their data on
+     * lattices override it. The provider has to outlive the planner.
+     *
+     * @param pGraph The lattice to plan on
+     * @param pAlgorithm The low level search to run
+     * @return std::shared_ptr<const LowLevelPlanner> The planner
+     */
+    virtual std::shared_ptr<const LowLevelPlanner> createPlanner(const std::shared_ptr<const LatticeGraph>& pGraph, LowLevelAlgorithm pAlgorithm);
+
+    /**
+     * @brief Creates a low level planner which runs pAlgorithm on an obstacle layer; Obstacles only make paths longer, so the
+     * default implementation uses the heuristics of the graph below the layer through std::function. The provider has to outlive
+     * the planner.
+     *
+     * @param pGraph The obstacle layer to plan on
+     * @param pAlgorithm The low level search to run
+     * @return std::shared_ptr<const LowLevelPlanner> The planner
+     */
+    virtual std::shared_ptr<const LowLevelPlanner> createPlanner(const std::shared_ptr<const BlockedGraph>& pGraph, LowLevelAlgorithm pAlgorithm);
+
+    /**
+     * @brief Announces the targets which will be requested next, so a provider can precompute their data in one go; The default
+     * implementation does nothing
+     *
+     * @param pGraph The graph in which the searches will take place
+     * @param pTargets The target nodes
+     */
+    virtual void prepare(const std::shared_ptr<const CompactGraph>& pGraph, const std::vector<NodeId>& pTargets);
+};
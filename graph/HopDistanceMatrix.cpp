@@ -0,0 +1,139 @@
+/**
+ * @file HopDistanceMatrix.cpp
+ * @author Lennart Hustermeier (lennart.hustermeier@gmx.de)
+ * @brief Contains the bit-parallel multi-source BFS on compact graphs
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "HopDistanceMatrix.hpp"
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+
+HopDistanceMatrix::HopDistanceMatrix(std::shared_ptr<const CompactGraph> pGraph, const std::vector<NodeId>& pSources, bool pBackward)
+: graph(pGraph), sources(pSources), backward(pBackward), hops(pSources.size() * pGraph->getNodeCount(), UNREACHABLE)
+{
+
+}
+HopDistanceMatrix HopDistanceMatrix::compute(std::shared_ptr<const CompactGraph> pGraph, const std::vector<NodeId>& pSources, const std::vector<bool>& pBlocked, bool pBackward)
+{
+    HopDistanceMatrix result(pGraph, pSources, pBackward);
+    const size_t nodeCount = pGraph->getNodeCount();
+
+    /*Bit i of a word belongs to the i-th source of the current batch*/
+    std::vector<uint64_t> visited(nodeCount);
+    std::vector<uint64_t> frontier(nodeCount, 0);
+    std::vector<uint64_t> next(nodeCount, 0);
+    std::vector<NodeId> current;
+    std::vector<NodeId> reached;
+
+    for(size_t batch = 0; batch < pSources.size(); batch += 64)
+    {
+        const size_t batchSize = std::min<size_t>(64, pSources.size() - batch);
+        std::fill(visited.begin(), visited.end(), 0);
+        current.clear();
+
+        for(size_t i = 0; i < batchSize; i++)
+        {
+            const NodeId s = pSources[batch + i];
+            if(s >= nodeCount || (!pBlocked.empty() && pBlocked[s]))
+            {
+                continue;
+            }
+            if(frontier[s] == 0)
+            {
+                current.push_back(s);
+            }
+            visited[s] |= uint64_t(1) << i;
+            frontier[s] |= uint64_t(1) << i;
+            result.hops[(batch + i) * nodeCount + s] = 0;
+        }
+
+        uint32_t level = 0;
+        while(!current.empty())
+        {
+            level++;
+
+            /*Push the frontier bits of every active node to its neighbours; Bits which already reached a node are dropped*/
+            for(NodeId u : current)
+            {
+                const uint64_t bits = frontier[u];
+                frontier[u] = 0;
+                for(NodeId v : pBackward ? pGraph->getIncoming(u) : pGraph->getOutgoing(u))
+                {
+                    const uint64_t newBits = bits & ~visited[v];
+                    if(newBits == 0 || (!pBlocked.empty() && pBlocked[v]))
+                    {
+                        continue;
+                    }
+                    if(next[v] == 0)
+                    {
+                        reached.push_back(v);
+                    }
+                    next[v] |= newBits;
+                }
+            }
+
+            /*Every bit which arrived at a node for the first time fixes the hops of that node for its source*/
+            for(NodeId v : reached)
+            {
+                uint64_t bits = next[v];
+                next[v] = 0;
+                visited[v] |= bits;
+                frontier[v] = bits;
+                while(bits != 0)
+                {
+                    const int i = std::countr_zero(bits);
+                    bits &= bits - 1;
+                    result.hops[(batch + i) * nodeCount + v] = level;
+                }
+            }
+            current.swap(reached);
+            reached.clear();
+        }
+    }
+    return result;
+}
+size_t HopDistanceMatrix::getSourceCount() const
+{
+    return this->sources.size();
+}
+NodeId HopDistanceMatrix::getSource(size_t pSourceIndex) const
+{
+    return this->sources.at(pSourceIndex);
+}
+uint32_t HopDistanceMatrix::getHops(size_t pSourceIndex, NodeId pNode) const
+{
+    if(pSourceIndex >= this->sources.size() || pNode >= this->graph->getNodeCount())
+    {
+        throw(std::out_of_range("HopDistanceMatrix::getHops(): The source or the node does not exist!"));
+    }
+    return this->hops[pSourceIndex * this->graph->getNodeCount() + pNode];
+}
+std::span<const uint32_t> HopDistanceMatrix::getRow(size_t pSourceIndex) const
+{
+    if(pSourceIndex >= this->sources.size())
+    {
+        throw(std::out_of_range("HopDistanceMatrix::getRow(): The source does not exist!"));
+    }
+    const size_t nodeCount = this->graph->getNodeCount();
+    return std::span<const uint32_t>(this->hops.data() + pSourceIndex * nodeCount, nodeCount);
+}
+std::vector<double> HopDistanceMatrix::getDistances(size_t pSourceIndex, double pWeight) const
+{
+    std::span<const uint32_t> row = this->getRow(pSourceIndex);
+    std::vector<double> result(row.size());
+    for(size_t n = 0; n < row.size(); n++)
+    {
+        result[n] = row[n] == UNREACHABLE ? std::numeric_limits<double>::infinity() : row[n] * pWeight;
+    }
+    return result;
+}
+const CompactGraph& HopDistanceMatrix::getGraph() const
+{
+    return *this->graph;
+}
@@ -0,0 +1,118 @@
+/**
+ * @file HopDistanceMatrix.hpp
+ * @author Lennart Hustermeier (lennart.hustermeier@gmx.de)
+ * @brief Contains the distances in hops from many source nodes to all nodes, calculated by a bit-parallel multi-source BFS
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include "CompactGraph.hpp"
+#include <memory>
+
+/**
+ * @brief The number of edges on the shortest paths from a list of source nodes to all nodes of a CompactGraph. The sources are
+ * searched in batches of 64 by a bit-parallel BFS: Every node stores a 64 bit word of the sources which have already reached it,
+ * so a single pass over the edges advances the frontiers of all sources of a batch at once. On graphs in which all edges have the
+ * same weight the hops times that weight are the exact distances.
+ */
+class HopDistanceMatrix
+{
+public:
+    /**
+     * @brief Marks a node which can not be reached from a source
+     */
+    static constexpr uint32_t UNREACHABLE = std::numeric_limits<uint32_t>::max();
+
+    /**
+     * @brief Runs the multi-source BFS on a compact graph
+     *
+     * @param pGraph The graph to search in
+     * @param pSources The source nodes; Invalid or blocked sources reach no node at all
+     * @param pBlocked Nodes which can not be entered (indexed by node ID); May be empty if there are no obstacles
+     * @param pBackward If true, the search follows the incoming edges; The hops are then counted from every node to the source
+     * @return HopDistanceMatrix The hops of every node for every source
+     */
+    static HopDistanceMatrix compute(std::shared_ptr<const CompactGraph> pGraph, const std::vector<NodeId>& pSources, const std::vector<bool>& pBlocked=std::vector<bool>(), bool pBackward=false);
+
+    /**
+     * @brief Returns the number of sources (rows of the matrix)
+     *
+     * @return size_t Number of sources
+     */
+    size_t getSourceCount() const;
+
+    /**
+     * @brief Returns a source node
+     *
+     * @param pSourceIndex The index of the source in the list passed to compute()
+     * @return NodeId The source node
+     */
+    NodeId getSource(size_t pSourceIndex) const;
+
+    /**
+     * @brief Returns the number of hops between a source and a node
+     *
+     * @param pSourceIndex The index of the source in the list passed to compute()
+     * @param pNode The node
+     * @return uint32_t The number of hops or UNREACHABLE
+     */
+    uint32_t getHops(size_t pSourceIndex, NodeId pNode) const;
+
+    /**
+     * @brief Returns the hops of all nodes for one source
+     *
+     * @param pSourceIndex The index of the source in the list passed to compute()
+     * @return std::span<const uint32_t> The hops indexed by node ID
+     */
+    std::span<const uint32_t> getRow(size_t pSourceIndex) const;
+
+    /**
+     * @brief Returns the distances of all nodes for one source, assuming every edge costs pWeight
+     *
+     * @param pSourceIndex The index of the source in the list passed to compute()
+     * @param pWeight The weight of every edge (see CompactGraph::getUniformWeight())
+     * @return std::vector<double> The distances indexed by node ID (infinity if the node can not be reached)
+     */
+    std::vector<double> getDistances(size_t pSourceIndex, double pWeight) const;
+
+    /**
+     * @brief Returns the graph which was searched
+     *
+     * @return const CompactGraph& The graph
+     */
+    const CompactGraph& getGraph() const;
+protected:
+    /**
+     * @brief Constructs a matrix in which no source reaches any node
+     *
+     * @param pGraph The graph of the search
+     * @param pSources The source nodes
+     * @param pBackward true for a search along the incoming edges
+     */
+    HopDistanceMatrix(std::shared_ptr<const CompactGraph> pGraph, const std::vector<NodeId>& pSources, bool pBackward);
+
+    /**
+     * @brief The graph of the search; Kept alive to be able to translate node IDs
+     */
+    std::shared_ptr<const CompactGraph> graph;
+
+    /**
+     * @brief The source nodes
+     */
+    std::vector<NodeId> sources;
+
+    /**
+     * @brief Stores if the search followed the incoming edges
+     */
+    bool backward;
+
+    /**
+     * @brief The hops as row-major matrix <source index> x <node ID>
+     */
+    std::vector<uint32_t> hops;
+};
@@ -0,0 +1,268 @@
+/**
+ * @file IncrementalSearch.cpp
+ * @author Lennart Hustermeier (lennart.hustermeier@gmx.de)
+ * @brief Contains the implementation of Lifelong Planning A* and D* Lite
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "IncrementalSearch.hpp"
+#include "graph.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+IncrementalSearch::IncrementalSearch(std::shared_ptr<const CompactGraph> pGraph, NodeId pRoot, NodeId pGoal, std::function<double(NodeId, NodeId)> pH, bool pBackward)
+: graph(pGraph), root(pRoot), goal(pGoal), heuristic(pH), backward(pBackward), keyModifier(0.0), expansions(0)
+{
+    const size_t nodeCount = this->graph->getNodeCount();
+    if(this->root >= nodeCount || this->goal >= nodeCount)
+    {
+        throw(std::out_of_range("IncrementalSearch::IncrementalSearch(): The start or the target node is not part of the graph!"));
+    }
+    this->g.assign(nodeCount, std::numeric_limits<double>::infinity());
+    this->rhs.assign(nodeCount, std::numeric_limits<double>::infinity());
+    this->blocked.assign(nodeCount, false);
+
+    /*Initially only the root is inconsistent*/
+    this->rhs[this->root] = 0.0;
+    this->open.push(this->root, this->calculateKey(this->root));
+}
+void IncrementalSearch::setNodeBlocked(NodeId pNode, bool pBlocked)
+{
+    if(this->blocked[pNode] == pBlocked)
+    {
+        return;
+    }
+    this->blocked[pNode] = pBlocked;
+
+    /*All edges of the node changed*/
+    this->updateNode(pNode);
+    this->forEachSuccessor(pNode, [this](NodeId n) { this->updateNode(n); });
+}
+bool IncrementalSearch::isNodeBlocked(NodeId pNode) const
+{
+    return this->blocked[pNode];
+}
+void IncrementalSearch::setEdgeWeight(NodeId pFrom, NodeId pTo, double pWeight)
+{
+    std::optional<double> baseWeight = this->graph->getWeight(pFrom, pTo);
+    if(!baseWeight.has_value())
+    {
+        throw(std::out_of_range("IncrementalSearch::setEdgeWeight(): The edge is not part of the compact graph!"));
+    }
+    if(pWeight == baseWeight.value())
+    {
+        this->weights.erase((static_cast<uint64_t>(pFrom) << 32) | pTo);
+    }
+    else
+    {
+        this->weights[(static_cast<uint64_t>(pFrom) << 32) | pTo] = pWeight;
+    }
+
+    /*Only the node at the far end of the edge (in search direction) depends on its weight*/
+    this->updateNode(this->backward ? pFrom : pTo);
+}
+double IncrementalSearch::getEdgeWeight(NodeId pFrom, NodeId pTo) const
+{
+    std::optional<double> baseWeight = this->graph->getWeight(pFrom, pTo);
+    if(!baseWeight.has_value())
+    {
+        return std::numeric_limits<double>::infinity();
+    }
+    return this->getCurrentWeight(pFrom, pTo, baseWeight.value());
+}
+bool IncrementalSearch::update(const Graph& pGraph)
+{
+    std::shared_ptr<const BlockedGraph> layer = pGraph.getBlockedGraph();
+    const std::shared_ptr<const CompactGraph>& compact = layer->getGraph();
+    const size_t nodeCount = this->graph->getNodeCount();
+    if(compact != this->followedGraph)
+    {
+        /*The graph rebuilt its compact graph (or is followed for the first time) -> match the nodes by name*/
+        std::vector<NodeId> ids(nodeCount, CompactGraph::INVALID_NODE);
+        size_t nodes = 0;
+        size_t edges = 0;
+        for(NodeId n=0; n<nodeCount; n++)
+        {
+            ids[n] = compact == this->graph ? n : compact->getNodeId(this->graph->getNodeName(n));
+            nodes += ids[n] != CompactGraph::INVALID_NODE;
+        }
+        for(NodeId n=0; n<nodeCount; n++)
+        {
+            for(NodeId t : this->graph->getOutgoing(n))
+            {
+                edges += ids[n] != CompactGraph::INVALID_NODE && ids[t] != CompactGraph::INVALID_NODE && compact->getWeight(ids[n], ids[t]).has_value();
+            }
+        }
+        if(nodes != compact->getNodeCount() || edges != compact->getEdgeCount())
+        {
+            /*Nodes or edges were added*/
+            return false;
+        }
+        this->followedGraph = compact;
+        this->followedIds = std::move(ids);
+    }
+
+    for(NodeId n=0; n<nodeCount; n++)
+    {
+        const NodeId id = this->followedIds[n];
+        this->setNodeBlocked(n, id == CompactGraph::INVALID_NODE || layer->isBlocked(id));
+    }
+    for(NodeId n=0; n<nodeCount; n++)
+    {
+        std::span<const NodeId> targets = this->graph->getOutgoing(n);
+        std::span<const double> baseWeights = this->graph->getOutgoingWeights(n);
+        for(size_t i=0; i<targets.size(); i++)
+        {
+            const NodeId from = this->followedIds[n];
+            const NodeId to = this->followedIds[targets[i]];
+            double weight = std::numeric_limits<double>::infinity();
+            if(from != CompactGraph::INVALID_NODE && to != CompactGraph::INVALID_NODE && !layer->isEdgeBlocked(from, to))
+            {
+                weight = compact->getWeight(from, to).value_or(weight);
+            }
+
+            /*Only edges whose weight changed since the last update make nodes inconsistent*/
+            std::unordered_map<uint64_t, double>::const_iterator current = this->weights.find((static_cast<uint64_t>(n) << 32) | targets[i]);
+            if(weight != (current == this->weights.end() ? baseWeights[i] : current->second))
+            {
+                this->setEdgeWeight(n, targets[i], weight);
+            }
+        }
+    }
+    return true;
+}
+std::vector<NodeId> IncrementalSearch::getPath()
+{
+    this->computeShortestPath();
+    if(this->g[this->goal] == std::numeric_limits<double>::infinity())
+    {
+        return std::vector<NodeId>();
+    }
+
+    /*Follow the best predecessors (in search direction) from the goal to the root*/
+    std::vector<NodeId> result;
+    result.push_back(this->goal);
+    NodeId current = this->goal;
+    while(current != this->root && result.size() <= this->g.size())
+    {
+        NodeId best = CompactGraph::INVALID_NODE;
+        double bestCosts = std::numeric_limits<double>::infinity();
+        this->forEachPredecessor(current, [&](NodeId n, double pWeight) {
+            if(pWeight + this->g[n] < bestCosts)
+            {
+                bestCosts = pWeight + this->g[n];
+                best = n;
+            }
+        });
+        if(best == CompactGraph::INVALID_NODE)
+        {
+            return std::vector<NodeId>();
+        }
+        result.push_back(best);
+        current = best;
+    }
+
+    if(!this->backward)
+    {
+        /*The forward search reconstructs the path from the target to the start*/
+        std::reverse(result.begin(), result.end());
+    }
+    return result;
+}
+double IncrementalSearch::getPathCost()
+{
+    this->computeShortestPath();
+    return this->g[this->goal];
+}
+size_t IncrementalSearch::getExpansions() const
+{
+    return this->expansions;
+}
+const std::shared_ptr<const CompactGraph>& IncrementalSearch::getGraph() const
+{
+    return this->graph;
+}
+double IncrementalSearch::estimate(NodeId pNode) const
+{
+    return this->backward ? this->heuristic(this->goal, pNode) : this->heuristic(pNode, this->goal);
+}
+IncrementalSearch::Key IncrementalSearch::calculateKey(NodeId pNode) const
+{
+    double d = std::min(this->g[pNode], this->rhs[pNode]);
+    return Key{d + this->estimate(pNode) + this->keyModifier, d};
+}
+void IncrementalSearch::updateNode(NodeId pNode)
+{
+    if(pNode != this->root)
+    {
+        double best = std::numeric_limits<double>::infinity();
+        this->forEachPredecessor(pNode, [&](NodeId n, double pWeight) {
+            best = std::min(best, pWeight + this->g[n]);
+        });
+        this->rhs[pNode] = best;
+    }
+
+    if(this->open.contains(pNode))
+    {
+        this->open.erase(pNode);
+    }
+    if(this->g[pNode] != this->rhs[pNode])
+    {
+        this->open.push(pNode, this->calculateKey(pNode));
+    }
+}
+void IncrementalSearch::computeShortestPath()
+{
+    while(!this->open.empty() && (this->open.topKey() < this->calculateKey(this->goal) || this->rhs[this->goal] != this->g[this->goal]))
+    {
+        const NodeId u = this->open.top();
+        const Key newKey = this->calculateKey(u);
+        if(this->open.topKey() < newKey)
+        {
+            /*The key is outdated as the goal moved*/
+            this->open.update(u, newKey);
+            continue;
+        }
+
+        this->open.pop();
+        this->expansions++;
+        if(this->g[u] > this->rhs[u])
+        {
+            /*Overconsistent: The distance decreased and is final now*/
+            this->g[u] = this->rhs[u];
+        }
+        else
+        {
+            /*Underconsistent: The distance increased, so u and its dependent nodes have to be recalculated*/
+            this->g[u] = std::numeric_limits<double>::infinity();
+            this->updateNode(u);
+        }
+        this->forEachSuccessor(u, [this](NodeId n) { this->updateNode(n); });
+    }
+}
+
+LifelongPlanningAStar::LifelongPlanningAStar(std::shared_ptr<const CompactGraph> pGraph, NodeId pStart, NodeId pTarget, std::function<double(NodeId, NodeId)> pH)
+: IncrementalSearch(pGraph, pStart, pTarget, pH, false)
+{
+
+}
+
+DStarLite::DStarLite(std::shared_ptr<const CompactGraph> pGraph, NodeId pStart, NodeId pTarget, std::function<double(NodeId, NodeId)> pH)
+: IncrementalSearch(pGraph, pTarget, pStart, pH, true)
+{
+
+}
+void DStarLite::moveStart(NodeId pStart)
+{
+    if(pStart >= this->g.size())
+    {
+        throw(std::out_of_range("DStarLite::moveStart(): The node is not part of the graph!"));
+    }
+    /*All keys shrink by at most h(<old start>, <new start>); Instead of updating them, new keys are raised by that amount*/
+    this->keyModifier += this->heuristic(this->goal, pStart);
+    this->goal = pStart;
+}
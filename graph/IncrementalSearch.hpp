@@ -0,0 +1,322 @@
+/**
+ * @file IncrementalSearch.hpp
+ * @author Lennart Hustermeier (lennart.hustermeier@gmx.de)
+ * @brief Contains incremental shortest path searches (Lifelong Planning A* and D* Lite) which repair their result after graph edits
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include "CompactGraph.hpp"
+#include "IndexedHeap.hpp"
+#include <functional>
+#include <limits>
+#include <memory>
+#include <unordered_map>
+
+class Graph;
+
+/**
+ * @brief The common part of LPA* and D* Lite: Every node stores its distance to the root of the search (g) and a one-step
+ * lookahead value (rhs); Only nodes whose values differ ("inconsistent" nodes) are (re-)expanded. When edges change, only the nodes
+ * whose distance is affected become inconsistent, so the next search repairs the affected region instead of starting over.
+ *
+ * The search works on a fixed CompactGraph; Edits (e.g. an obstacle or a node which was removed from the Graph) are applied to the
+ * search as blocked nodes and changed edge weights, either by hand or by update() which takes them from the Graph the compact graph
+ * was created from. Edges and nodes which are not part of the compact graph can not be added.
+ */
+class IncrementalSearch
+{
+public:
+    /**
+     * @brief Blocks or unblocks a node; A blocked node can neither be entered nor left (e.g. after Graph::removeNode())
+     *
+     * @param pNode The node
+     * @param pBlocked true to block the node, false to unblock it
+     */
+    void setNodeBlocked(NodeId pNode, bool pBlocked);
+
+    /**
+     * @brief Returns if a node is blocked
+     *
+     * @param pNode The node
+     * @return true The node is blocked
+     * @return false The node can be used
+     */
+    bool isNodeBlocked(NodeId pNode) const;
+
+    /**
+     * @brief Changes the weight of an edge of the compact graph
+     *
+     * @param pFrom The start node of the edge
+     * @param pTo The end node of the edge
+     * @param pWeight The new weight; Infinity removes the edge (e.g. after Graph::removeEdge())
+     */
+    void setEdgeWeight(NodeId pFrom, NodeId pTo, double pWeight);
+
+    /**
+     * @brief Returns the current weight of an edge
+     *
+     * @param pFrom The start node of the edge
+     * @param pTo The end node of the edge
+     * @return double The weight of the edge; Infinity if the edge was removed or one of its nodes is blocked
+     */
+    double getEdgeWeight(NodeId pFrom, NodeId pTo) const;
+
+    /**
+     * @brief Takes over all edits of a graph since the compact graph of the search was created from it: Obstacles of the blocked
+     * graph layer (Graph::setBlocked(), Graph::setEdgeBlocked()) and nodes and edges removed by Graph::removeNode() and
+     * Graph::removeEdge() block the corresponding nodes and edges of the search, changed weights are taken over. Nodes are matched
+     * by name, so the search keeps working after the graph rebuilt its compact graph. Replaces all edits made by hand.
+     *
+     * Only the nodes whose edges changed become inconsistent, but every call compares all edges of the compact graph.
+     *
+     * @param pGraph The graph
+     * @return true The search follows the current state of pGraph
+     * @return false pGraph contains nodes or edges the search does not know; The search is unchanged and has to be recreated
+     */
+    bool update(const Graph& pGraph);
+
+    /**
+     * @brief Searches or repairs the shortest path and returns it
+     *
+     * @return std::vector<NodeId> The shortest path from the start node to the target node or an empty vector if there is none
+     */
+    std::vector<NodeId> getPath();
+
+    /**
+     * @brief Searches or repairs the shortest path and returns its costs
+     *
+     * @return double The costs of the shortest path (infinity if there is none)
+     */
+    double getPathCost();
+
+    /**
+     * @brief Returns the number of node expansions since the construction of the search
+     *
+     * @return size_t Number of expansions
+     */
+    size_t getExpansions() const;
+
+    /**
+     * @brief Returns the graph the search operates on
+     *
+     * @return const std::shared_ptr<const CompactGraph>& The graph
+     */
+    const std::shared_ptr<const CompactGraph>& getGraph() const;
+protected:
+    /**
+     * @brief The priority of an inconsistent node
+     */
+    struct Key
+    {
+        double k1;
+        double k2;
+
+        bool operator<(const Key& pOther) const
+        {
+            if(this->k1 != pOther.k1)
+            {
+                return this->k1 < pOther.k1;
+            }
+            return this->k2 < pOther.k2;
+        }
+    };
+
+    /**
+     * @brief Constructs a new search; Nothing is searched until the path is requested
+     *
+     * @param pGraph The graph to search in
+     * @param pRoot The node the distances are calculated from (LPA*: start node, D* Lite: target node)
+     * @param pGoal The node the path is extracted for (LPA*: target node, D* Lite: start node)
+     * @param pH Estimated costs from the first to the second node; Has to be consistent
+     * @param pBackward If true, the search follows the edges backwards, so the distances are the costs to pRoot
+     */
+    IncrementalSearch(std::shared_ptr<const CompactGraph> pGraph, NodeId pRoot, NodeId pGoal, std::function<double(NodeId, NodeId)> pH, bool pBackward);
+
+    /**
+     * @brief Returns the estimated costs between pNode and the goal in search direction
+     *
+     * @param pNode The node
+     * @return double The estimate
+     */
+    double estimate(NodeId pNode) const;
+
+    /**
+     * @brief Calculates the priority of a node
+     *
+     * @param pNode The node
+     * @return Key The priority
+     */
+    Key calculateKey(NodeId pNode) const;
+
+    /**
+     * @brief Recalculates the rhs value of a node and updates its membership in the open list
+     *
+     * @param pNode The node
+     */
+    void updateNode(NodeId pNode);
+
+    /**
+     * @brief Expands inconsistent nodes until the distance of the goal is final
+     */
+    void computeShortestPath();
+
+    /**
+     * @brief Returns the current weight of an edge of the compact graph
+     *
+     * @param pFrom The start node of the edge
+     * @param pTo The end node of the edge
+     * @param pBaseWeight The weight of the edge in the compact graph
+     * @return double The weight after all edits
+     */
+    double getCurrentWeight(NodeId pFrom, NodeId pTo, double pBaseWeight) const
+    {
+        if(this->blocked[pFrom] || this->blocked[pTo])
+        {
+            return std::numeric_limits<double>::infinity();
+        }
+        if(!this->weights.empty())
+        {
+            std::unordered_map<uint64_t, double>::const_iterator w = this->weights.find((static_cast<uint64_t>(pFrom) << 32) | pTo);
+            if(w != this->weights.end())
+            {
+                return w->second;
+            }
+        }
+        return pBaseWeight;
+    }
+
+    /**
+     * @brief Calls pCallback(<neighbour>) for all neighbours whose rhs value depends on pNode
+     */
+    template<class Callback> void forEachSuccessor(NodeId pNode, Callback&& pCallback) const
+    {
+        for(NodeId n : this->backward ? this->graph->getIncoming(pNode) : this->graph->getOutgoing(pNode))
+        {
+            pCallback(n);
+        }
+    }
+
+    /**
+     * @brief Calls pCallback(<neighbour>, <weight>) for all neighbours the rhs value of pNode depends on
+     */
+    template<class Callback> void forEachPredecessor(NodeId pNode, Callback&& pCallback) const
+    {
+        std::span<const NodeId> nodes = this->backward ? this->graph->getOutgoing(pNode) : this->graph->getIncoming(pNode);
+        std::span<const double> baseWeights = this->backward ? this->graph->getOutgoingWeights(pNode) : this->graph->getIncomingWeights(pNode);
+        for(size_t i = 0; i < nodes.size(); i++)
+        {
+            pCallback(nodes[i], this->backward ? this->getCurrentWeight(pNode, nodes[i], baseWeights[i]) : this->getCurrentWeight(nodes[i], pNode, baseWeights[i]));
+        }
+    }
+
+    /**
+     * @brief The graph to search in
+     */
+    std::shared_ptr<const CompactGraph> graph;
+
+    /**
+     * @brief The root and the goal of the search
+     */
+    NodeId root;
+    NodeId goal;
+
+    /**
+     * @brief The heuristic
+     */
+    std::function<double(NodeId, NodeId)> heuristic;
+
+    /**
+     * @brief The search direction
+     */
+    bool backward;
+
+    /**
+     * @brief Offset of all keys; Increased instead of reordering the open list when the goal moves (D* Lite)
+     */
+    double keyModifier;
+
+    /**
+     * @brief The distance from (or to) the root of every node
+     */
+    std::vector<double> g;
+
+    /**
+     * @brief The one-step lookahead distance of every node
+     */
+    std::vector<double> rhs;
+
+    /**
+     * @brief The blocked nodes
+     */
+    std::vector<bool> blocked;
+
+    /**
+     * @brief The changed edge weights (<from> << 32 | <to>) -> <weight>
+     */
+    std::unordered_map<uint64_t, double> weights;
+
+    /**
+     * @brief The compact graph of the Graph the search followed last (see update()) and the IDs of the nodes of the search in it
+     */
+    std::shared_ptr<const CompactGraph> followedGraph;
+    std::vector<NodeId> followedIds;
+
+    /**
+     * @brief The inconsistent nodes
+     */
+    IndexedHeap<Key> open;
+
+    /**
+     * @brief Counts the expansions
+     */
+    size_t expansions;
+};
+
+/**
+ * @brief Lifelong Planning A*: Repeatedly searches the shortest path between a fixed start and a fixed target node while the graph
+ * changes
+ */
+class LifelongPlanningAStar : public IncrementalSearch
+{
+public:
+    /**
+     * @brief Constructs a new search
+     *
+     * @param pGraph The graph to search in
+     * @param pStart The start node
+     * @param pTarget The target node
+     * @param pH Estimated costs from the first to the second node; Has to be consistent
+     */
+    LifelongPlanningAStar(std::shared_ptr<const CompactGraph> pGraph, NodeId pStart, NodeId pTarget, std::function<double(NodeId, NodeId)> pH=[](NodeId, NodeId){ return 0.0; });
+};
+
+/**
+ * @brief D* Lite: Repeatedly searches the shortest path from a moving start node (the position of an agent) to a fixed target node
+ * while the graph changes; The search runs from the target, so moving the start keeps all distances valid
+ */
+class DStarLite : public IncrementalSearch
+{
+public:
+    /**
+     * @brief Constructs a new search
+     *
+     * @param pGraph The graph to search in
+     * @param pStart The initial start node
+     * @param pTarget The target node
+     * @param pH Estimated costs from the first to the second node; Has to be consistent
+     */
+    DStarLite(std::shared_ptr<const CompactGraph> pGraph, NodeId pStart, NodeId pTarget, std::function<double(NodeId, NodeId)> pH=[](NodeId, NodeId){ return 0.0; });
+
+    /**
+     * @brief Moves the start node, e.g. after the agent made a step along the path
+     *
+     * @param pStart The new start node
+     */
+    void moveStart(NodeId pStart);
+};
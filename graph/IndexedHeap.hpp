@@ -0,0 +1,271 @@
+/**
+ * @file IndexedHeap.hpp
+ * @author Lennart Hustermeier (lennart.hustermeier@gmx.de)
+ * @brief Contains a binary heap which addresses its elements by handles and thus supports decrease-key operations
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory_resource>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief A binary min-heap over integer handles (e.g. state indices of a search). The position of every handle inside of the heap
+ * is tracked, so the key of an element can be decreased in O(log n) without searching for it.
+ *
+ * @tparam Key The type of the keys used to order the handles
+ * @tparam Compare A strict weak ordering on keys; The smallest element is on top
+ */
+template<class Key, class Compare=std::less<Key>>
+class IndexedHeap
+{
+public:
+    /**
+     * @brief Marks a handle which is not part of the heap
+     */
+    static constexpr uint32_t NOT_IN_HEAP = std::numeric_limits<uint32_t>::max();
+
+    /**
+     * @brief Creates an empty heap
+     *
+     * @param pResource The memory resource for the heap and the positions (e.g. a SearchArena)
+     */
+    IndexedHeap(std::pmr::memory_resource* pResource=std::pmr::get_default_resource())
+    : heap(pResource), positions(pResource)
+    {
+
+    }
+
+    /**
+     * @brief Checks if the heap is empty
+     *
+     * @return true There are no elements in the heap
+     * @return false There is at least one element in the heap
+     */
+    bool empty() const
+    {
+        return this->heap.empty();
+    }
+
+    /**
+     * @brief Returns the number of elements in the heap
+     *
+     * @return size_t Number of elements
+     */
+    size_t size() const
+    {
+        return this->heap.size();
+    }
+
+    /**
+     * @brief Checks if a handle is part of the heap
+     *
+     * @param pHandle The handle to check
+     * @return true The handle is in the heap
+     * @return false The handle is not in the heap
+     */
+    bool contains(uint32_t pHandle) const
+    {
+        return pHandle < this->positions.size() && this->positions[pHandle] != NOT_IN_HEAP;
+    }
+
+    /**
+     * @brief Inserts a handle which is not part of the heap yet
+     *
+     * @param pHandle The handle to insert
+     * @param pKey The key of the handle
+     */
+    void push(uint32_t pHandle, const Key& pKey)
+    {
+        if(pHandle >= this->positions.size())
+        {
+            this->positions.resize(pHandle + 1, NOT_IN_HEAP);
+        }
+        this->heap.emplace_back(pKey, pHandle);
+        this->positions[pHandle] = static_cast<uint32_t>(this->heap.size() - 1);
+        this->siftUp(this->heap.size() - 1);
+    }
+
+    /**
+     * @brief Decreases the key of a handle which is part of the heap
+     *
+     * @param pHandle The handle to update
+     * @param pKey The new key which must not be bigger than the current key
+     */
+    void decreaseKey(uint32_t pHandle, const Key& pKey)
+    {
+        uint32_t position = this->positions[pHandle];
+        this->heap[position].first = pKey;
+        this->siftUp(position);
+    }
+
+    /**
+     * @brief Changes the key of a handle which is part of the heap to an arbitrary value
+     *
+     * @param pHandle The handle to update
+     * @param pKey The new key
+     */
+    void update(uint32_t pHandle, const Key& pKey)
+    {
+        uint32_t position = this->positions[pHandle];
+        this->heap[position].first = pKey;
+        this->siftUp(position);
+        this->siftDown(this->positions[pHandle]);
+    }
+
+    /**
+     * @brief Removes a handle which is part of the heap
+     *
+     * @param pHandle The handle to remove
+     */
+    void erase(uint32_t pHandle)
+    {
+        uint32_t position = this->positions[pHandle];
+        this->positions[pHandle] = NOT_IN_HEAP;
+        if(position + 1 == this->heap.size())
+        {
+            this->heap.pop_back();
+            return;
+        }
+        this->heap[position] = std::move(this->heap.back());
+        this->heap.pop_back();
+        uint32_t moved = this->heap[position].second;
+        this->positions[moved] = position;
+        this->siftUp(position);
+        this->siftDown(this->positions[moved]);
+    }
+
+    /**
+     * @brief Returns the handle with the smallest key
+     *
+     * @return uint32_t The handle on top of the heap
+     */
+    uint32_t top() const
+    {
+        return this->heap.front().second;
+    }
+
+    /**
+     * @brief Returns the smallest key
+     *
+     * @return const Key& The key of the handle on top of the heap
+     */
+    const Key& topKey() const
+    {
+        return this->heap.front().first;
+    }
+
+    /**
+     * @brief Removes the handle with the smallest key from the heap and returns it
+     *
+     * @return uint32_t The removed handle
+     */
+    uint32_t pop()
+    {
+        uint32_t result = this->heap.front().second;
+        this->positions[result] = NOT_IN_HEAP;
+        if(this->heap.size() > 1)
+        {
+            this->heap.front() = std::move(this->heap.back());
+            this->positions[this->heap.front().second] = 0;
+            this->heap.pop_back();
+            this->siftDown(0);
+        }
+        else
+        {
+            this->heap.pop_back();
+        }
+        return result;
+    }
+
+    /**
+     * @brief Removes all elements from the heap while keeping the allocated memory
+     */
+    void clear()
+    {
+        for(const auto& e : this->heap)
+        {
+            this->positions[e.second] = NOT_IN_HEAP;
+        }
+        this->heap.clear();
+    }
+protected:
+    /**
+     * @brief Moves an element up until the heap property is restored
+     *
+     * @param pPosition The current position of the element
+     */
+    void siftUp(size_t pPosition)
+    {
+        std::pair<Key, uint32_t> element = std::move(this->heap[pPosition]);
+        while(pPosition > 0)
+        {
+            size_t parent = (pPosition - 1) / 2;
+            if(!this->compare(element.first, this->heap[parent].first))
+            {
+                break;
+            }
+            this->heap[pPosition] = std::move(this->heap[parent]);
+            this->positions[this->heap[pPosition].second] = static_cast<uint32_t>(pPosition);
+            pPosition = parent;
+        }
+        this->positions[element.second] = static_cast<uint32_t>(pPosition);
+        this->heap[pPosition] = std::move(element);
+    }
+
+    /**
+     * @brief Moves an element down until the heap property is restored
+     *
+     * @param pPosition The current position of the element
+     */
+    void siftDown(size_t pPosition)
+    {
+        std::pair<Key, uint32_t> element = std::move(this->heap[pPosition]);
+        const size_t count = this->heap.size();
+        while(true)
+        {
+            size_t child = 2 * pPosition + 1;
+            if(child >= count)
+            {
+                break;
+            }
+            if(child + 1 < count && this->compare(this->heap[child + 1].first, this->heap[child].first))
+            {
+                child++;
+            }
+            if(!this->compare(this->heap[child].first, element.first))
+            {
+                break;
+            }
+            this->heap[pPosition] = std::move(this->heap[child]);
+            this->positions[this->heap[pPosition].second] = static_cast<uint32_t>(pPosition);
+            pPosition = child;
+        }
+        this->positions[element.second] = static_cast<uint32_t>(pPosition);
+        this->heap[pPosition] = std::move(element);
+    }
+
+    /**
+     * @brief The heap as array of (<key>, <handle>)
+     */
+    std::pmr::vector<std::pair<Key, uint32_t>> heap;
+
+    /**
+     * @brief The position of every handle inside of heap (NOT_IN_HEAP if it is not part of the heap)
+     */
+    std::pmr::vector<uint32_t> positions;
+
+    /**
+     * @brief The comparison function
+     */
+    Compare compare;
+};
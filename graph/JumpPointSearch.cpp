@@ -0,0 +1,338 @@
+/**
+ * @file JumpPointSearch.cpp
+ * @author Lennart Hustermeier (lennart.hustermeier@gmx.de)
+ * @brief Contains the implementation of Jump Point Search on implicit lattices
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "JumpPointSearch.hpp"
+#include "BidirectionalSearch.hpp"
+#include "SearchArena.hpp"
+#include "SpaceTimeAStar.hpp"
+#include <algorithm>
+#include <limits>
+
+namespace
+{
+    /*The moves in +x, -x, +y and -y direction*/
+    constexpr int64_t DX[4] = {1, -1, 0, 0};
+    constexpr int64_t DY[4] = {0, 0, 1, -1};
+}
+
+LatticeJumpPointSearch::LatticeJumpPointSearch(const LatticeGraph& pGraph, std::pmr::memory_resource* pResource)
+: graph(pGraph), spikes(pGraph.hasSpikes()), target(LatticeGraph::INVALID_NODE), blocked(nullptr), horizon(0), window(0), stateIndex(pResource), stateNode(pResource),
+  stateTimestep(pResource), stateDirection(pResource), g(pResource), parent(pResource), closed(pResource), open(pResource), expansions(0)
+{
+
+}
+std::vector<NodeId> LatticeJumpPointSearch::findPath(NodeId pStart, NodeId pTarget, const std::vector<bool>& pBlocked)
+{
+    if(!this->canJump())
+    {
+        /*Spikes which are cheaper than the grid break the symmetry the pruning relies on*/
+        SearchArena::Scope scope;
+        LatticeBidirectionalSearch search(this->graph, scope.getResource());
+        return search.findPath(pStart, pTarget, [&](NodeId pNode) { return this->graph.getDistanceEstimate(pNode, pTarget); },
+                               [&](NodeId pNode) { return this->graph.getDistanceEstimate(pStart, pNode); }, pBlocked);
+    }
+    return this->search(pStart, pTarget, ReservationTable(), pBlocked, std::numeric_limits<unsigned int>::max() - 1);
+}
+std::vector<NodeId> LatticeJumpPointSearch::findPath(NodeId pStart, NodeId pTarget, const ReservationTable& pReservations, const std::vector<bool>& pBlocked, unsigned int pHorizon)
+{
+    if(!this->canJump())
+    {
+        SearchArena::Scope scope;
+        LatticeSpaceTimeAStar search(this->graph, scope.getResource());
+        return search.findPath(pStart, pTarget, [&](NodeId pNode) { return this->graph.getDistanceEstimate(pNode, pTarget); }, pBlocked, pReservations, pHorizon);
+    }
+    if(pHorizon == 0)
+    {
+        pHorizon = pReservations.getLastTimestep() + static_cast<unsigned int>(this->graph.getNodeCount());
+    }
+    return this->search(pStart, pTarget, pReservations, pBlocked, pHorizon);
+}
+size_t LatticeJumpPointSearch::getExpansions() const
+{
+    return this->expansions;
+}
+std::vector<NodeId> LatticeJumpPointSearch::search(NodeId pStart, NodeId pTarget, const ReservationTable& pReservations, const std::vector<bool>& pBlocked, unsigned int pHorizon)
+{
+    this->reset();
+
+    const size_t nodeCount = this->graph.getNodeCount();
+    if(pStart >= nodeCount || pTarget >= nodeCount || this->graph.isBlocked(pStart) || this->graph.isBlocked(pTarget) ||
+       (!pBlocked.empty() && (pBlocked[pStart] || pBlocked[pTarget])))
+    {
+        return std::vector<NodeId>();
+    }
+    this->target = pTarget;
+    this->blocked = &pBlocked;
+    this->horizon = pHorizon;
+
+    /*Reservations only restrict moves which arrive at a timestep up to the last reserved one; Before, single steps are expanded like
+    in the space-time A*, afterwards the grid is static again and the search jumps*/
+    this->window = pReservations.empty() ? 0 : pReservations.getLastTimestep();
+    const int64_t sizeX = this->graph.getSizeX();
+    const NodeId gridCount = static_cast<NodeId>(sizeX * this->graph.getSizeY());
+    std::optional<unsigned int> lastTargetConstraint = pReservations.getLastNodeReservation(pTarget);
+
+    uint32_t startState = this->getState(pStart, 0);
+    this->g[startState] = 0.0;
+    this->stateDirection[startState] = DIRECTION_NONE;
+    this->open.push(startState, Key{this->graph.getDistanceEstimate(pStart, pTarget), 0, pStart});
+
+    while(!this->open.empty())
+    {
+        uint32_t current = this->open.pop();
+        this->closed[current] = true;
+        this->expansions++;
+
+        const NodeId currentNode = this->stateNode[current];
+        const unsigned int currentTimestep = this->stateTimestep[current];
+        const double currentG = this->g[current];
+
+        if(currentNode == pTarget && (!lastTargetConstraint.has_value() || currentTimestep > lastTargetConstraint.value()))
+        {
+            /*Expand the jumps to one node per timestep*/
+            std::vector<NodeId> result;
+            for(uint32_t s = current; s != IndexedHeap<Key>::NOT_IN_HEAP; s = this->parent[s])
+            {
+                const NodeId n = this->stateNode[s];
+                result.push_back(n);
+                if(this->parent[s] == IndexedHeap<Key>::NOT_IN_HEAP)
+                {
+                    break;
+                }
+                const NodeId p = this->stateNode[this->parent[s]];
+                if(p >= gridCount || n >= gridCount)
+                {
+                    /*A single step from or to a spike*/
+                    continue;
+                }
+                if(p % sizeX != n % sizeX && p / sizeX != n / sizeX)
+                {
+                    /*A diagonal through the spike of the cell between both nodes*/
+                    result.push_back(this->graph.getNodeId(static_cast<uint32_t>(std::min(p % sizeX, n % sizeX)), static_cast<uint32_t>(std::min(p / sizeX, n / sizeX)), 1));
+                    continue;
+                }
+                const int64_t step = (p % sizeX == n % sizeX) ? (p > n ? sizeX : -sizeX) : (p > n ? 1 : -1);
+                for(int64_t i = static_cast<int64_t>(n) + step; i != static_cast<int64_t>(p); i += step)
+                {
+                    result.push_back(static_cast<NodeId>(i));
+                }
+            }
+            std::reverse(result.begin(), result.end());
+            return result;
+        }
+
+        auto relax = [&](NodeId pNext, unsigned int pSteps, double pCosts, uint8_t pDirection) {
+            const unsigned int nextTimestep = currentTimestep + pSteps;
+            const double tentativeG = currentG + pCosts;
+            const uint32_t successor = this->getState(pNext, nextTimestep);
+            if(this->closed[successor] || tentativeG >= this->g[successor])
+            {
+                return;
+            }
+            this->g[successor] = tentativeG;
+            this->parent[successor] = current;
+            this->stateTimestep[successor] = nextTimestep;
+            this->stateDirection[successor] = pDirection;
+            Key key{tentativeG + this->graph.getDistanceEstimate(pNext, pTarget), nextTimestep, pNext};
+            if(this->open.contains(successor))
+            {
+                this->open.decreaseKey(successor, key);
+            }
+            else
+            {
+                this->open.push(successor, key);
+            }
+        };
+
+        if(currentTimestep < this->window || currentNode >= gridCount)
+        {
+            /*Single steps (including those from and to spikes); The successor is a root of the jumps as the step may have been
+            restricted by a reservation respectively leads from a spike back to the grid*/
+            this->graph.forEachOutgoing(currentNode, [&](NodeId pNext, double pWeight) {
+                if(this->isFree(pNext) && currentTimestep + 1 <= this->horizon && pReservations.isMoveAllowed(currentNode, pNext, currentTimestep + 1))
+                {
+                    relax(pNext, 1, pWeight, DIRECTION_NONE);
+                }
+            });
+            continue;
+        }
+
+        /*Select the directions: Everything at a root of the jumps, else the canonical successors*/
+        const int64_t x = currentNode % sizeX;
+        const int64_t y = currentNode / sizeX;
+        bool directions[4] = {true, true, true, true};
+        const uint8_t arrival = this->stateDirection[current];
+        if(arrival != DIRECTION_NONE)
+        {
+            if(DX[arrival] != 0)
+            {
+                /*Horizontal: Continue or turn vertically*/
+                directions[arrival ^ 1] = false;
+            }
+            else
+            {
+                /*Vertical: Continue or turn horizontally if the horizontal move first was blocked (forced neighbour)*/
+                directions[0] = this->isFree(x + 1, y) && !this->isFree(x + 1, y - DY[arrival]);
+                directions[1] = this->isFree(x - 1, y) && !this->isFree(x - 1, y - DY[arrival]);
+                directions[arrival ^ 1] = false;
+            }
+        }
+
+        for(uint8_t d = 0; d < 4; d++)
+        {
+            if(!directions[d])
+            {
+                continue;
+            }
+            std::optional<Jump> j = this->jump(x, y, currentTimestep, d);
+            if(j.has_value())
+            {
+                relax(j->node, j->steps, j->steps * (DX[d] != 0 ? this->graph.getWeightX() : this->graph.getWeightY()), d);
+            }
+        }
+
+        if(this->spikes)
+        {
+            /*Leave the grid layer: Into the target spike or diagonally through a spike if both other corners of its cell are blocked*/
+            for(int64_t dx : {-1, 1})
+            {
+                for(int64_t dy : {-1, 1})
+                {
+                    const NodeId spike = this->getFreeSpike(x, y, dx, dy);
+                    if(spike == LatticeGraph::INVALID_NODE)
+                    {
+                        continue;
+                    }
+                    if(spike == pTarget && currentTimestep + 1 <= this->horizon)
+                    {
+                        relax(spike, 1, this->graph.getWeightSpike(), DIRECTION_NONE);
+                    }
+                    else if(this->isFree(x + dx, y + dy) && !this->isFree(x + dx, y) && !this->isFree(x, y + dy) && currentTimestep + 2 <= this->horizon)
+                    {
+                        relax(static_cast<NodeId>((y + dy) * sizeX + x + dx), 2, 2 * this->graph.getWeightSpike(), DIRECTION_NONE);
+                    }
+                }
+            }
+        }
+    }
+
+    return std::vector<NodeId>();
+}
+bool LatticeJumpPointSearch::canJump() const
+{
+    return !this->spikes || 2 * this->graph.getWeightSpike() >= this->graph.getWeightX() + this->graph.getWeightY();
+}
+bool LatticeJumpPointSearch::isFree(NodeId pNode) const
+{
+    return !this->graph.isBlocked(pNode) && (this->blocked->empty() || !(*this->blocked)[pNode]);
+}
+bool LatticeJumpPointSearch::isFree(int64_t pX, int64_t pY) const
+{
+    if(pX < 0 || pY < 0 || pX >= this->graph.getSizeX() || pY >= this->graph.getSizeY())
+    {
+        return false;
+    }
+    return this->isFree(static_cast<NodeId>(pY * this->graph.getSizeX() + pX));
+}
+NodeId LatticeJumpPointSearch::getFreeSpike(int64_t pX, int64_t pY, int64_t pDX, int64_t pDY) const
+{
+    const int64_t cellX = std::min(pX, pX + pDX);
+    const int64_t cellY = std::min(pY, pY + pDY);
+    if(cellX < 0 || cellY < 0)
+    {
+        return LatticeGraph::INVALID_NODE;
+    }
+    const NodeId spike = this->graph.getNodeId(static_cast<uint32_t>(cellX), static_cast<uint32_t>(cellY), 1);
+    return spike != LatticeGraph::INVALID_NODE && this->isFree(spike) ? spike : LatticeGraph::INVALID_NODE;
+}
+bool LatticeJumpPointSearch::isSpikeJumpPoint(int64_t pX, int64_t pY) const
+{
+    for(int64_t dx : {-1, 1})
+    {
+        for(int64_t dy : {-1, 1})
+        {
+            const NodeId spike = this->getFreeSpike(pX, pY, dx, dy);
+            if(spike != LatticeGraph::INVALID_NODE &&
+               (spike == this->target || (this->isFree(pX + dx, pY + dy) && !this->isFree(pX + dx, pY) && !this->isFree(pX, pY + dy))))
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+std::optional<LatticeJumpPointSearch::Jump> LatticeJumpPointSearch::jump(int64_t pX, int64_t pY, unsigned int pTimestep, uint8_t pDirection) const
+{
+    const int64_t sizeX = this->graph.getSizeX();
+    unsigned int steps = 0;
+    while(true)
+    {
+        pX += DX[pDirection];
+        pY += DY[pDirection];
+        pTimestep++;
+        steps++;
+        if(!this->isFree(pX, pY) || pTimestep > this->horizon)
+        {
+            return {};
+        }
+        const NodeId n = static_cast<NodeId>(pY * sizeX + pX);
+        if(n == this->target || (this->spikes && this->isSpikeJumpPoint(pX, pY)))
+        {
+            return Jump{n, steps};
+        }
+        if(DY[pDirection] != 0)
+        {
+            /*Moving vertically: Stop where the canonical path has to turn horizontally*/
+            if((this->isFree(pX + 1, pY) && !this->isFree(pX + 1, pY - DY[pDirection])) ||
+               (this->isFree(pX - 1, pY) && !this->isFree(pX - 1, pY - DY[pDirection])))
+            {
+                return Jump{n, steps};
+            }
+        }
+        else
+        {
+            /*Moving horizontally: Stop where a vertical jump finds a jump point*/
+            if(this->jump(pX, pY, pTimestep, 2).has_value() || this->jump(pX, pY, pTimestep, 3).has_value())
+            {
+                return Jump{n, steps};
+            }
+        }
+    }
+}
+uint32_t LatticeJumpPointSearch::getState(NodeId pNode, unsigned int pTimestep)
+{
+    /*After the last reservation all arrivals at a node are equivalent, the one with the lowest costs dominates the others*/
+    const unsigned int key = std::min(pTimestep, this->window);
+    uint64_t packed = (static_cast<uint64_t>(key) << 32) | pNode;
+    std::pair<std::pmr::unordered_map<uint64_t, uint32_t>::iterator, bool> inserted = this->stateIndex.try_emplace(packed, static_cast<uint32_t>(this->stateNode.size()));
+    if(inserted.second)
+    {
+        this->stateNode.push_back(pNode);
+        this->stateTimestep.push_back(pTimestep);
+        this->stateDirection.push_back(DIRECTION_NONE);
+        this->g.push_back(std::numeric_limits<double>::infinity());
+        this->parent.push_back(IndexedHeap<Key>::NOT_IN_HEAP);
+        this->closed.push_back(false);
+    }
+    return inserted.first->second;
+}
+void LatticeJumpPointSearch::reset()
+{
+    this->stateIndex.clear();
+    this->stateNode.clear();
+    this->stateTimestep.clear();
+    this->stateDirection.clear();
+    this->g.clear();
+    this->parent.clear();
+    this->closed.clear();
+    this->open.clear();
+    this->expansions = 0;
+}
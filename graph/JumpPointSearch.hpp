@@ -0,0 +1,220 @@
+/**
+ * @file JumpPointSearch.hpp
+ * @author Lennart Hustermeier (lennart.hustermeier@gmx.de)
+ * @brief Contains Jump Point Search on implicit lattices, without and with temporal constraints
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include "LatticeGraph.hpp"
+#include "IndexedHeap.hpp"
+#include "ReservationTable.hpp"
+#include <memory_resource>
+#include <optional>
+#include <unordered_map>
+
+/**
+ * @brief Jump Point Search for 4-connected grids: Out of all shortest paths which only differ in the order of their moves, only the
+ * canonical one is searched, which turns from a vertical into a horizontal move only if the horizontal move first is blocked. Instead
+ * of expanding every node, the search jumps along straight lines and only stops at nodes where the canonical path may turn (jump
+ * points). The costs of the paths are the same as with A*.
+ *
+ * With temporal constraints the symmetry only holds once no reservation can interfere anymore: Up to the last reserved timestep
+ * the search expands single steps like the space-time A*, every state reached that way is a root from which jumps start into all
+ * four directions. The result equals the space-time A* (no waits, the target is only accepted after its last reservation), the
+ * savings come from the (usually much longer) unconstrained remainder of the path.
+ *
+ * The pruning rules apply to the grid layer. A spike is a diagonal shortcut from a corner of its cell to the opposite one; If two
+ * spike edges cost at least as much as a step in x and one in y direction (as in the lattices of the GeometryModule), an optimal path
+ * only needs this shortcut when both other corners of the cell are blocked, and it only enters a spike to reach a spike target. The
+ * grid nodes where this can happen are jump points: Jumps stop there like at the target, and their expansion adds the diagonals
+ * through the spikes, whose far corners become roots of new jumps. A search starting on a spike steps down to its corners first.
+ * Spiked lattices with cheaper spike edges break the pruning and are searched with the plain bidirectional A* respectively the
+ * space-time A*, without any savings.
+ */
+class LatticeJumpPointSearch
+{
+public:
+    /**
+     * @brief Creates a new search on a lattice; The instance can be reused for multiple searches on the same lattice
+     *
+     * @param pGraph The lattice to search in
+     * @param pResource The memory resource for the per-search data (e.g. the SearchArena of the thread)
+     */
+    LatticeJumpPointSearch(const LatticeGraph& pGraph, std::pmr::memory_resource* pResource=std::pmr::get_default_resource());
+
+    /**
+     * @brief Searches a cost optimal path from pStart to pTarget which avoids the obstacles
+     *
+     * @param pStart The start node
+     * @param pTarget The target node
+     * @param pBlocked Additional nodes which shall not be entered (indexed by node ID); May be empty
+     * @return std::vector<NodeId> The path (including all nodes between the jump points) or an empty vector if there is no such path
+     */
+    std::vector<NodeId> findPath(NodeId pStart, NodeId pTarget, const std::vector<bool>& pBlocked=std::vector<bool>());
+
+    /**
+     * @brief Searches a cost optimal path from pStart to pTarget which respects the obstacles and the reservations; The path is only
+     * accepted if the agent is allowed to stay on the target after reaching it
+     *
+     * @param pStart The start node
+     * @param pTarget The target node
+     * @param pReservations The node and edge reservations which have to be respected
+     * @param pBlocked Additional nodes which shall not be entered (indexed by node ID); May be empty
+     * @param pHorizon The maximum timestep which will be searched; 0 selects <last reserved timestep> + <number of nodes>
+     * @return std::vector<NodeId> The path (one node per timestep) or an empty vector if there is no such path
+     */
+    std::vector<NodeId> findPath(NodeId pStart, NodeId pTarget, const ReservationTable& pReservations, const std::vector<bool>& pBlocked=std::vector<bool>(), unsigned int pHorizon=0);
+
+    /**
+     * @brief Returns the number of jump points expanded by the last search
+     *
+     * @return size_t Number of expansions
+     */
+    size_t getExpansions() const;
+protected:
+    /**
+     * @brief Moves in +x, -x, +y and -y direction and the marker for the start node
+     */
+    static constexpr uint8_t DIRECTION_NONE = 4;
+
+    /**
+     * @brief The key by which the open list is ordered: f-value first, then the timestep and the node for deterministic ties
+     */
+    struct Key
+    {
+        double f;
+        unsigned int timestep;
+        NodeId node;
+
+        bool operator<(const Key& pOther) const
+        {
+            if(this->f != pOther.f)
+            {
+                return this->f < pOther.f;
+            }
+            if(this->timestep != pOther.timestep)
+            {
+                return this->timestep < pOther.timestep;
+            }
+            return this->node < pOther.node;
+        }
+    };
+
+    /**
+     * @brief The result of a jump
+     */
+    struct Jump
+    {
+        NodeId node;
+        unsigned int steps;
+    };
+
+    /**
+     * @brief Runs the search on the grid layer; Without reservations the timesteps are irrelevant and all states of a node are merged
+     */
+    std::vector<NodeId> search(NodeId pStart, NodeId pTarget, const ReservationTable& pReservations, const std::vector<bool>& pBlocked, unsigned int pHorizon);
+
+    /**
+     * @brief Checks if the search can prune on this lattice, i.e. it has no spikes or the diagonals through them are never cheaper
+     * than the two steps along the grid
+     */
+    bool canJump() const;
+
+    /**
+     * @brief Checks if a node can be entered
+     */
+    bool isFree(NodeId pNode) const;
+
+    /**
+     * @brief Checks if the grid node at (pX, pY) exists and can be entered
+     */
+    bool isFree(int64_t pX, int64_t pY) const;
+
+    /**
+     * @brief Returns the free spike of the cell which lies between the grid node (pX, pY) and the opposite corner (pX + pDX, pY + pDY)
+     *
+     * @return NodeId The spike or INVALID_NODE if there is no such cell or its spike can not be entered
+     */
+    NodeId getFreeSpike(int64_t pX, int64_t pY, int64_t pDX, int64_t pDY) const;
+
+    /**
+     * @brief Checks if an optimal path may leave the grid layer at (pX, pY): It is a corner of the target spike or of a cell whose
+     * spike is the only connection to the opposite corner
+     */
+    bool isSpikeJumpPoint(int64_t pX, int64_t pY) const;
+
+    /**
+     * @brief Jumps from (pX, pY) at pTimestep into a direction until a jump point is reached
+     *
+     * @param pX The x coordinate to start at
+     * @param pY The y coordinate to start at
+     * @param pTimestep The timestep at (pX, pY)
+     * @param pDirection The direction of the jump
+     * @return std::optional<Jump> The jump point and the number of steps to it or an empty optional if the jump hits an obstacle,
+     * a reservation or the horizon
+     */
+    std::optional<Jump> jump(int64_t pX, int64_t pY, unsigned int pTimestep, uint8_t pDirection) const;
+
+    /**
+     * @brief Returns the index of the state (pNode, pTimestep), creating it if necessary
+     */
+    uint32_t getState(NodeId pNode, unsigned int pTimestep);
+
+    /**
+     * @brief Resets all per-search data while keeping the allocated memory
+     */
+    void reset();
+
+    /**
+     * @brief The lattice to search in
+     */
+    const LatticeGraph& graph;
+
+    /**
+     * @brief Stores if the lattice has spikes which the jumps have to consider
+     */
+    bool spikes;
+
+    /**
+     * @brief The parameters of the current search
+     */
+    NodeId target;
+    const std::vector<bool>* blocked;
+    unsigned int horizon;
+
+    /**
+     * @brief The last reserved timestep (0 without reservations); Up to it single steps are expanded, afterwards the search jumps
+     */
+    unsigned int window;
+
+    /**
+     * @brief Maps the packed state (<timestep> << 32 | <node>) to its index
+     */
+    std::pmr::unordered_map<uint64_t, uint32_t> stateIndex;
+
+    /**
+     * @brief The node, the timestep, the direction of arrival, the costs and the predecessor of every state
+     */
+    std::pmr::vector<NodeId> stateNode;
+    std::pmr::vector<unsigned int> stateTimestep;
+    std::pmr::vector<uint8_t> stateDirection;
+    std::pmr::vector<double> g;
+    std::pmr::vector<uint32_t> parent;
+    std::pmr::vector<bool> closed;
+
+    /**
+     * @brief The open list
+     */
+    IndexedHeap<Key> open;
+
+    /**
+     * @brief Counts the expansions of the last search
+     */
+    size_t expansions;
+};
@@ -0,0 +1,179 @@
+/**
+ * @file LandmarkHeuristic.cpp
+ * @author Lennart Hustermeier (lennart.hustermeier@gmx.de)
+ * @brief Contains the implementation of the ALT heuristic
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "LandmarkHeuristic.hpp"
+#include "LowLevelPlanner.hpp"
+#include "ShortestPathTree.hpp"
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <thread>
+
+LandmarkHeuristic::LandmarkHeuristic(unsigned int pLandmarkCount, unsigned int pMaxThreads)
+: landmarkCount(pLandmarkCount), maxThreads(pMaxThreads)
+{
+    if(this->maxThreads == 0)
+    {
+        this->maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+}
+double LandmarkHeuristic::Tables::estimate(NodeId pNode, NodeId pTarget) const
+{
+    constexpr double infinity = std::numeric_limits<double>::infinity();
+    const size_t k = this->landmarks.size();
+    const double* fromNode = this->fromLandmark.data() + pNode * k;
+    const double* fromTarget = this->fromLandmark.data() + pTarget * k;
+    const double* toNode = this->toLandmark.data() + pNode * k;
+    const double* toTarget = this->toLandmark.data() + pTarget * k;
+
+    double h = 0.0;
+    for(size_t i = 0; i < k; i++)
+    {
+        /*d(v, t) >= d(L, t) - d(L, v); If L reaches v but not t, v can not reach t either*/
+        if(fromTarget[i] != infinity)
+        {
+            if(fromNode[i] != infinity)
+            {
+                h = std::max(h, fromTarget[i] - fromNode[i]);
+            }
+        }
+        else if(fromNode[i] != infinity)
+        {
+            return infinity;
+        }
+
+        /*d(v, t) >= d(v, L) - d(t, L); If t reaches L but v does not, v can not reach t either*/
+        if(toTarget[i] != infinity)
+        {
+            if(toNode[i] != infinity)
+            {
+                h = std::max(h, toNode[i] - toTarget[i]);
+            }
+            else
+            {
+                return infinity;
+            }
+        }
+    }
+    return h;
+}
+std::shared_ptr<const LandmarkHeuristic::Tables> LandmarkHeuristic::computeTables(const std::shared_ptr<const CompactGraph>& pGraph) const
+{
+    std::shared_ptr<Tables> result = std::make_shared<Tables>();
+    const size_t nodeCount = pGraph->getNodeCount();
+    if(nodeCount == 0 || this->landmarkCount == 0)
+    {
+        return result;
+    }
+
+    /*Farthest point selection: Start at the node farthest away from node 0, then always add the node with the largest distance to
+    the closest landmark so far. Nodes which no landmark reaches are preferred, so every component gets a landmark.*/
+    std::vector<std::vector<double>> forward;
+    std::vector<double> closestLandmark(nodeCount, std::numeric_limits<double>::infinity());
+    std::vector<bool> isLandmark(nodeCount, false);
+    std::vector<double> initial = ShortestPathTree::compute(pGraph, 0).getDistances();
+    NodeId next = 0;
+    for(NodeId v = 0; v < nodeCount; v++)
+    {
+        if(initial[v] != std::numeric_limits<double>::infinity() && initial[v] > initial[next])
+        {
+            next = v;
+        }
+    }
+
+    while(result->landmarks.size() < this->landmarkCount)
+    {
+        result->landmarks.push_back(next);
+        isLandmark[next] = true;
+        forward.push_back(ShortestPathTree::compute(pGraph, next).getDistances());
+
+        const std::vector<double>& d = forward.back();
+        double farthest = 0.0;
+        next = CompactGraph::INVALID_NODE;
+        for(NodeId v = 0; v < nodeCount; v++)
+        {
+            closestLandmark[v] = std::min(closestLandmark[v], d[v]);
+            if(!isLandmark[v] && (next == CompactGraph::INVALID_NODE || closestLandmark[v] > farthest))
+            {
+                farthest = closestLandmark[v];
+                next = v;
+            }
+        }
+        if(next == CompactGraph::INVALID_NODE)
+        {
+            /*Every node is a landmark*/
+            break;
+        }
+    }
+
+    /*The backward searches are independent of each other and run in parallel*/
+    const size_t k = result->landmarks.size();
+    std::vector<std::vector<double>> backward(k);
+    std::atomic<size_t> nextLandmark(0);
+    std::vector<std::thread> threads;
+    for(unsigned int i = 0; i < std::min<size_t>(this->maxThreads, k); i++)
+    {
+        threads.push_back(std::thread([&]() {
+            for(size_t l = nextLandmark++; l < k; l = nextLandmark++)
+            {
+                backward[l] = ShortestPathTree::compute(pGraph, result->landmarks[l], std::vector<bool>(), CompactGraph::INVALID_NODE, true).getDistances();
+            }
+        }));
+    }
+    for(std::thread& t : threads)
+    {
+        t.join();
+    }
+
+    result->fromLandmark.resize(nodeCount * k);
+    result->toLandmark.resize(nodeCount * k);
+    for(size_t l = 0; l < k; l++)
+    {
+        for(NodeId v = 0; v < nodeCount; v++)
+        {
+            result->fromLandmark[v * k + l] = forward[l][v];
+            result->toLandmark[v * k + l] = backward[l][v];
+        }
+    }
+    return result;
+}
+std::shared_ptr<const LandmarkHeuristic::Tables> LandmarkHeuristic::getTables(const std::shared_ptr<const CompactGraph>& pGraph)
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if(this->graph != pGraph)
+    {
+        /*The graph changed -> select new landmarks*/
+        this->tables = this->computeTables(pGraph);
+        this->graph = pGraph;
+    }
+    return this->tables;
+}
+std::function<double(NodeId)> LandmarkHeuristic::getHeuristic(const std::shared_ptr<const CompactGraph>& pGraph, NodeId pTarget)
+{
+    std::shared_ptr<const Tables> t = this->getTables(pGraph);
+    if(pTarget >= pGraph->getNodeCount())
+    {
+        return [](NodeId) { return std::numeric_limits<double>::infinity(); };
+    }
+    return [t, pTarget](NodeId pNode) { return t->estimate(pNode, pTarget); };
+}
+std::shared_ptr<const LowLevelPlanner> LandmarkHeuristic::createPlanner(const std::shared_ptr<const CompactGraph>& pGraph, LowLevelAlgorithm pAlgorithm)
+{
+    return makeLowLevelPlanner(pGraph, [this](const std::shared_ptr<const CompactGraph>& pG, NodeId pTarget) {
+        /*The planner only passes valid targets*/
+        std::shared_ptr<const Tables> t = this->getTables(pG);
+        return [t, pTarget](NodeId pNode) { return t->estimate(pNode, pTarget); };
+    }, pAlgorithm);
+}
+std::vector<NodeId> LandmarkHeuristic::getLandmarks(const std::shared_ptr<const CompactGraph>& pGraph)
+{
+    return this->getTables(pGraph)->landmarks;
+}
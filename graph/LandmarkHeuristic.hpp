@@ -0,0 +1,137 @@
+/**
+ * @file LandmarkHeuristic.hpp
+ * @author Lennart Hustermeier (lennart.hustermeier@gmx.de)
+ * @brief Contains the ALT heuristic (A*, landmarks and the triangle inequality) for large graphs
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include "HeuristicProvider.hpp"
+#include <mutex>
+#include <vector>
+
+/**
+ * @brief Estimates distances using a small set of landmarks L and the triangle inequality:
+ * d(v, t) >= d(L, t) - d(L, v) and d(v, t) >= d(v, L) - d(t, L). The landmarks are selected by farthest point selection and the
+ * distances from and to every landmark are precomputed once per graph, so the memory is bounded by 2 * <landmarks> * <nodes>
+ * independent of the number of targets. The heuristic is admissible and consistent, also if obstacles are added later on.
+ * The provider can be used from multiple threads.
+ */
+class LandmarkHeuristic : public HeuristicProvider
+{
+public:
+    /**
+     * @brief Constructs a new landmark heuristic; The landmarks are selected on first use for a graph
+     *
+     * @param pLandmarkCount The number of landmarks to select (limited to the number of nodes)
+     * @param pMaxThreads The maximum number of threads used to precompute the landmark distances (0 -> hardware concurrency)
+     */
+    LandmarkHeuristic(unsigned int pLandmarkCount=16, unsigned int pMaxThreads=0);
+
+    /**
+     * @brief Returns a heuristic which estimates the costs to pTarget using the landmarks of pGraph
+     *
+     * @param pGraph The graph in which the search takes place
+     * @param pTarget The target node of the search
+     * @return std::function<double(NodeId)> The heuristic
+     */
+    std::function<double(NodeId)> getHeuristic(const std::shared_ptr<const CompactGraph>& pGraph, NodeId pTarget) override;
+
+    /**
+     * @brief Lattices are planned on with the arithmetic distance estimate of the provider base class
+     */
+    using HeuristicProvider::createPlanner;
+
+    /**
+     * @brief Creates a planner which evaluates the landmark tables directly instead of through std::function
+     *
+     * @param pGraph The graph to plan on
+     * @param pAlgorithm The low level search to run
+     * @return std::shared_ptr<const LowLevelPlanner> The planner
+     */
+    std::shared_ptr<const LowLevelPlanner> createPlanner(const std::shared_ptr<const CompactGraph>& pGraph, LowLevelAlgorithm pAlgorithm) override;
+
+    /**
+     * @brief Returns the selected landmarks for a graph, selecting them if necessary
+     *
+     * @param pGraph The graph to get the landmarks for
+     * @return std::vector<NodeId> The landmarks in the order of their selection
+     */
+    std::vector<NodeId> getLandmarks(const std::shared_ptr<const CompactGraph>& pGraph);
+protected:
+    /**
+     * @brief The precomputed distances of one graph; Stored node-major, so the values of one node lie next to each other
+     */
+    struct Tables
+    {
+        /**
+         * @brief The selected landmarks
+         */
+        std::vector<NodeId> landmarks;
+
+        /**
+         * @brief fromLandmark[<node> * <landmarks> + <i>] = d(landmarks[i], <node>)
+         */
+        std::vector<double> fromLandmark;
+
+        /**
+         * @brief toLandmark[<node> * <landmarks> + <i>] = d(<node>, landmarks[i])
+         */
+        std::vector<double> toLandmark;
+
+        /**
+         * @brief Calculates the lower bound of the distance from pNode to pTarget
+         *
+         * @param pNode The node to estimate the distance for
+         * @param pTarget The target node
+         * @return double The lower bound or infinity if the landmarks prove that pTarget can not be reached from pNode
+         */
+        double estimate(NodeId pNode, NodeId pTarget) const;
+    };
+
+    /**
+     * @brief Returns the tables for a graph, selecting the landmarks and computing the distances if the graph changed
+     *
+     * @param pGraph The graph to get the tables for
+     * @return std::shared_ptr<const Tables> The tables of pGraph
+     */
+    std::shared_ptr<const Tables> getTables(const std::shared_ptr<const CompactGraph>& pGraph);
+
+    /**
+     * @brief Selects the landmarks and computes the distances from and to them
+     *
+     * @param pGraph The graph to compute the tables for
+     * @return std::shared_ptr<const Tables> The new tables
+     */
+    std::shared_ptr<const Tables> computeTables(const std::shared_ptr<const CompactGraph>& pGraph) const;
+
+    /**
+     * @brief The number of landmarks to select
+     */
+    unsigned int landmarkCount;
+
+    /**
+     * @brief The maximum number of threads to use for the precomputation
+     */
+    unsigned int maxThreads;
+
+    /**
+     * @brief Protects the tables as the provider is shared between the threads of CBS
+     */
+    std::mutex mutex;
+
+    /**
+     * @brief The graph for which the tables were computed
+     */
+    std::shared_ptr<const CompactGraph> graph;
+
+    /**
+     * @brief The tables of graph
+     */
+    std::shared_ptr<const Tables> tables;
+};
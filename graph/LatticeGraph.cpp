@@ -0,0 +1,186 @@
+/**
+ * @file LatticeGraph.cpp
+ * @author Lennart Hustermeier (lennart.hustermeier@gmx.de)
+ * @brief Contains the implementation of the implicit lattice graph
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "LatticeGraph.hpp"
+#include <charconv>
+#include <stdexcept>
+
+LatticeGraph::LatticeGraph(uint32_t pSizeX, uint32_t pSizeY, bool pSpikes, double pWeightX, double pWeightY, double pWeightSpike)
+: sizeX(pSizeX), sizeY(pSizeY), spikes(pSpikes && pSizeX > 1 && pSizeY > 1), spikesX(0), spikesY(0), gridCount(pSizeX * pSizeY),
+  weightX(pWeightX), weightY(pWeightY), weightSpike(pWeightSpike)
+{
+    if(this->spikes)
+    {
+        this->spikesX = this->sizeX - 1;
+        this->spikesY = this->sizeY - 1;
+    }
+    this->blocked.assign((this->getNodeCount() + 63) / 64, 0);
+
+    /*A grid edge covers two half steps, a spike edge one half step in x and y direction; Scale the costs per half step down if
+    necessary, so no edge is cheaper than the estimated costs of the distance it covers*/
+    this->halfStepCostX = this->weightX / 2;
+    this->halfStepCostY = this->weightY / 2;
+    if(this->spikes && this->halfStepCostX + this->halfStepCostY > this->weightSpike)
+    {
+        double scale = this->weightSpike / (this->halfStepCostX + this->halfStepCostY);
+        this->halfStepCostX *= scale;
+        this->halfStepCostY *= scale;
+    }
+}
+size_t LatticeGraph::getNodeCount() const
+{
+    return static_cast<size_t>(this->gridCount) + static_cast<size_t>(this->spikesX) * this->spikesY;
+}
+uint32_t LatticeGraph::getSizeX() const
+{
+    return this->sizeX;
+}
+uint32_t LatticeGraph::getSizeY() const
+{
+    return this->sizeY;
+}
+bool LatticeGraph::hasSpikes() const
+{
+    return this->spikes;
+}
+double LatticeGraph::getWeightX() const
+{
+    return this->weightX;
+}
+double LatticeGraph::getWeightY() const
+{
+    return this->weightY;
+}
+double LatticeGraph::getWeightSpike() const
+{
+    return this->weightSpike;
+}
+NodeId LatticeGraph::getNodeId(uint32_t pX, uint32_t pY, uint32_t pZ) const
+{
+    if(pZ == 0 && pX < this->sizeX && pY < this->sizeY)
+    {
+        return pY * this->sizeX + pX;
+    }
+    if(pZ == 1 && pX < this->spikesX && pY < this->spikesY)
+    {
+        return this->gridCount + pY * this->spikesX + pX;
+    }
+    return INVALID_NODE;
+}
+NodeId LatticeGraph::getNodeId(const NodeType& pNode) const
+{
+    /*Parse "x,y,z" without allocations*/
+    uint32_t coordinates[3];
+    const char* current = pNode.data();
+    const char* end = pNode.data() + pNode.size();
+    for(unsigned int i = 0; i < 3; i++)
+    {
+        std::from_chars_result r = std::from_chars(current, end, coordinates[i]);
+        if(r.ec != std::errc() || (i < 2 && (r.ptr == end || *r.ptr != ',')) || (i == 2 && r.ptr != end))
+        {
+            return INVALID_NODE;
+        }
+        current = r.ptr + 1;
+    }
+    return this->getNodeId(coordinates[0], coordinates[1], coordinates[2]);
+}
+NodeType LatticeGraph::getNodeName(NodeId pNode) const
+{
+    std::tuple<uint32_t, uint32_t, uint32_t> p = this->getPosition(pNode);
+    return std::to_string(std::get<0>(p)) + "," + std::to_string(std::get<1>(p)) + "," + std::to_string(std::get<2>(p));
+}
+std::tuple<uint32_t, uint32_t, uint32_t> LatticeGraph::getPosition(NodeId pNode) const
+{
+    if(pNode < this->gridCount)
+    {
+        return std::make_tuple(pNode % this->sizeX, pNode / this->sizeX, 0u);
+    }
+    return std::make_tuple((pNode - this->gridCount) % this->spikesX, (pNode - this->gridCount) / this->spikesX, 1u);
+}
+std::optional<double> LatticeGraph::getWeight(NodeId pFrom, NodeId pTo) const
+{
+    if(pFrom >= this->getNodeCount() || pTo >= this->getNodeCount() || this->isBlocked(pFrom))
+    {
+        return {};
+    }
+    std::optional<double> result;
+    this->forEachOutgoing(pFrom, [&](NodeId pTarget, double pWeight) {
+        if(pTarget == pTo)
+        {
+            result = pWeight;
+        }
+    });
+    return result;
+}
+double LatticeGraph::getPathCost(const std::vector<NodeId>& pPath) const
+{
+    double sum = 0.0;
+    size_t cntr;
+    for(cntr = 1; cntr < pPath.size(); cntr++)
+    {
+        std::optional<double> w = this->getWeight(pPath[cntr - 1], pPath[cntr]);
+        if(!w.has_value())
+        {
+            throw(std::out_of_range("LatticeGraph::getPathCost(): The path contains an edge which is not part of the lattice!"));
+        }
+        sum += w.value();
+    }
+    return sum;
+}
+void LatticeGraph::setBlocked(NodeId pNode, bool pBlocked)
+{
+    if(pBlocked)
+    {
+        this->blocked[pNode >> 6] |= (1ULL << (pNode & 63));
+    }
+    else
+    {
+        this->blocked[pNode >> 6] &= ~(1ULL << (pNode & 63));
+    }
+}
+std::vector<NodeId> LatticeGraph::toNodeIds(const std::vector<NodeType>& pPath) const
+{
+    std::vector<NodeId> result;
+    result.reserve(pPath.size());
+    for(const NodeType& n : pPath)
+    {
+        result.push_back(this->getNodeId(n));
+    }
+    return result;
+}
+std::vector<NodeType> LatticeGraph::toNodeNames(const std::vector<NodeId>& pPath) const
+{
+    std::vector<NodeType> result;
+    result.reserve(pPath.size());
+    for(NodeId n : pPath)
+    {
+        result.push_back(this->getNodeName(n));
+    }
+    return result;
+}
+Graph LatticeGraph::toGraph() const
+{
+    std::set<NodeType> nodes;
+    std::set<std::tuple<NodeType, NodeType, double>> edges;
+    for(NodeId n = 0; n < this->getNodeCount(); n++)
+    {
+        if(this->isBlocked(n))
+        {
+            continue;
+        }
+        NodeType name = this->getNodeName(n);
+        nodes.insert(name);
+        this->forEachOutgoing(n, [&](NodeId pTarget, double pWeight) {
+            edges.insert(std::make_tuple(name, this->getNodeName(pTarget), pWeight));
+        });
+    }
+    return Graph(nodes, edges);
+}
@@ -0,0 +1,325 @@
+/**
+ * @file LatticeGraph.hpp
+ * @author Lennart Hustermeier (lennart.hustermeier@gmx.de)
+ * @brief Contains an implicit lattice graph whose edges are computed from the node coordinates instead of being stored
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include "graph.hpp"
+#include <cstdlib>
+#include <tuple>
+
+/**
+ * @brief The environment lattice as generated by the GeometryModule: A 4-connected grid of sizeX * sizeY nodes on layer z=0 and
+ * optionally a layer z=1 of "spikes", one in the center of every grid cell, which is connected to the four corners of its cell.
+ * Neither nodes nor edges are stored; Node IDs, names ("x,y,z") and neighbours are calculated from the coordinates. The only
+ * per-node storage is an obstacle bitset, blocked nodes can neither be entered nor left.
+ *
+ * Node IDs: Grid nodes come first in row major order (y * sizeX + x), followed by the spikes (y * (sizeX - 1) + x).
+ */
+class LatticeGraph
+{
+public:
+    /**
+     * @brief Marks an invalid node ID (same value as for compact graphs)
+     */
+    static constexpr NodeId INVALID_NODE = CompactGraph::INVALID_NODE;
+
+    /**
+     * @brief Constructs a new lattice without obstacles
+     *
+     * @param pSizeX The number of grid nodes in x direction
+     * @param pSizeY The number of grid nodes in y direction
+     * @param pSpikes If true, every grid cell gets a spike node on layer z=1
+     * @param pWeightX The weight of the edges in x direction
+     * @param pWeightY The weight of the edges in y direction
+     * @param pWeightSpike The weight of the edges between a spike and the corners of its cell
+     */
+    LatticeGraph(uint32_t pSizeX, uint32_t pSizeY, bool pSpikes, double pWeightX, double pWeightY, double pWeightSpike);
+
+    /**
+     * @brief Returns the number of nodes in the lattice (including blocked ones)
+     *
+     * @return size_t Number of nodes
+     */
+    size_t getNodeCount() const;
+
+    /**
+     * @brief Returns the number of grid nodes in x direction
+     *
+     * @return uint32_t Size in x direction
+     */
+    uint32_t getSizeX() const;
+
+    /**
+     * @brief Returns the number of grid nodes in y direction
+     *
+     * @return uint32_t Size in y direction
+     */
+    uint32_t getSizeY() const;
+
+    /**
+     * @brief Returns if the lattice contains the spike layer
+     *
+     * @return true There is a spike in every grid cell
+     * @return false There is only the grid layer
+     */
+    bool hasSpikes() const;
+
+    /**
+     * @brief Returns the costs of a step in x direction on the grid layer
+     *
+     * @return double The weight of the horizontal edges
+     */
+    double getWeightX() const;
+
+    /**
+     * @brief Returns the costs of a step in y direction on the grid layer
+     *
+     * @return double The weight of the vertical edges
+     */
+    double getWeightY() const;
+
+    /**
+     * @brief Returns the costs of a step between a spike and a corner of its cell
+     *
+     * @return double The weight of the spike edges
+     */
+    double getWeightSpike() const;
+
+    /**
+     * @brief Returns the ID of the node at the lattice coordinates (pX, pY, pZ)
+     *
+     * @param pX The x coordinate
+     * @param pY The y coordinate
+     * @param pZ The layer (0: grid, 1: spikes)
+     * @return NodeId The ID of the node or INVALID_NODE if the coordinates are outside of the lattice
+     */
+    NodeId getNodeId(uint32_t pX, uint32_t pY, uint32_t pZ) const;
+
+    /**
+     * @brief Returns the ID of a node
+     *
+     * @param pNode The name of the node ("x,y,z")
+     * @return NodeId The ID of the node or INVALID_NODE if the name does not belong to a node of the lattice
+     */
+    NodeId getNodeId(const NodeType& pNode) const;
+
+    /**
+     * @brief Returns the name of a node
+     *
+     * @param pNode The ID of the node (has to be valid)
+     * @return NodeType The name of the node ("x,y,z")
+     */
+    NodeType getNodeName(NodeId pNode) const;
+
+    /**
+     * @brief Returns the lattice coordinates of a node
+     *
+     * @param pNode The ID of the node (has to be valid)
+     * @return std::tuple<uint32_t, uint32_t, uint32_t> The coordinates (x, y, z)
+     */
+    std::tuple<uint32_t, uint32_t, uint32_t> getPosition(NodeId pNode) const;
+
+    /**
+     * @brief Calls pCallback(<target>, <weight>) for every outgoing edge of a node which leads to a node that is not blocked
+     *
+     * @tparam Callback Callable with the signature void(NodeId, double)
+     * @param pNode The node (has to be valid and not blocked)
+     * @param pCallback The callback to call for every edge
+     */
+    template<class Callback> void forEachOutgoing(NodeId pNode, Callback&& pCallback) const
+    {
+        if(pNode < this->gridCount)
+        {
+            const uint32_t x = pNode % this->sizeX;
+            const uint32_t y = pNode / this->sizeX;
+            this->visit(pNode - 1, x > 0, this->weightX, pCallback);
+            this->visit(pNode + 1, x + 1 < this->sizeX, this->weightX, pCallback);
+            this->visit(pNode - this->sizeX, y > 0, this->weightY, pCallback);
+            this->visit(pNode + this->sizeX, y + 1 < this->sizeY, this->weightY, pCallback);
+            if(this->spikes)
+            {
+                /*The spikes of the (up to) four cells which have this node as corner*/
+                const NodeId spike = this->gridCount + y * this->spikesX + x;
+                this->visit(spike - this->spikesX - 1, x > 0 && y > 0, this->weightSpike, pCallback);
+                this->visit(spike - this->spikesX, x < this->spikesX && y > 0, this->weightSpike, pCallback);
+                this->visit(spike - 1, x > 0 && y < this->spikesY, this->weightSpike, pCallback);
+                this->visit(spike, x < this->spikesX && y < this->spikesY, this->weightSpike, pCallback);
+            }
+        }
+        else
+        {
+            /*A spike is connected to the four corners of its cell*/
+            const uint32_t x = (pNode - this->gridCount) % this->spikesX;
+            const uint32_t y = (pNode - this->gridCount) / this->spikesX;
+            const NodeId corner = y * this->sizeX + x;
+            this->visit(corner, true, this->weightSpike, pCallback);
+            this->visit(corner + 1, true, this->weightSpike, pCallback);
+            this->visit(corner + this->sizeX, true, this->weightSpike, pCallback);
+            this->visit(corner + this->sizeX + 1, true, this->weightSpike, pCallback);
+        }
+    }
+
+    /**
+     * @brief Calls pCallback(<source>, <weight>) for every incoming edge of a node which comes from a node that is not blocked; As
+     * all lattice edges exist in both directions with the same weight, these are the outgoing edges
+     *
+     * @tparam Callback Callable with the signature void(NodeId, double)
+     * @param pNode The node (has to be valid and not blocked)
+     * @param pCallback The callback to call for every edge
+     */
+    template<class Callback> void forEachIncoming(NodeId pNode, Callback&& pCallback) const
+    {
+        this->forEachOutgoing(pNode, pCallback);
+    }
+
+    /**
+     * @brief Returns the weight of an edge
+     *
+     * @param pFrom The start node of the edge
+     * @param pTo The end node of the edge
+     * @return std::optional<double> The weight of the edge or an empty optional if there is no such edge (or one node is blocked)
+     */
+    std::optional<double> getWeight(NodeId pFrom, NodeId pTo) const;
+
+    /**
+     * @brief Returns the costs of a path in this lattice
+     *
+     * @param pPath The path as a vector of node IDs
+     * @return double The costs of the path; Throws std::out_of_range if two consecutive nodes are not connected by an edge
+     */
+    double getPathCost(const std::vector<NodeId>& pPath) const;
+
+    /**
+     * @brief Returns a lower bound of the costs from one node to another; The estimate is consistent and can thus be used as
+     * heuristic for A*
+     *
+     * @param pFrom The start node
+     * @param pTo The target node
+     * @return double A lower bound of the path costs
+     */
+    double getDistanceEstimate(NodeId pFrom, NodeId pTo) const
+    {
+        std::pair<int64_t, int64_t> from = this->getHalfStepPosition(pFrom);
+        std::pair<int64_t, int64_t> to = this->getHalfStepPosition(pTo);
+        return std::abs(from.first - to.first) * this->halfStepCostX + std::abs(from.second - to.second) * this->halfStepCostY;
+    }
+
+    /**
+     * @brief Blocks or unblocks a node
+     *
+     * @param pNode The node (has to be valid)
+     * @param pBlocked true to block the node, false to unblock it
+     */
+    void setBlocked(NodeId pNode, bool pBlocked);
+
+    /**
+     * @brief Returns if a node is blocked
+     *
+     * @param pNode The node (has to be valid)
+     * @return true The node is an obstacle
+     * @return false The node can be entered
+     */
+    bool isBlocked(NodeId pNode) const
+    {
+        return (this->blocked[pNode >> 6] >> (pNode & 63)) & 1;
+    }
+
+    /**
+     * @brief Translates a path of node names to node IDs
+     *
+     * @param pPath The path as vector of node names
+     * @return std::vector<NodeId> The path as vector of node IDs; Unknown nodes are translated to INVALID_NODE
+     */
+    std::vector<NodeId> toNodeIds(const std::vector<NodeType>& pPath) const;
+
+    /**
+     * @brief Translates a path of node IDs to node names
+     *
+     * @param pPath The path as vector of node IDs
+     * @return std::vector<NodeType> The path as vector of node names
+     */
+    std::vector<NodeType> toNodeNames(const std::vector<NodeId>& pPath) const;
+
+    /**
+     * @brief Materializes the lattice as an explicit Graph (without the blocked nodes), e.g. for algorithms which need node names
+     * and stored edges
+     *
+     * @return Graph The explicit graph
+     */
+    Graph toGraph() const;
+protected:
+    /**
+     * @brief Calls pCallback(pTarget, pWeight) if pValid is true and pTarget is not blocked
+     */
+    template<class Callback> void visit(NodeId pTarget, bool pValid, double pWeight, Callback& pCallback) const
+    {
+        if(pValid && !this->isBlocked(pTarget))
+        {
+            pCallback(pTarget, pWeight);
+        }
+    }
+
+    /**
+     * @brief Returns the position of a node in half grid steps (spikes lie in the center of their cell)
+     *
+     * @param pNode The node
+     * @return std::pair<int64_t, int64_t> The doubled x and y coordinates
+     */
+    std::pair<int64_t, int64_t> getHalfStepPosition(NodeId pNode) const
+    {
+        if(pNode < this->gridCount)
+        {
+            return std::make_pair(2 * static_cast<int64_t>(pNode % this->sizeX), 2 * static_cast<int64_t>(pNode / this->sizeX));
+        }
+        const NodeId spike = pNode - this->gridCount;
+        return std::make_pair(2 * static_cast<int64_t>(spike % this->spikesX) + 1, 2 * static_cast<int64_t>(spike / this->spikesX) + 1);
+    }
+
+    /**
+     * @brief The number of grid nodes in x and y direction
+     */
+    uint32_t sizeX;
+    uint32_t sizeY;
+
+    /**
+     * @brief Stores if there is a spike layer
+     */
+    bool spikes;
+
+    /**
+     * @brief The number of spikes in x and y direction (0 if there is no spike layer)
+     */
+    uint32_t spikesX;
+    uint32_t spikesY;
+
+    /**
+     * @brief The number of grid nodes (= ID of the first spike)
+     */
+    NodeId gridCount;
+
+    /**
+     * @brief The edge weights in x direction, in y direction and from/to spikes
+     */
+    double weightX;
+    double weightY;
+    double weightSpike;
+
+    /**
+     * @brief The lower bound of the costs per half grid step in x and y direction (used by getDistanceEstimate())
+     */
+    double halfStepCostX;
+    double halfStepCostY;
+
+    /**
+     * @brief One bit per node, set if the node is blocked
+     */
+    std::vector<uint64_t> blocked;
+};
@@ -0,0 +1,324 @@
+/**
+ * @file LatticeHierarchy.cpp
+ * @author Lennart Hustermeier (lennart.hustermeier@gmx.de)
+ * @brief Contains the implementation of hierarchical path finding on implicit lattices
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "LatticeHierarchy.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+SectorTree::SectorTree(const LatticeHierarchy& pHierarchy)
+: hierarchy(pHierarchy), distances(), parents(), touchedNodes(), open()
+{
+
+}
+void SectorTree::compute(NodeId pSource, NodeId pStop)
+{
+    const LatticeGraph& graph = this->hierarchy.getGraph();
+    if(this->distances.size() != graph.getNodeCount())
+    {
+        this->distances.assign(graph.getNodeCount(), std::numeric_limits<double>::infinity());
+        this->parents.assign(graph.getNodeCount(), LatticeGraph::INVALID_NODE);
+    }
+    for(NodeId n : this->touchedNodes)
+    {
+        this->distances[n] = std::numeric_limits<double>::infinity();
+        this->parents[n] = LatticeGraph::INVALID_NODE;
+    }
+    this->touchedNodes.clear();
+    this->open.clear();
+
+    const uint32_t sector = this->hierarchy.getSector(pSource);
+    this->distances[pSource] = 0.0;
+    this->touchedNodes.push_back(pSource);
+    this->open.push(pSource, 0.0);
+    while(!this->open.empty())
+    {
+        const NodeId current = this->open.pop();
+        if(current == pStop)
+        {
+            break;
+        }
+        const double distance = this->distances[current];
+        graph.forEachOutgoing(current, [&](NodeId pNext, double pWeight) {
+            if(this->hierarchy.getSector(pNext) != sector || distance + pWeight >= this->distances[pNext])
+            {
+                return;
+            }
+            if(this->distances[pNext] == std::numeric_limits<double>::infinity())
+            {
+                this->touchedNodes.push_back(pNext);
+            }
+            this->distances[pNext] = distance + pWeight;
+            this->parents[pNext] = current;
+            if(this->open.contains(pNext))
+            {
+                this->open.decreaseKey(pNext, distance + pWeight);
+            }
+            else
+            {
+                this->open.push(pNext, distance + pWeight);
+            }
+        });
+    }
+}
+void SectorTree::appendPath(NodeId pNode, std::vector<NodeId>& pPath, bool pReverse, bool pSkipFirst) const
+{
+    const size_t begin = pPath.size();
+    for(NodeId n = pNode; n != LatticeGraph::INVALID_NODE; n = this->parents[n])
+    {
+        pPath.push_back(n);
+    }
+    if(!pReverse)
+    {
+        std::reverse(pPath.begin() + begin, pPath.end());
+    }
+    if(pSkipFirst)
+    {
+        pPath.erase(pPath.begin() + begin);
+    }
+}
+
+LatticeHierarchy::LatticeHierarchy(std::shared_ptr<const LatticeGraph> pGraph, uint32_t pSectorSize)
+: graph(pGraph), sectorSize(pSectorSize), sectorsX(0), sectorsY(0), entrances(), sectorOffsets(), entranceIndices(), costs()
+{
+    if(this->sectorSize == 0)
+    {
+        throw(std::invalid_argument("LatticeHierarchy::LatticeHierarchy(): The sector size has to be at least 1!"));
+    }
+    this->sectorsX = (this->graph->getSizeX() + this->sectorSize - 1) / this->sectorSize;
+    this->sectorsY = (this->graph->getSizeY() + this->sectorSize - 1) / this->sectorSize;
+
+    /*Sort the entrances by sector, so the entrances of a sector are a contiguous range*/
+    const size_t nodeCount = this->graph->getNodeCount();
+    std::vector<std::vector<NodeId>> sectorEntrances(this->getSectorCount());
+    for(NodeId n = 0; n < nodeCount; n++)
+    {
+        if(this->isEntrance(n))
+        {
+            sectorEntrances[this->getSector(n)].push_back(n);
+        }
+    }
+    this->entranceIndices.assign(nodeCount, INVALID_INDEX);
+    this->sectorOffsets.push_back(0);
+    for(const std::vector<NodeId>& sector : sectorEntrances)
+    {
+        for(NodeId n : sector)
+        {
+            this->entranceIndices[n] = static_cast<uint32_t>(this->entrances.size());
+            this->entrances.push_back(n);
+        }
+        this->sectorOffsets.push_back(static_cast<uint32_t>(this->entrances.size()));
+    }
+
+    this->costs.resize(this->getSectorCount());
+    SectorTree tree(*this);
+    for(uint32_t s = 0; s < this->getSectorCount(); s++)
+    {
+        this->buildSector(s, tree);
+    }
+}
+const LatticeGraph& LatticeHierarchy::getGraph() const
+{
+    return *this->graph;
+}
+uint32_t LatticeHierarchy::getSectorSize() const
+{
+    return this->sectorSize;
+}
+size_t LatticeHierarchy::getSectorCount() const
+{
+    return static_cast<size_t>(this->sectorsX) * this->sectorsY;
+}
+size_t LatticeHierarchy::getEntranceCount() const
+{
+    return this->entrances.size();
+}
+std::span<const NodeId> LatticeHierarchy::getEntrances(uint32_t pSector) const
+{
+    return std::span<const NodeId>(this->entrances.data() + this->sectorOffsets[pSector], this->sectorOffsets[pSector + 1] - this->sectorOffsets[pSector]);
+}
+void LatticeHierarchy::updateNode(NodeId pNode)
+{
+    /*Paths between sectors only use the lattice edges at the node itself, which are evaluated during the search*/
+    this->rebuildSector(this->getSector(pNode));
+}
+void LatticeHierarchy::rebuildSector(uint32_t pSector)
+{
+    SectorTree tree(*this);
+    this->buildSector(pSector, tree);
+}
+void LatticeHierarchy::buildSector(uint32_t pSector, SectorTree& pTree)
+{
+    std::span<const NodeId> sectorEntrances = this->getEntrances(pSector);
+    const size_t count = sectorEntrances.size();
+    std::vector<double>& matrix = this->costs[pSector];
+    matrix.assign(count * count, std::numeric_limits<double>::infinity());
+    for(size_t i = 0; i < count; i++)
+    {
+        if(this->graph->isBlocked(sectorEntrances[i]))
+        {
+            continue;
+        }
+        pTree.compute(sectorEntrances[i]);
+        for(size_t j = 0; j < count; j++)
+        {
+            if(!this->graph->isBlocked(sectorEntrances[j]))
+            {
+                matrix[i * count + j] = pTree.getDistance(sectorEntrances[j]);
+            }
+        }
+    }
+}
+bool LatticeHierarchy::isEntrance(NodeId pNode) const
+{
+    const auto [x, y, z] = this->graph->getPosition(pNode);
+    if(z == 1)
+    {
+        /*The corners (x+1, *) and (*, y+1) of a spike may belong to the next sector*/
+        return (x + 1) % this->sectorSize == 0 || (y + 1) % this->sectorSize == 0;
+    }
+    /*The edges to the spikes of the cells (x-1, *) and (*, y-1) only leave the sector if the grid edges do*/
+    return (x > 0 && x % this->sectorSize == 0) || (x + 1 < this->graph->getSizeX() && (x + 1) % this->sectorSize == 0) ||
+           (y > 0 && y % this->sectorSize == 0) || (y + 1 < this->graph->getSizeY() && (y + 1) % this->sectorSize == 0);
+}
+
+HierarchicalSearch::HierarchicalSearch(const LatticeHierarchy& pHierarchy)
+: hierarchy(pHierarchy), startTree(pHierarchy), targetTree(pHierarchy), refineTree(pHierarchy),
+  g(pHierarchy.getEntranceCount(), std::numeric_limits<double>::infinity()),
+  parents(pHierarchy.getEntranceCount(), LatticeHierarchy::INVALID_INDEX), closed(pHierarchy.getEntranceCount(), false),
+  touchedEntrances(), open(), goalParent(LatticeHierarchy::INVALID_INDEX), expansions(0)
+{
+
+}
+std::vector<NodeId> HierarchicalSearch::findPath(NodeId pStart, NodeId pTarget)
+{
+    if(this->search(pStart, pTarget) == std::numeric_limits<double>::infinity())
+    {
+        return std::vector<NodeId>();
+    }
+    std::vector<NodeId> result;
+    if(this->goalParent == LatticeHierarchy::INVALID_INDEX)
+    {
+        /*The path stays inside of the start sector*/
+        this->startTree.appendPath(pTarget, result, false, false);
+        return result;
+    }
+
+    std::vector<uint32_t> abstractPath;
+    for(uint32_t e = this->goalParent; e != LatticeHierarchy::INVALID_INDEX; e = this->parents[e])
+    {
+        abstractPath.push_back(e);
+    }
+    std::reverse(abstractPath.begin(), abstractPath.end());
+
+    /*Start -> first entrance, then edges between entrances, finally last entrance -> target*/
+    this->startTree.appendPath(this->hierarchy.getEntranceNode(abstractPath.front()), result, false, false);
+    for(size_t i = 1; i < abstractPath.size(); i++)
+    {
+        const NodeId from = this->hierarchy.getEntranceNode(abstractPath[i - 1]);
+        const NodeId to = this->hierarchy.getEntranceNode(abstractPath[i]);
+        if(this->hierarchy.getSector(from) == this->hierarchy.getSector(to))
+        {
+            this->refineTree.compute(from, to);
+            this->refineTree.appendPath(to, result, false, true);
+        }
+        else
+        {
+            result.push_back(to);
+        }
+    }
+    this->targetTree.appendPath(this->hierarchy.getEntranceNode(abstractPath.back()), result, true, true);
+    return result;
+}
+double HierarchicalSearch::getDistance(NodeId pStart, NodeId pTarget)
+{
+    return this->search(pStart, pTarget);
+}
+size_t HierarchicalSearch::getExpansions() const
+{
+    return this->expansions;
+}
+double HierarchicalSearch::search(NodeId pStart, NodeId pTarget)
+{
+    this->reset();
+
+    const LatticeGraph& graph = this->hierarchy.getGraph();
+    if(pStart >= graph.getNodeCount() || pTarget >= graph.getNodeCount() || graph.isBlocked(pStart) || graph.isBlocked(pTarget))
+    {
+        return std::numeric_limits<double>::infinity();
+    }
+
+    /*Connect start and target to the entrances of their sectors*/
+    this->startTree.compute(pStart);
+    this->targetTree.compute(pTarget);
+    const uint32_t startSector = this->hierarchy.getSector(pStart);
+    const uint32_t targetSector = this->hierarchy.getSector(pTarget);
+    double best = startSector == targetSector ? this->startTree.getDistance(pTarget) : std::numeric_limits<double>::infinity();
+
+    auto touch = [&](uint32_t pEntrance, double pG, uint32_t pParent) {
+        if(this->g[pEntrance] == std::numeric_limits<double>::infinity())
+        {
+            this->touchedEntrances.push_back(pEntrance);
+        }
+        this->g[pEntrance] = pG;
+        this->parents[pEntrance] = pParent;
+        const double f = pG + graph.getDistanceEstimate(this->hierarchy.getEntranceNode(pEntrance), pTarget);
+        if(this->open.contains(pEntrance))
+        {
+            this->open.decreaseKey(pEntrance, f);
+        }
+        else
+        {
+            this->open.push(pEntrance, f);
+        }
+    };
+    for(NodeId n : this->hierarchy.getEntrances(startSector))
+    {
+        if(this->startTree.getDistance(n) != std::numeric_limits<double>::infinity())
+        {
+            touch(this->hierarchy.getEntranceIndex(n), this->startTree.getDistance(n), LatticeHierarchy::INVALID_INDEX);
+        }
+    }
+
+    /*The lattice estimate is consistent and the abstract edges are shortest paths, so the estimate is also consistent on the abstract
+    graph; Leaving an entrance of the target sector towards the target is the (virtual) goal edge*/
+    while(!this->open.empty() && this->open.topKey() < best)
+    {
+        const uint32_t current = this->open.pop();
+        this->closed[current] = true;
+        this->expansions++;
+        const NodeId node = this->hierarchy.getEntranceNode(current);
+        if(this->hierarchy.getSector(node) == targetSector && this->g[current] + this->targetTree.getDistance(node) < best)
+        {
+            best = this->g[current] + this->targetTree.getDistance(node);
+            this->goalParent = current;
+        }
+        this->hierarchy.forEachAbstractEdge(current, [&](uint32_t pNext, double pCost) {
+            if(!this->closed[pNext] && this->g[current] + pCost < this->g[pNext])
+            {
+                touch(pNext, this->g[current] + pCost, current);
+            }
+        });
+    }
+    return best;
+}
+void HierarchicalSearch::reset()
+{
+    for(uint32_t e : this->touchedEntrances)
+    {
+        this->g[e] = std::numeric_limits<double>::infinity();
+        this->parents[e] = LatticeHierarchy::INVALID_INDEX;
+        this->closed[e] = false;
+    }
+    this->touchedEntrances.clear();
+    this->open.clear();
+    this->goalParent = LatticeHierarchy::INVALID_INDEX;
+    this->expansions = 0;
+}
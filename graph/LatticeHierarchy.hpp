@@ -0,0 +1,399 @@
+/**
+ * @file LatticeHierarchy.hpp
+ * @author Lennart Hustermeier (lennart.hustermeier@gmx.de)
+ * @brief Contains hierarchical path finding (HPA*) on implicit lattices: An abstract graph of sector entrances which is searched
+ * before the path is refined inside of the sectors
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include "LatticeGraph.hpp"
+#include "IndexedHeap.hpp"
+#include <memory>
+#include <span>
+
+class LatticeHierarchy;
+
+/**
+ * @brief A Dijkstra search which does not leave the sector of its source node; Used to calculate the costs between the entrances
+ * of a sector and to connect start and target nodes to the abstract graph. The instance can be reused and only resets the nodes
+ * touched by the previous search.
+ */
+class SectorTree
+{
+public:
+    /**
+     * @brief Creates a new search on the lattice of a hierarchy
+     *
+     * @param pHierarchy The hierarchy defining the lattice and its sectors
+     */
+    SectorTree(const LatticeHierarchy& pHierarchy);
+
+    /**
+     * @brief Calculates the costs from pSource to the nodes of its sector; Only paths which stay inside of the sector are considered
+     *
+     * @param pSource The source node (has to be valid and not blocked)
+     * @param pStop The search ends as soon as the costs of this node are final; INVALID_NODE searches the whole sector
+     */
+    void compute(NodeId pSource, NodeId pStop=LatticeGraph::INVALID_NODE);
+
+    /**
+     * @brief Returns the costs from the source to a node
+     *
+     * @param pNode The node
+     * @return double The costs; Infinity if the node can not be reached inside of the sector. With a stop node only the costs of
+     * the nodes settled before it are final
+     */
+    double getDistance(NodeId pNode) const
+    {
+        return pNode < this->distances.size() ? this->distances[pNode] : std::numeric_limits<double>::infinity();
+    }
+
+    /**
+     * @brief Appends the path from the source to a reached node to a vector
+     *
+     * @param pNode The last node of the path
+     * @param pPath The vector to append the path to
+     * @param pReverse If true, the path from pNode to the source is appended (lattice edges are symmetric)
+     * @param pSkipFirst If true, the first node of the appended path is left out (it is already the last node of pPath)
+     */
+    void appendPath(NodeId pNode, std::vector<NodeId>& pPath, bool pReverse, bool pSkipFirst) const;
+protected:
+    /**
+     * @brief The hierarchy defining the lattice and its sectors
+     */
+    const LatticeHierarchy& hierarchy;
+
+    /**
+     * @brief The costs from the source and the predecessor of every node (indexed by node ID)
+     */
+    std::vector<double> distances;
+    std::vector<NodeId> parents;
+
+    /**
+     * @brief The nodes which were touched by the current search
+     */
+    std::vector<NodeId> touchedNodes;
+
+    /**
+     * @brief The open list
+     */
+    IndexedHeap<double> open;
+};
+
+/**
+ * @brief The abstract graph of hierarchical path finding (HPA*): The lattice is clustered into square sectors of
+ * <sector size> x <sector size> grid cells, a spike belongs to the sector of its cell. Every node with a lattice edge into another
+ * sector is an entrance; For every sector the costs between all pairs of its entrances are precomputed (paths inside of the sector
+ * only). The abstract graph consists of the entrances, these intra-sector edges and the lattice edges between sectors.
+ *
+ * As all boundary nodes are entrances, the shortest abstract path has the same costs as the shortest path in the lattice. The
+ * entrances only depend on the coordinates, obstacles only change the intra-sector costs; After a node was blocked or unblocked,
+ * updateNode() rebuilds the costs of its sector and nothing else.
+ *
+ * The hierarchy is searched with HierarchicalSearch; It is not synchronized, so it must not be updated while it is searched.
+ */
+class LatticeHierarchy
+{
+public:
+    /**
+     * @brief Marks an invalid sector or entrance
+     */
+    static constexpr uint32_t INVALID_INDEX = std::numeric_limits<uint32_t>::max();
+
+    /**
+     * @brief Builds the hierarchy of a lattice; Throws std::invalid_argument if the sector size is 0
+     *
+     * @param pGraph The lattice
+     * @param pSectorSize The number of grid cells per sector in x and y direction
+     */
+    LatticeHierarchy(std::shared_ptr<const LatticeGraph> pGraph, uint32_t pSectorSize=16);
+
+    /**
+     * @brief Returns the lattice
+     *
+     * @return const LatticeGraph& The lattice
+     */
+    const LatticeGraph& getGraph() const;
+
+    /**
+     * @brief Returns the number of grid cells per sector in x and y direction
+     *
+     * @return uint32_t The sector size
+     */
+    uint32_t getSectorSize() const;
+
+    /**
+     * @brief Returns the number of sectors
+     *
+     * @return size_t Number of sectors
+     */
+    size_t getSectorCount() const;
+
+    /**
+     * @brief Returns the sector of a node
+     *
+     * @param pNode The node (has to be valid)
+     * @return uint32_t The index of the sector (row major)
+     */
+    uint32_t getSector(NodeId pNode) const
+    {
+        std::tuple<uint32_t, uint32_t, uint32_t> position = this->graph->getPosition(pNode);
+        return (std::get<1>(position) / this->sectorSize) * this->sectorsX + std::get<0>(position) / this->sectorSize;
+    }
+
+    /**
+     * @brief Returns the number of entrances of all sectors (the nodes of the abstract graph)
+     *
+     * @return size_t Number of entrances
+     */
+    size_t getEntranceCount() const;
+
+    /**
+     * @brief Returns the entrances of a sector
+     *
+     * @param pSector The sector
+     * @return std::span<const NodeId> The nodes which are entrances of the sector
+     */
+    std::span<const NodeId> getEntrances(uint32_t pSector) const;
+
+    /**
+     * @brief Returns the index of an entrance in the abstract graph
+     *
+     * @param pNode The node (has to be valid)
+     * @return uint32_t The index or INVALID_INDEX if the node is no entrance
+     */
+    uint32_t getEntranceIndex(NodeId pNode) const
+    {
+        return this->entranceIndices[pNode];
+    }
+
+    /**
+     * @brief Returns the node of an entrance
+     *
+     * @param pEntrance The index of the entrance
+     * @return NodeId The node
+     */
+    NodeId getEntranceNode(uint32_t pEntrance) const
+    {
+        return this->entrances[pEntrance];
+    }
+
+    /**
+     * @brief Returns the costs between two entrances of the same sector
+     *
+     * @param pFrom The index of the first entrance
+     * @param pTo The index of the second entrance
+     * @return double The costs of the shortest path inside of the sector; Infinity if there is none or an entrance is blocked
+     */
+    double getIntraSectorCost(uint32_t pFrom, uint32_t pTo) const
+    {
+        const uint32_t sector = this->getSector(this->entrances[pFrom]);
+        const uint32_t first = this->sectorOffsets[sector];
+        const uint32_t count = this->sectorOffsets[sector + 1] - first;
+        return this->costs[sector][(pFrom - first) * count + (pTo - first)];
+    }
+
+    /**
+     * @brief Calls pCallback(<entrance>, <costs>) for every edge of the abstract graph which starts at an entrance
+     *
+     * @tparam Callback Callable with the signature void(uint32_t, double)
+     * @param pEntrance The index of the entrance
+     * @param pCallback The callback to call for every edge
+     */
+    template<class Callback> void forEachAbstractEdge(uint32_t pEntrance, Callback&& pCallback) const
+    {
+        const NodeId node = this->entrances[pEntrance];
+        if(this->graph->isBlocked(node))
+        {
+            return;
+        }
+        const uint32_t sector = this->getSector(node);
+        const uint32_t first = this->sectorOffsets[sector];
+        const uint32_t count = this->sectorOffsets[sector + 1] - first;
+        const double* row = this->costs[sector].data() + (pEntrance - first) * count;
+        for(uint32_t i = 0; i < count; i++)
+        {
+            if(first + i != pEntrance && row[i] != std::numeric_limits<double>::infinity())
+            {
+                pCallback(first + i, row[i]);
+            }
+        }
+        /*Lattice edges into other sectors always end at an entrance of the other sector*/
+        this->graph->forEachOutgoing(node, [&](NodeId pNext, double pWeight) {
+            if(this->getSector(pNext) != sector)
+            {
+                pCallback(this->entranceIndices[pNext], pWeight);
+            }
+        });
+    }
+
+    /**
+     * @brief Rebuilds the intra-sector costs of the sector of a node; Has to be called after the node was blocked or unblocked
+     *
+     * @param pNode The node whose state changed
+     */
+    void updateNode(NodeId pNode);
+
+    /**
+     * @brief Rebuilds the intra-sector costs of a sector
+     *
+     * @param pSector The sector
+     */
+    void rebuildSector(uint32_t pSector);
+protected:
+    /**
+     * @brief Checks if a node has a lattice edge into another sector (independent of obstacles)
+     *
+     * @param pNode The node
+     * @return true The node is an entrance
+     * @return false All neighbours are in the same sector
+     */
+    bool isEntrance(NodeId pNode) const;
+
+    /**
+     * @brief Calculates the costs between all entrances of a sector
+     *
+     * @param pSector The sector
+     * @param pTree The search to use for the sector
+     */
+    void buildSector(uint32_t pSector, SectorTree& pTree);
+
+    /**
+     * @brief The lattice
+     */
+    std::shared_ptr<const LatticeGraph> graph;
+
+    /**
+     * @brief The number of grid cells per sector in x and y direction
+     */
+    uint32_t sectorSize;
+
+    /**
+     * @brief The number of sectors in x and y direction
+     */
+    uint32_t sectorsX;
+    uint32_t sectorsY;
+
+    /**
+     * @brief The entrances of all sectors; The entrances of sector s are stored in [sectorOffsets[s], sectorOffsets[s+1])
+     */
+    std::vector<NodeId> entrances;
+    std::vector<uint32_t> sectorOffsets;
+
+    /**
+     * @brief The index of the entrance of every node (INVALID_INDEX if the node is no entrance)
+     */
+    std::vector<uint32_t> entranceIndices;
+
+    /**
+     * @brief The costs between the entrances of every sector as row major matrix in the order of the entrances
+     */
+    std::vector<std::vector<double>> costs;
+};
+
+/**
+ * @brief Searches shortest paths with a LatticeHierarchy: Start and target are connected to the entrances of their sectors, an A*
+ * on the abstract graph finds the sequence of entrances, which is finally refined into lattice nodes by searches inside of the
+ * sectors. Only the obstacles of the lattice are respected; The results have the same costs as a search in the lattice.
+ *
+ * The instance can be reused for multiple searches on the same hierarchy; Every thread needs an instance of its own.
+ */
+class HierarchicalSearch
+{
+public:
+    /**
+     * @brief Creates a new search on a hierarchy
+     *
+     * @param pHierarchy The hierarchy to search in
+     */
+    HierarchicalSearch(const LatticeHierarchy& pHierarchy);
+
+    /**
+     * @brief Searches a cost optimal path from pStart to pTarget
+     *
+     * @param pStart The start node
+     * @param pTarget The target node
+     * @return std::vector<NodeId> The path or an empty vector if there is no such path
+     */
+    std::vector<NodeId> findPath(NodeId pStart, NodeId pTarget);
+
+    /**
+     * @brief Calculates the costs of the shortest path from pStart to pTarget on the abstract graph without refining the path
+     *
+     * @param pStart The start node
+     * @param pTarget The target node
+     * @return double The costs of the shortest path; Infinity if there is no such path
+     */
+    double getDistance(NodeId pStart, NodeId pTarget);
+
+    /**
+     * @brief Returns the number of entrances expanded by the last search
+     *
+     * @return size_t Number of expansions
+     */
+    size_t getExpansions() const;
+protected:
+    /**
+     * @brief Runs the abstract search; Afterwards goalParent contains the last entrance of the best path (INVALID_INDEX if the
+     * path stays inside of the start sector)
+     *
+     * @return double The costs of the shortest path
+     */
+    double search(NodeId pStart, NodeId pTarget);
+
+    /**
+     * @brief Resets the entrances touched by the last search
+     */
+    void reset();
+
+    /**
+     * @brief The hierarchy to search in
+     */
+    const LatticeHierarchy& hierarchy;
+
+    /**
+     * @brief The searches from the start and from the target inside of their sectors and the search used to refine intra-sector
+     * edges
+     */
+    SectorTree startTree;
+    SectorTree targetTree;
+    SectorTree refineTree;
+
+    /**
+     * @brief The costs from the start and the predecessor of every entrance (INVALID_INDEX for entrances of the start sector which
+     * were reached directly from the start)
+     */
+    std::vector<double> g;
+    std::vector<uint32_t> parents;
+
+    /**
+     * @brief Marks the entrances which were expanded by the current search
+     */
+    std::vector<bool> closed;
+
+    /**
+     * @brief The entrances which were touched by the current search
+     */
+    std::vector<uint32_t> touchedEntrances;
+
+    /**
+     * @brief The open list of the abstract search
+     */
+    IndexedHeap<double> open;
+
+    /**
+     * @brief The last entrance of the best path found by the last search
+     */
+    uint32_t goalParent;
+
+    /**
+     * @brief Counts the expansions of the last search
+     */
+    size_t expansions;
+};
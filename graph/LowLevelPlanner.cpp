@@ -0,0 +1,17 @@
+/**
+ * @file LowLevelPlanner.cpp
+ * @author Lennart Hustermeier (lennart.hustermeier@gmx.de)
+ * @brief Contains the instantiations of the commonly used low level planners
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "LowLevelPlanner.hpp"
+
+template class SpaceTimeAStarPlanner<LatticeGraph, LatticeHeuristicFactory>;
+template class SpaceTimeAStarPlanner<CompactGraph, NodeNameHeuristicFactory>;
+template class SafeIntervalPlanner<LatticeGraph, LatticeHeuristicFactory>;
+template class SafeIntervalPlanner<CompactGraph, NodeNameHeuristicFactory>;
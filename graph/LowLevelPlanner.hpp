@@ -0,0 +1,313 @@
+/**
+ * @file LowLevelPlanner.hpp
+ * @author Lennart Hustermeier (lennart.hustermeier@gmx.de)
+ * @brief Contains the interface of the single agent path finding used by CBS and its implementation on top of the space-time A*
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include "BlockedGraph.hpp"
+#include "CompactGraph.hpp"
+#include "JumpPointSearch.hpp"
+#include "LatticeGraph.hpp"
+#include "ReservationTable.hpp"
+#include "SafeIntervalSearch.hpp"
+#include "SearchArena.hpp"
+#include "SpaceTimeAStar.hpp"
+#include <functional>
+#include <memory>
+
+/**
+ * @brief The algorithms which can be used as low level search
+ */
+enum LowLevelAlgorithm : int
+{
+    /*A* in the time expanded graph (BasicSpaceTimeAStar); Waits are only possible along self loops of the graph*/
+    LOW_LEVEL_SPACE_TIME_A_STAR,
+    /*Safe interval path planning (BasicSafeIntervalSearch); Agents can wait on every node, each timestep costs the weight of the
+    loop of the node or the wait cost if it has none*/
+    LOW_LEVEL_SAFE_INTERVALS
+};
+
+/**
+ * @brief Finds single agent paths under reservations on one specific graph. CBS only talks to the graph through this interface,
+ * so it can run on any graph representation without materializing it as Graph. Implementations have to be thread safe.
+ * The interface is only crossed once per low level search; Everything inside of a search is resolved at compile time.
+ */
+class LowLevelPlanner
+{
+public:
+    /**
+     * @brief Destroys the planner
+     */
+    virtual ~LowLevelPlanner() = default;
+
+    /**
+     * @brief Returns the ID of a node
+     *
+     * @param pNode The name of the node
+     * @return NodeId The ID of the node or CompactGraph::INVALID_NODE if the node is not part of the graph
+     */
+    virtual NodeId getNodeId(const NodeType& pNode) const = 0;
+
+    /**
+     * @brief Returns the name of a node
+     *
+     * @param pNode The ID of the node (has to be valid)
+     * @return NodeType The name of the node
+     */
+    virtual NodeType getNodeName(NodeId pNode) const = 0;
+
+    /**
+     * @brief Searches a cost optimal path which respects the reservations; The agent has to be able to stay on the target
+     *
+     * @param pStart The start node
+     * @param pTarget The target node
+     * @param pReservations The node and edge reservations of the agent
+     * @return std::vector<NodeId> The path (one node per timestep) or an empty vector if there is none
+     */
+    virtual std::vector<NodeId> findPath(NodeId pStart, NodeId pTarget, const ReservationTable& pReservations) const = 0;
+
+    /**
+     * @brief Returns the costs of a path
+     *
+     * @param pPath The path as a vector of node IDs
+     * @return double The costs of the path; Throws std::out_of_range if the path contains an edge which is not part of the graph
+     */
+    virtual double getPathCost(const std::vector<NodeId>& pPath) const = 0;
+};
+
+/**
+ * @brief Runs the space-time A* specialized for a graph type and a heuristic type
+ *
+ * @tparam GraphType The graph to search in (CompactGraph or LatticeGraph)
+ * @tparam HeuristicFactory Callable with the signature <heuristic>(const std::shared_ptr<const GraphType>&, NodeId <target>);
+ * The returned heuristic is a callable double(NodeId) and is handed to the search with its concrete type
+ */
+template<class GraphType, class HeuristicFactory> class SpaceTimeAStarPlanner : public LowLevelPlanner
+{
+public:
+    /**
+     * @brief Constructs a new planner
+     *
+     * @param pGraph The graph to search in
+     * @param pHeuristicFactory Creates the heuristic for a target
+     */
+    SpaceTimeAStarPlanner(std::shared_ptr<const GraphType> pGraph, HeuristicFactory pHeuristicFactory=HeuristicFactory())
+    : graph(pGraph), heuristicFactory(pHeuristicFactory)
+    {
+
+    }
+
+    NodeId getNodeId(const NodeType& pNode) const override
+    {
+        return this->graph->getNodeId(pNode);
+    }
+
+    NodeType getNodeName(NodeId pNode) const override
+    {
+        return this->graph->getNodeName(pNode);
+    }
+
+    std::vector<NodeId> findPath(NodeId pStart, NodeId pTarget, const ReservationTable& pReservations) const override
+    {
+        if(pStart >= this->graph->getNodeCount() || pTarget >= this->graph->getNodeCount())
+        {
+            return std::vector<NodeId>();
+        }
+        SearchArena::Scope scope;
+        BasicSpaceTimeAStar<GraphType> search(*this->graph, scope.getResource());
+        return search.findPath(pStart, pTarget, this->heuristicFactory(this->graph, pTarget), std::vector<bool>(), pReservations);
+    }
+
+    double getPathCost(const std::vector<NodeId>& pPath) const override
+    {
+        return this->graph->getPathCost(pPath);
+    }
+protected:
+    /**
+     * @brief The graph to search in
+     */
+    std::shared_ptr<const GraphType> graph;
+
+    /**
+     * @brief Creates the heuristics
+     */
+    HeuristicFactory heuristicFactory;
+};
+
+/**
+ * @brief Runs SIPP specialized for a graph type and a heuristic type
+ *
+ * @tparam GraphType The graph to search in (CompactGraph or LatticeGraph)
+ * @tparam HeuristicFactory Same as for SpaceTimeAStarPlanner
+ */
+template<class GraphType, class HeuristicFactory> class SafeIntervalPlanner : public SpaceTimeAStarPlanner<GraphType, HeuristicFactory>
+{
+public:
+    /**
+     * @brief Constructs a new planner
+     *
+     * @param pGraph The graph to search in
+     * @param pHeuristicFactory Creates the heuristic for a target
+     * @param pWaitCost The costs of waiting one timestep on a node without a self loop (has to be positive)
+     */
+    SafeIntervalPlanner(std::shared_ptr<const GraphType> pGraph, HeuristicFactory pHeuristicFactory=HeuristicFactory(), double pWaitCost=BasicSafeIntervalSearch<GraphType>::DEFAULT_WAIT_COST)
+    : SpaceTimeAStarPlanner<GraphType, HeuristicFactory>(pGraph, pHeuristicFactory), waitCost(pWaitCost)
+    {
+
+    }
+
+    std::vector<NodeId> findPath(NodeId pStart, NodeId pTarget, const ReservationTable& pReservations) const override
+    {
+        if(pStart >= this->graph->getNodeCount() || pTarget >= this->graph->getNodeCount())
+        {
+            return std::vector<NodeId>();
+        }
+        SearchArena::Scope scope;
+        BasicSafeIntervalSearch<GraphType> search(*this->graph, scope.getResource(), this->waitCost);
+        return search.findPath(pStart, pTarget, this->heuristicFactory(this->graph, pTarget), std::vector<bool>(), pReservations);
+    }
+
+    /**
+     * @brief Returns the costs of a path; Every wait costs the weight of the loop of the node or the wait cost if it has none, the
+     * same as in the search
+     *
+     * @param pPath The path as a vector of node IDs
+     * @return double The costs of the path; Throws std::out_of_range if the path contains an edge which is not part of the graph
+     */
+    double getPathCost(const std::vector<NodeId>& pPath) const override
+    {
+        std::vector<NodeId> moves;
+        moves.reserve(pPath.size());
+        double waits = 0.0;
+        for(NodeId n : pPath)
+        {
+            if(moves.empty() || moves.back() != n)
+            {
+                moves.push_back(n);
+            }
+            else
+            {
+                waits += BasicSafeIntervalSearch<GraphType>::getNodeWaitCost(*this->graph, n, this->waitCost);
+            }
+        }
+        return this->graph->getPathCost(moves) + waits;
+    }
+protected:
+    /**
+     * @brief The costs of waiting one timestep on a node without a self loop
+     */
+    double waitCost;
+};
+
+/**
+ * @brief Creates a planner, deducing the heuristic factory type (e.g. of a lambda)
+ *
+ * @param pGraph The graph to search in
+ * @param pHeuristicFactory Creates the heuristic for a target
+ * @param pAlgorithm The low level search to run
+ * @return std::shared_ptr<const LowLevelPlanner> The planner
+ */
+template<class GraphType, class HeuristicFactory> std::shared_ptr<const LowLevelPlanner> makeLowLevelPlanner(std::shared_ptr<const GraphType> pGraph, HeuristicFactory pHeuristicFactory, LowLevelAlgorithm pAlgorithm=LOW_LEVEL_SPACE_TIME_A_STAR)
+{
+    if(pAlgorithm == LOW_LEVEL_SAFE_INTERVALS)
+    {
+        return std::make_shared<SafeIntervalPlanner<GraphType, HeuristicFactory>>(pGraph, pHeuristicFactory);
+    }
+    return std::make_shared<SpaceTimeAStarPlanner<GraphType, HeuristicFactory>>(pGraph, pHeuristicFactory);
+}
+
+/**
+ * @brief Creates the arithmetic distance estimate of a lattice as heuristic
+ */
+struct LatticeHeuristicFactory
+{
+    auto operator()(const std::shared_ptr<const LatticeGraph>& pGraph, NodeId pTarget) const
+    {
+        const LatticeGraph* lattice = pGraph.get();
+        return [lattice, pTarget](NodeId pNode) { return lattice->getDistanceEstimate(pNode, pTarget); };
+    }
+};
+
+/**
+ * @brief Wraps a type erased heuristic on node names (the API of Graph and CBS); Every evaluation translates the node to its name
+ */
+struct NodeNameHeuristicFactory
+{
+    std::function<double(NodeType, NodeType)> heuristic;
+
+    auto operator()(const std::shared_ptr<const CompactGraph>& pGraph, NodeId pTarget) const
+    {
+        const CompactGraph* graph = pGraph.get();
+        const std::function<double(NodeType, NodeType)>* h = &this->heuristic;
+        return [graph, h, pTarget](NodeId pNode) { return (*h)(graph->getNodeName(pNode), graph->getNodeName(pTarget)); };
+    }
+
+    auto operator()(const std::shared_ptr<const BlockedGraph>& pGraph, NodeId pTarget) const
+    {
+        return (*this)(pGraph->getGraph(), pTarget);
+    }
+};
+
+/**
+ * @brief The planner on implicit lattices
+ */
+typedef SpaceTimeAStarPlanner<LatticeGraph, LatticeHeuristicFactory> LatticePlanner;
+
+/**
+ * @brief The planner on compact graphs with a heuristic on node names
+ */
+typedef SpaceTimeAStarPlanner<CompactGraph, NodeNameHeuristicFactory> NodeNamePlanner;
+
+/**
+ * @brief SIPP on implicit lattices
+ */
+typedef SafeIntervalPlanner<LatticeGraph, LatticeHeuristicFactory> LatticeSafeIntervalPlanner;
+
+/**
+ * @brief SIPP on compact graphs with a heuristic on node names
+ */
+typedef SafeIntervalPlanner<CompactGraph, NodeNameHeuristicFactory> NodeNameSafeIntervalPlanner;
+
+/**
+ * @brief Runs Jump Point Search on implicit lattices; The paths have the same costs as with LatticePlanner, but far fewer states are
+ * expanded. The spikes of the GeometryModule lattices are handled, only lattices whose spike edges are cheaper than the grid fall back
+ * to the searches of LatticePlanner. The swarm operation handler plans with it on environments which are too large for a distance
+ * matrix.
+ */
+class LatticeJumpPointPlanner : public LatticePlanner
+{
+public:
+    /**
+     * @brief Constructs a new planner
+     *
+     * @param pGraph The lattice to search in
+     */
+    LatticeJumpPointPlanner(std::shared_ptr<const LatticeGraph> pGraph)
+    : LatticePlanner(pGraph)
+    {
+
+    }
+
+    std::vector<NodeId> findPath(NodeId pStart, NodeId pTarget, const ReservationTable& pReservations) const override
+    {
+        if(pStart >= this->graph->getNodeCount() || pTarget >= this->graph->getNodeCount())
+        {
+            return std::vector<NodeId>();
+        }
+        SearchArena::Scope scope;
+        LatticeJumpPointSearch search(*this->graph, scope.getResource());
+        return search.findPath(pStart, pTarget, pReservations);
+    }
+};
+
+extern template class SpaceTimeAStarPlanner<LatticeGraph, LatticeHeuristicFactory>;
+extern template class SpaceTimeAStarPlanner<CompactGraph, NodeNameHeuristicFactory>;
+extern template class SafeIntervalPlanner<LatticeGraph, LatticeHeuristicFactory>;
+extern template class SafeIntervalPlanner<CompactGraph, NodeNameHeuristicFactory>;
@@ -12,14 +12,107 @@
 #include "CBS.hpp"
 #include "ConstraintTree.hpp"
 #include <algorithm>
+#include <atomic>
 #include <future>
+#include <limits>
 #include <memory>
 #include <mutex>
-#include <thread>
-#include <array>
+#include <random>
+#include <unordered_set>
+
+namespace
+{
+    /*The number of open lists per thread of the multi-queue; More lists mean less contention but a weaker best-first order*/
+    constexpr unsigned int LISTS_PER_THREAD = 2;
+
+    /*A relaxed concurrent priority queue of constraint tree nodes (multi-queue): Every thread pushes the children it creates to
+    one of its own lists and pops the better front of one of its own lists and one random list, so idle threads steal the work of
+    busy ones. A pop does not necessarily return the globally best node*/
+    class OpenMultiQueue
+    {
+    public:
+        OpenMultiQueue(unsigned int pThreads)
+        : lists(pThreads * LISTS_PER_THREAD)
+        {
+
+        }
+
+        /*Adds a node to one of the lists of a thread*/
+        void push(unsigned int pThread, std::unique_ptr<ConstraintTree> pNode, std::minstd_rand& pRandom)
+        {
+            List& list = this->lists[pThread * LISTS_PER_THREAD + pRandom() % LISTS_PER_THREAD];
+            std::lock_guard<std::mutex> lock(list.mutex);
+            list.heap.push_back(std::move(pNode));
+            std::push_heap(list.heap.begin(), list.heap.end(), worse);
+            list.front = list.heap.front()->getCostSum();
+        }
+
+        /*Removes a node with low costs; Only returns nullptr if all lists were empty*/
+        std::unique_ptr<ConstraintTree> pop(unsigned int pThread, std::minstd_rand& pRandom)
+        {
+            const size_t own = pThread * LISTS_PER_THREAD + pRandom() % LISTS_PER_THREAD;
+            const size_t other = pRandom() % this->lists.size();
+            std::unique_ptr<ConstraintTree> node = this->tryPop(this->lists[other].front < this->lists[own].front ? other : own);
+
+            /*The chosen list was empty -> look at all lists before reporting that there is no node*/
+            for(size_t i = 0; node == nullptr && i < this->lists.size(); i++)
+            {
+                node = this->tryPop((own + i) % this->lists.size());
+            }
+            return node;
+        }
+    protected:
+        /*One open list as binary heap of node handles; front caches the costs of its best node, so lists can be compared without
+        locking them*/
+        struct List
+        {
+            std::mutex mutex;
+            std::vector<std::unique_ptr<ConstraintTree>> heap;
+            std::atomic<double> front{std::numeric_limits<double>::infinity()};
+        };
+
+        /*The heap order: The best node is on top*/
+        static bool worse(const std::unique_ptr<ConstraintTree>& pLhs, const std::unique_ptr<ConstraintTree>& pRhs)
+        {
+            return *pRhs < *pLhs;
+        }
+
+        /*Removes the best node of a list; Returns nullptr if the list was empty*/
+        std::unique_ptr<ConstraintTree> tryPop(size_t pList)
+        {
+            List& list = this->lists[pList];
+            if(list.front == std::numeric_limits<double>::infinity())
+            {
+                return nullptr;
+            }
+            std::lock_guard<std::mutex> lock(list.mutex);
+            if(list.heap.empty())
+            {
+                return nullptr;
+            }
+            std::pop_heap(list.heap.begin(), list.heap.end(), worse);
+            std::unique_ptr<ConstraintTree> node = std::move(list.heap.back());
+            list.heap.pop_back();
+            list.front = list.heap.empty() ? std::numeric_limits<double>::infinity() : list.heap.front()->getCostSum();
+            return node;
+        }
+
+        std::vector<List> lists;
+    };
+}
 
 CBS::CBS(std::function<double(NodeType, NodeType)> pHeuristicLowLevel, unsigned int pMaxThreads)
-: heuristicLowLevel(pHeuristicLowLevel), maxThreads(pMaxThreads)
+: heuristicLowLevel(pHeuristicLowLevel), heuristicProvider(nullptr), maxThreads(pMaxThreads), threadPool(nullptr), lowLevelAlgorithm(LOW_LEVEL_SPACE_TIME_A_STAR)
+{
+
+}
+CBS::CBS(std::shared_ptr<HeuristicProvider> pHeuristicProvider, unsigned int pMaxThreads)
+: heuristicLowLevel([](NodeType, NodeType){ return 0.0; }), heuristicProvider(pHeuristicProvider), maxThreads(pMaxThreads), threadPool(nullptr), lowLevelAlgorithm(LOW_LEVEL_SPACE_TIME_A_STAR)
+{
+
+}
+CBS::CBS(unsigned int pMaxThreads)
+: heuristicLowLevel([](NodeType, NodeType){ return 0.0; }), heuristicProvider(nullptr), maxThreads(pMaxThreads), threadPool(nullptr), lowLevelAlgorithm(LOW_LEVEL_SPACE_TIME_A_STAR)
 {
 
 }
@@ -30,6 +123,31 @@ unsigned int CBS::getMaxThreads() const
 void CBS::setMaxThreads(unsigned int pMaxThreads)
 {
     this->maxThreads = pMaxThreads;
+    this->threadPool.reset();
+}
+std::shared_ptr<ThreadPool> CBS::getThreadPool()
+{
+    if(!this->threadPool)
+    {
+        this->threadPool = std::make_shared<ThreadPool>(this->maxThreads);
+    }
+    return this->threadPool;
+}
+void CBS::setThreadPool(std::shared_ptr<ThreadPool> pThreadPool)
+{
+    this->threadPool = pThreadPool;
+    if(pThreadPool)
+    {
+        this->maxThreads = pThreadPool->getThreadCount();
+    }
+}
+LowLevelAlgorithm CBS::getLowLevelAlgorithm() const
+{
+    return this->lowLevelAlgorithm;
+}
+void CBS::setLowLevelAlgorithm(LowLevelAlgorithm pLowLevelAlgorithm)
+{
+    this->lowLevelAlgorithm = pLowLevelAlgorithm;
 }
 
 /**
@@ -40,126 +158,146 @@ void CBS::setMaxThreads(unsigned int pMaxThreads)
 void setMaxThreads(unsigned int pMaxThreads);
 MAPF::Plan CBS::solveTask(const MAPF::Task& pTask)
 {
-    std::map<unsigned int, std::pair<NodeType, NodeType>> startTarget = pTask.getAgentsStartTarget();
-
-    /*Construct root node*/
-    ConstraintTree R(pTask.getGraph(), startTarget, this->heuristicLowLevel);
-
-    std::set<ConstraintTree> open;
+    /*The obstacle layer is only planned on if it blocks anything, the plain compact graph needs no bit tests*/
+    std::shared_ptr<const BlockedGraph> layer = pTask.getGraph().getActiveBlockedGraph();
+    std::shared_ptr<const CompactGraph> compact = layer ? layer->getGraph() : pTask.getGraph().getCompactGraph();
 
-    std::array<const ConstraintTree*, 24> processingData;
-    std::array<ConstraintTree*, 48> processingResult;
-    std::vector<std::thread> threads;
-
-    /*Also save a closed list; This one is used to prevent searching the same solution twice and saves the hash
-    values of all erased tree nodes*/
-    std::set<unsigned int> closed;
-
-    /*Add the root node to the open list*/
-    open.insert(R);
-    while(!open.empty())
+    /*The planner fixes graph and heuristic types, so the low level searches run without type erasure*/
+    std::shared_ptr<const LowLevelPlanner> planner;
+    if(this->heuristicProvider)
+    {
+        /*Let the provider calculate the heuristics of all targets in one go; Obstacles only make paths longer, so the heuristics
+        of the graph below the layer stay admissible*/
+        std::vector<NodeId> targets;
+        for(const std::pair<const unsigned int, std::pair<NodeType, NodeType>>& a : pTask.getAgentsStartTarget())
+        {
+            targets.push_back(compact->getNodeId(a.second.second));
+        }
+        this->heuristicProvider->prepare(compact, targets);
+        planner = layer ? this->heuristicProvider->createPlanner(layer, this->lowLevelAlgorithm) : this->heuristicProvider->createPlanner(compact, this->lowLevelAlgorithm);
+    }
+    else if(layer)
+    {
+        planner = makeLowLevelPlanner(layer, NodeNameHeuristicFactory{this->heuristicLowLevel}, this->lowLevelAlgorithm);
+    }
+    else
     {
-        threads.clear();
+        planner = makeLowLevelPlanner(compact, NodeNameHeuristicFactory{this->heuristicLowLevel}, this->lowLevelAlgorithm);
+    }
+    return this->solve(planner, pTask.getAgentsStartTarget());
+}
+MAPF::Plan CBS::solve(std::shared_ptr<const LowLevelPlanner> pPlanner, const std::map<unsigned int, std::pair<NodeType, NodeType>>& pAgentsStartTarget)
+{
+    /*The workers are started once and kept across solves*/
+    std::shared_ptr<ThreadPool> pool = this->getThreadPool();
 
-        /*Calculate how many threads to spawn; There shall be no more tasks than nodes in the open list*/
-        unsigned int numThreads = std::min(open.size(), (size_t)24);
+    /*The open list is shared by all threads; Every thread takes a node, expands it and pushes the children back without waiting
+    for the others, so a slow low level search only delays its own node*/
+    OpenMultiQueue open(pool->getThreadCount());
 
-        unsigned int threadCntr = 0;
-        for(threadCntr=0; threadCntr<numThreads; threadCntr++)
-        {
-            /*Create tasks that calculate a solution for the nth best element in the open list and searches for collisions;
-            The input data for the tasks is stored in the processingData array, the output is stored in the processingResult
-            array*/
-            const ConstraintTree& P = *std::next(open.begin(), threadCntr);
-            processingData[threadCntr] = &P;
-            threads.emplace_back([threadCntr, &processingData, &processingResult, this]() {
-                /*Search for first conflict in the current nodes solution*/
-                std::optional<Conflict> C = processingData[threadCntr]->getFirstConflict();
-
-                processingResult[threadCntr * 2] = nullptr;
-                processingResult[threadCntr * 2 + 1] = nullptr;
-
-                if(!C.has_value())
-                {
-                    /*No conflict -> optimal path found*/
-                    return;
-                }
-                Conflict conflict = C.value();
+    /*Also save the fingerprints of all generated tree nodes; They are used to prevent searching the same constraints twice*/
+    std::unordered_set<Fingerprint, FingerprintHash> generated;
+    std::mutex generatedMutex;
 
-                /*Calculate solutions for the two different possible constraints due to the previously found conflict*/
-                ConstraintTree* child1 = new ConstraintTree(*processingData[threadCntr], Constraint(conflict.getTimestep(), conflict.getAgent1(), conflict.getNode1()), this->heuristicLowLevel);
-                ConstraintTree* child2 = new ConstraintTree(*processingData[threadCntr], Constraint(conflict.getTimestep(), conflict.getAgent2(), conflict.getNode2()), this->heuristicLowLevel);
+    /*The best solution found so far (the incumbent); As the threads do not expand the nodes in the order of their costs, a
+    solution is only known to be optimal if no node with lower costs is left. Nodes which can not beat the incumbent are pruned*/
+    std::optional<std::map<unsigned int, std::map<unsigned int, NodeType>>> solution;
+    std::atomic<double> bestCostSum = std::numeric_limits<double>::infinity();
+    std::mutex solutionMutex;
 
-                if(child1->hasSolution())
-                {
-                    processingResult[threadCntr * 2] = child1;
-                }
-                if(child2->hasSolution())
-                {
-                    processingResult[threadCntr * 2 + 1] = child2;
-                }
-                return;
-            });
-        }
+    /*The number of nodes which are in the open list or being expanded; The search is done when it drops to 0. Idle threads wait
+    for a change of signal, which is incremented for every push and when the search ends*/
+    std::atomic<size_t> pending = 1;
+    std::atomic<size_t> signal = 0;
+    std::atomic<bool> failed = false;
 
-        /*Wait for threads*/
-        for(auto& t : threads)
-        {
-            
-            t.join();
-        }
-        
-        /*Use an optional as we have to iterate over all threads anyway in order to delete their memory and prevent a leak*/
-        std::optional<std::map<unsigned int, std::map<unsigned int, NodeType>>> solution;
-        double minCostSum = DBL_MAX;
-        for(threadCntr=0; threadCntr<numThreads; threadCntr++)
+    /*Construct root node*/
+    std::minstd_rand rootRandom;
+    std::unique_ptr<ConstraintTree> root = std::make_unique<ConstraintTree>(pPlanner, pAgentsStartTarget);
+    generated.insert(root->getFingerprint());
+    open.push(0, std::move(root), rootRandom);
+
+    pool->run([&](unsigned int pThread) {
+        std::minstd_rand random(pThread + 1);
+        try
         {
-            if(processingResult[threadCntr * 2] == nullptr && processingResult[threadCntr * 2 + 1] == nullptr && !processingData[threadCntr]->getFirstConflict().has_value())
+            while(!failed)
             {
-                /*No child -> no conflict -> solution*/
-                if (!solution.has_value())
-                {
-                    solution = processingData[threadCntr]->getSolution();
-                }
-                else
+                const size_t seen = signal;
+                std::unique_ptr<ConstraintTree> P = open.pop(pThread, random);
+                if(P == nullptr)
                 {
-                    if (processingData[threadCntr]->getCostSum() <= minCostSum)
+                    if(pending == 0)
                     {
-                        solution = processingData[threadCntr]->getSolution();
+                        break;
                     }
+                    /*Other threads are still expanding nodes and may create new ones*/
+                    signal.wait(seen);
+                    continue;
                 }
-            }
-            else
-            {
-                if(processingResult[threadCntr * 2] != nullptr)
+
+                if(P->getCostSum() < bestCostSum)
                 {
-                    if(!closed.contains(processingResult[threadCntr * 2]->getHash()))
+                    /*Search for first conflict in the current nodes solution*/
+                    std::optional<Conflict> C = P->getFirstConflict();
+                    if(!C.has_value())
                     {
-                        open.insert(*processingResult[threadCntr * 2]);
+                        /*No conflict -> solution; It replaces the incumbent if it is cheaper*/
+                        std::lock_guard<std::mutex> lock(solutionMutex);
+                        if(P->getCostSum() < bestCostSum)
+                        {
+                            bestCostSum = P->getCostSum();
+                            solution = P->getSolution();
+                        }
                     }
-                    delete processingResult[threadCntr * 2];
-                }
-                if(processingResult[threadCntr * 2 + 1] != nullptr)
-                {
-                    if(!closed.contains(processingResult[threadCntr * 2 + 1]->getHash()))
+                    else
                     {
-                        open.insert(*processingResult[threadCntr * 2 + 1]);
+                        /*Calculate solutions for the two different possible constraints due to the previously found conflict*/
+                        const Conflict& conflict = C.value();
+                        for(const Constraint& constraint : {Constraint(conflict.getTimestep(), conflict.getAgent1(), conflict.getNode1()),
+                                                            Constraint(conflict.getTimestep(), conflict.getAgent2(), conflict.getNode2())})
+                        {
+                            std::unique_ptr<ConstraintTree> child = std::make_unique<ConstraintTree>(*P, constraint);
+                            if(!child->hasSolution() || child->getCostSum() >= bestCostSum)
+                            {
+                                continue;
+                            }
+                            {
+                                std::lock_guard<std::mutex> lock(generatedMutex);
+                                if(!generated.insert(child->getFingerprint()).second)
+                                {
+                                    /*The same constraints were already reached on another branch*/
+                                    continue;
+                                }
+                            }
+                            pending++;
+                            open.push(pThread, std::move(child), random);
+                            signal++;
+                            signal.notify_one();
+                        }
                     }
-                    delete processingResult[threadCntr * 2 + 1];
+                }
+
+                if(--pending == 0)
+                {
+                    /*Nothing left -> wake the waiting threads, so they can return*/
+                    signal++;
+                    signal.notify_all();
                 }
             }
         }
-        if(solution.has_value())
+        catch(...)
         {
-            /*We found a solution and cleared the threads memory up -> return*/
-            return MAPF::Plan(solution.value());
+            failed = true;
+            signal++;
+            signal.notify_all();
+            throw;
         }
-        for(threadCntr=0; threadCntr<numThreads; threadCntr++)
-        {
-            closed.insert(processingData[threadCntr]->getHash());
-            open.erase(*processingData[threadCntr]);
-        }
-    }
+    });
 
+    if(solution.has_value())
+    {
+        return MAPF::Plan(solution.value());
+    }
     return MAPF::Plan(std::map<unsigned int, std::map<unsigned int, NodeType>>());
 }
\ No newline at end of file
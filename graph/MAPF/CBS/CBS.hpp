@@ -11,6 +11,9 @@
 
 #pragma once
 #include "../mapf.hpp"
+#include "graph/LowLevelPlanner.hpp"
+#include "graph/ThreadPool.hpp"
+#include <memory>
 
 /**
  * @brief Collision based search (CBS) is a algorithm which solves the MAPF problem by searching for a path for all agents individually
@@ -25,18 +28,48 @@ public:
      * 
      * @param pHeuristicLowLevel The heuristic to be used in the low level algorithm for A*; The first argument is the node to evaluate, the second
      * is the target node. Possible heuristics could e.g. be the Manhattan distance or the euclidean distance between the nodes.
-     * @param pMaxThreads The maximum number of threads to use to solve the problem
+     * @param pMaxThreads The maximum number of threads to use to solve the problem; 0 selects the number of hardware threads
      */
-    CBS(std::function<double(NodeType, NodeType)> pHeuristicLowLevel, unsigned int pMaxThreads=24);
+    CBS(std::function<double(NodeType, NodeType)> pHeuristicLowLevel, unsigned int pMaxThreads=0);
 
     /**
-     * @brief Solves a task and returns the plan
+     * @brief Creates a new CBS solver which takes the heuristics for the low level algorithm from a heuristic provider
+     * 
+     * @param pHeuristicProvider Provides the heuristics on node IDs (e.g. a HeuristicCache); It is shared by all constraint tree nodes
+     * and can be kept alive across multiple solves, so precomputed data is reused as long as the graph does not change
+     * @param pMaxThreads The maximum number of threads to use to solve the problem; 0 selects the number of hardware threads
+     */
+    CBS(std::shared_ptr<HeuristicProvider> pHeuristicProvider, unsigned int pMaxThreads=0);
+
+    /**
+     * @brief Creates a new CBS solver without a heuristic; Meant for solve(), where the low level planner brings its own heuristic
+     * 
+     * @param pMaxThreads The maximum number of threads to use to solve the problem; 0 selects the number of hardware threads
+     */
+    CBS(unsigned int pMaxThreads=0);
+
+    /**
+     * @brief Solves a task and returns the plan; The agents avoid the obstacles of the graph (Graph::setBlocked(),
+     * Graph::setEdgeBlocked()), which must not change while the task is solved
      * 
      * @param pTask The task to solve
      * @return MAPF::Plan The plan which solves the task
      */
     MAPF::Plan solveTask(const MAPF::Task& pTask);
 
+    /**
+     * @brief Solves a MAPF problem on the graph of a low level planner, e.g. on an implicit lattice which is never materialized
+     * as Graph; The heuristic settings of this solver are not used, the planner brings its own heuristic. The threads of the pool
+     * expand constraint tree nodes asynchronously: Each takes a cheap node from a shared multi-queue, expands it and pushes the
+     * children back without waiting for the others. A solution is returned once no node which could lead to a cheaper one is left,
+     * so the result is optimal, but which of several optimal plans is returned may vary between runs.
+     * 
+     * @param pPlanner The low level planner to use
+     * @param pAgentsStartTarget Mapping <agent> -> (<start node>, <target node>)
+     * @return MAPF::Plan The plan which solves the problem (empty if there is none)
+     */
+    MAPF::Plan solve(std::shared_ptr<const LowLevelPlanner> pPlanner, const std::map<unsigned int, std::pair<NodeType, NodeType>>& pAgentsStartTarget);
+
     /**
      * @brief Returns the maximum number of threads which will be used to solve MAPF tasks
      * 
@@ -45,11 +78,44 @@ public:
     unsigned int getMaxThreads() const;
 
     /**
-     * @brief Sets the maximum number of threads which will be used to solve MAPF tasks
+     * @brief Sets the maximum number of threads which will be used to solve MAPF tasks; Drops the thread pool of this solver, so the
+     * next solve starts a pool of the new size
      * 
-     * @param pMaxThreads The maximum number of threads for this solver
+     * @param pMaxThreads The maximum number of threads for this solver; 0 selects the number of hardware threads
      */
     void setMaxThreads(unsigned int pMaxThreads);
+
+    /**
+     * @brief Returns the thread pool which expands the constraint tree nodes; The pool is started by the first call and then reused
+     * by all following solves of this solver
+     * 
+     * @return std::shared_ptr<ThreadPool> The thread pool
+     */
+    std::shared_ptr<ThreadPool> getThreadPool();
+
+    /**
+     * @brief Lets this solver expand the constraint tree nodes on an existing thread pool, e.g. one which is shared by multiple
+     * solvers; The maximum number of threads is set to the size of the pool. The pool must not run other loops during a solve.
+     * 
+     * @param pThreadPool The thread pool to use
+     */
+    void setThreadPool(std::shared_ptr<ThreadPool> pThreadPool);
+
+    /**
+     * @brief Returns the low level search which is used by solveTask()
+     * 
+     * @return LowLevelAlgorithm The low level search
+     */
+    LowLevelAlgorithm getLowLevelAlgorithm() const;
+
+    /**
+     * @brief Selects the low level search which is used by solveTask(); SIPP allows the agents to wait on every node and charges
+     * every timestep of waiting with the weight of the self loop of the node (like the space-time A*, which only waits along self
+     * loops of the graph) or like a unit loop if the node has none
+     * 
+     * @param pLowLevelAlgorithm The low level search
+     */
+    void setLowLevelAlgorithm(LowLevelAlgorithm pLowLevelAlgorithm);
 protected:
 
     /**
@@ -57,8 +123,23 @@ protected:
      */
     std::function<double(NodeType, NodeType)> heuristicLowLevel;
 
+    /**
+     * @brief Provides heuristics on node IDs for the low level algorithm; Replaces heuristicLowLevel if set
+     */
+    std::shared_ptr<HeuristicProvider> heuristicProvider;
+
     /**
      * @brief Stores the maximum number of threads to use to solve tasks using this solver
     */
     unsigned int maxThreads;
+
+    /**
+     * @brief The persistent workers which expand the best nodes of the open list in parallel; Started on demand
+     */
+    std::shared_ptr<ThreadPool> threadPool;
+
+    /**
+     * @brief The low level search used by solveTask()
+     */
+    LowLevelAlgorithm lowLevelAlgorithm;
 };
\ No newline at end of file
@@ -11,6 +11,8 @@
 #include "ConstraintTree.hpp"
 #include <optional>
 #include <iostream>
+#include <algorithm>
+#include <unordered_map>
 
 #define TEST_PATHFINDING 0
 #if TEST_PATHFINDING
@@ -23,6 +25,17 @@ static size_t hashCombine(size_t lhs, size_t rhs)
     return lhs;
 };
 
+/*The constraints of an agent for which no constraint was added yet*/
+static const ReservationTable noConstraints;
+
+/*The finalizer of splitmix64; Spreads every input bit over the whole result*/
+static uint64_t mix(uint64_t pValue)
+{
+    pValue = (pValue ^ (pValue >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    pValue = (pValue ^ (pValue >> 27)) * 0x94d049bb133111ebULL;
+    return pValue ^ (pValue >> 31);
+}
+
 Constraint::Constraint(std::tuple<unsigned int, unsigned int, NodeType> pTuple) : t(pTuple)
 {
 }
@@ -100,388 +113,339 @@ NodeType Conflict::getNode2() const
     return std::get<4>(this->t);
 }
 
-ConstraintTree::ConstraintTree(const Graph& pGraph, const std::map<unsigned int, std::pair<NodeType, NodeType>>& pAgentTasks, std::function<double(NodeType, NodeType)> pH) 
-: agentTasks(pAgentTasks), graph(pGraph), costSum(0.0), hashValue(0)
+ConstraintTree::ConstraintTree(std::shared_ptr<const LowLevelPlanner> pPlanner, const std::map<unsigned int, std::pair<NodeType, NodeType>>& pAgentTasks) 
+: agentTasks(pAgentTasks), planner(pPlanner), memory(std::make_shared<std::pmr::synchronized_pool_resource>()), state(nullptr),
+  fingerprint{0, 0}, costSum(0.0), solvable(true), firstConflict(), conflictKnown(false)
 {
     /*Root node -> calculate a whole new solution*/
-    this->calculateSolution(pH);
+    this->calculateSolution();
 }
 
-ConstraintTree::ConstraintTree(const ConstraintTree& pParent, Constraint pConstraint, std::function<double(NodeType, NodeType)> pH) 
-: constraints(pParent.constraints), solution(pParent.solution), agentTasks(pParent.agentTasks), graph(pParent.graph), costs(pParent.costs),
-  costSum(pParent.costSum), hashValue(0)
+ConstraintTree::ConstraintTree(const ConstraintTree& pParent, Constraint pConstraint) 
+: agentTasks(pParent.agentTasks), planner(pParent.planner), memory(pParent.memory), state(pParent.state),
+  fingerprint(pParent.fingerprint), costSum(pParent.costSum), solvable(pParent.solvable), firstConflict(), conflictKnown(false)
 {
-    /*Add one constraint to the list as a conflict occured on the parent*/
-    this->constraints[pConstraint.getAgent()][pConstraint.getTimestep()].insert(pConstraint.getNode());
-
-    /*Recalculate the path and the cost for one agent*/
-    this->updateSolution(pConstraint.getAgent(), pH);
+    /*Add one constraint as a conflict occured on the parent and recalculate the path and the cost for that agent; The records
+    of all other agents are shared with the parent*/
+    this->updateSolution(pConstraint);
 }
 std::optional<Conflict> ConstraintTree::getFirstConflict() const
 {
-    if(this->solution.size() <= 1)
+    if(!this->conflictKnown)
+    {
+        std::vector<Conflict> conflicts = this->findConflicts(true);
+        if(!conflicts.empty())
+        {
+            this->firstConflict.emplace(conflicts.front());
+        }
+        this->conflictKnown = true;
+    }
+    return this->firstConflict;
+}
+std::vector<Conflict> ConstraintTree::getConflicts() const
+{
+    return this->findConflicts(false);
+}
+std::vector<Conflict> ConstraintTree::findConflicts(bool pFirstOnly) const
+{
+    std::vector<Conflict> nodeConflicts;
+    std::vector<Conflict> swapConflicts;
+    if(!this->solvable)
     {
         /*There can't be any conflict per definition*/
-        return {};
+        return nodeConflicts;
     }
 
-    unsigned int timeCntr = 1;
-    /*Count until the maximum time; A std::map is sorted thus take the last element as maximum;
-    We can start at 1, as the initial position does not matter and can not cause a conflict;
-    Search for node conflicts first*/
-    for(timeCntr=1; timeCntr <= this->solution.rbegin()->first; timeCntr++)
+    std::vector<const AgentState*> states = this->getStates();
+    size_t makespan = 0;
+    for(const AgentState* s : states)
+    {
+        makespan = std::max(makespan, s->path.size() - 1);
+    }
+
+    /*Agents wait on their target after reaching it*/
+    auto at = [](const AgentState* pState, size_t pTimestep) {
+        return pState->path[std::min(pTimestep, pState->path.size() - 1)];
+    };
+
+    /*The agent on every occupied node and the agent on every traversed edge (packed as <from> << 32 | <to>) of the current
+    timestep*/
+    std::unordered_map<NodeId, unsigned int> occupancy;
+    std::unordered_multimap<uint64_t, const AgentState*> moves;
+    occupancy.reserve(states.size());
+    moves.reserve(states.size());
+
+    /*We can start at 1, as the initial position does not matter and can not cause a conflict*/
+    for(size_t timeCntr = 1; timeCntr <= makespan; timeCntr++)
     {
-        /*Invert the mapping to detect collisions*/
-        std::map<NodeType, unsigned int> nodeAssignments;
-        if(this->solution.count(timeCntr) > 0)
+        occupancy.clear();
+        moves.clear();
+        for(const AgentState* s : states)
         {
-            if(this->solution.at(timeCntr).size() < this->agentTasks.size())
+            const NodeId node = at(s, timeCntr);
+            std::pair<std::unordered_map<NodeId, unsigned int>::iterator, bool> inserted = occupancy.try_emplace(node, s->agent);
+            if(!inserted.second)
             {
-                /*At least one agent has to be missing*/
-                throw(std::runtime_error("Invalid solution: Not all agents have an assignment at at least one timestep!"));
-            }
-            for(const auto& agentPos : this->solution.at(timeCntr))
-            {
-                if(nodeAssignments.count(agentPos.second) > 0)
+                /*Collision as the node is already taken*/
+                const NodeType& name = this->planner->getNodeName(node);
+                nodeConflicts.push_back(Conflict(timeCntr, inserted.first->second, s->agent, name, name));
+                if(pFirstOnly)
                 {
-                    /*Collision as the node is already taken -> return the conflict*/
-                    return Conflict(timeCntr, nodeAssignments.at(agentPos.second), agentPos.first, agentPos.second, agentPos.second);
-                }
-                else
-                {
-                    /*Store the assignment of the current agent to the node*/
-                    nodeAssignments[agentPos.second] = agentPos.first;
+                    return nodeConflicts;
                 }
             }
+
+            const NodeId previous = at(s, timeCntr - 1);
+            if(previous != node)
+            {
+                moves.emplace(static_cast<uint64_t>(previous) << 32 | node, s);
+            }
         }
-        else
+
+        if(pFirstOnly && !swapConflicts.empty())
         {
-            throw(std::runtime_error("Invalid solution: interrupted timeline!"));
+            /*Only a node conflict could come before the known swap conflict*/
+            continue;
         }
-    }
-    /*Check swap/edge conflicts; We need to start at 0 now to check for swapping at the beginning
-    but we only have to consider all steps before the last one as at least one step is necessary
-    to create such collisions*/
-    for(timeCntr=0; timeCntr + 1 <= this->solution.rbegin()->first; timeCntr++)
-    {
-        /*No need to check for existence as we already did that in the previous loop*/
-        const std::map<unsigned int, NodeType>& step = this->solution.at(timeCntr);
-        const std::map<unsigned int, NodeType>& next = this->solution.at(timeCntr+1);
-
-        for(const auto& agent : this->agentTasks)
+        for(const AgentState* s : states)
         {
-            for(const auto& agent2 : this->agentTasks)
+            const NodeId previous = at(s, timeCntr - 1);
+            const NodeId node = at(s, timeCntr);
+            if(previous == node)
             {
-                if(agent == agent2)
-                {
-                    continue;
-                }
-                else
+                continue;
+            }
+            /*Every agent which traverses the edge in the opposite direction swapped positions with s; Agents only share an edge
+            if they also have a node conflict, so there is usually at most one*/
+            std::vector<const AgentState*> partners;
+            std::pair<std::unordered_multimap<uint64_t, const AgentState*>::const_iterator, std::unordered_multimap<uint64_t, const AgentState*>::const_iterator> reverse = moves.equal_range(static_cast<uint64_t>(node) << 32 | previous);
+            for(std::unordered_multimap<uint64_t, const AgentState*>::const_iterator m = reverse.first; m != reverse.second; m++)
+            {
+                if(m->second->index > s->index)
                 {
-                    if(step.at(agent.first) == next.at(agent2.first) && next.at(agent.first) == step.at(agent2.first))
-                    {
-                        /*They switched positions -> report the conflict; Read as: Either agent.first shall not be on the node
-                        next.at(agent.first) or agent2 shall not be on the node step.at(agent.first) at timestep timeCntr*/
-                        return Conflict(timeCntr + 1, agent.first, agent2.first, next.at(agent.first), step.at(agent.first));
-                    }
+                    partners.push_back(m->second);
                 }
             }
+            std::sort(partners.begin(), partners.end(), [](const AgentState* pLhs, const AgentState* pRhs) { return pLhs->index < pRhs->index; });
+            for(const AgentState* partner : partners)
+            {
+                /*They switched positions -> report the conflict; Read as: Either s shall not be on the node it enters or the
+                partner shall not be on the node s leaves at timestep timeCntr*/
+                swapConflicts.push_back(Conflict(timeCntr, s->agent, partner->agent, this->planner->getNodeName(node), this->planner->getNodeName(previous)));
+            }
+            if(pFirstOnly && !swapConflicts.empty())
+            {
+                break;
+            }
         }
     }
 
-    /*Collision free*/
-    return {};
+    /*Node conflicts come first*/
+    nodeConflicts.insert(nodeConflicts.end(), swapConflicts.begin(), swapConflicts.end());
+    return nodeConflicts;
 }
-void ConstraintTree::calculateSolution(std::function<double(NodeType, NodeType)> pH)
+void ConstraintTree::calculateSolution()
 {
-    /*Reinitialize the sum with 0 as we recalculate it*/
-    this->costSum = 0.0;
-    this->solution.clear();
-
-    for(const std::pair<unsigned int, std::pair<NodeType, NodeType>>& currentAgentTask : this->agentTasks)
+    unsigned int index = 0;
+    for(const std::pair<const unsigned int, std::pair<NodeType, NodeType>>& currentAgentTask : this->agentTasks)
     {
-        /*For every agent calculate a new path which mets the constraints of this tree node*/
-        std::vector<NodeType> path = this->graph.getShortestPath(currentAgentTask.second.first, 
-                                                                currentAgentTask.second.second, 
-                                                                pH, 
-                                                                std::set<NodeType>(), 
-                                                                getConstraintsForAgent(currentAgentTask.first));
+        /*For every agent calculate a new path*/
+        std::vector<NodeId> path = this->findPath(currentAgentTask.first, noConstraints);
         if(path.empty())
         {
-            this->solution.clear();
+            this->solvable = false;
         }
         #if TEST_PATHFINDING
-        if(!this->validateLowLevelPathfinding(currentAgentTask.first, path))
+        if(!this->validateLowLevelPathfinding(noConstraints, path))
         {
             throw("The low level path finding algorithm calculated a path which ignores at least one constraint!");
         }
         #endif
 
-        this->costs[currentAgentTask.first] = this->graph.getPathCost(path);
-        this->costSum += this->costs[currentAgentTask.first];
-
-        unsigned int t;
-        for(t = 0; t < path.size(); t++)
-        {
-            this->solution[t][currentAgentTask.first] = path[t];
-        }
+        this->pushState(currentAgentTask.first, index++, std::nullopt, path);
+        this->costSum += this->state->cost;
     }
-    /*Fill up the paths of all agents until they are of the same length (if an entry is missing it means that the agent
-    waited on the node he was before as his path was shorter)*/
-    this->pumpUpSolution();
-    
-    this->hashValue = this->hash();
 }
-void ConstraintTree::updateSolution(unsigned int pAgent, std::function<double(NodeType, NodeType)> pH)
+void ConstraintTree::updateSolution(const Constraint& pConstraint)
 {
-    for(std::pair<const unsigned int, std::map<unsigned int, NodeType>>& step : this->solution)
+    const AgentState& current = this->getState(pConstraint.getAgent());
+
+    /*The tree nodes only store their own constraint, so the table of the agent is rebuilt from the records for the replanning; A
+    node which is not part of the graph can not be entered anyway*/
+    ReservationTable constraints = this->getConstraintsForAgent(pConstraint.getAgent());
+    std::optional<ConstraintKey> key;
+    NodeId node = this->planner->getNodeId(pConstraint.getNode());
+    if(node != CompactGraph::INVALID_NODE)
     {
-        step.second.erase(pAgent);
+        key.emplace(ConstraintKey{pConstraint.getAgent(), pConstraint.getTimestep(), node});
+        if(constraints.reserveNode(node, pConstraint.getTimestep()))
+        {
+            /*An ancestor might already have added the same constraint*/
+            this->addToFingerprint(key.value());
+        }
     }
 
-    std::pair<NodeType, NodeType> task = this->agentTasks.at(pAgent);
-    std::vector<NodeType> path = this->graph.getShortestPath(task.first, 
-                                                            task.second, 
-                                                            pH, 
-                                                            std::set<NodeType>(),
-                                                            getConstraintsForAgent(pAgent));
+    std::vector<NodeId> path = this->findPath(pConstraint.getAgent(), constraints);
     if(path.empty())
     {
-        this->solution.clear();
+        this->solvable = false;
+        return;
     }
-    else
+    #if TEST_PATHFINDING
+    if(!this->validateLowLevelPathfinding(constraints, path))
     {
-        #if TEST_PATHFINDING
-        if(!this->validateLowLevelPathfinding(pAgent, path))
-        {
-            path = this->graph.getShortestPath(task.first, 
-                                                            task.second, 
-                                                            pH, 
-                                                            std::set<NodeType>(),
-                                                            getConstraintsForAgent(pAgent));
-            throw("The low level path finding algorithm calculated a path which ignores at least one constraint!");
-        }
-        #endif
-
-        double oldCost = this->costs[pAgent];
-        this->costs[pAgent] = this->graph.getPathCost(path);
-        this->costSum += (this->costs[pAgent] - oldCost);
-
-        unsigned int t;
-        for(t = 0; t < path.size(); t++)
-        {
-            this->solution[t][pAgent] = path[t];
-        }
-
-        this->pumpUpSolution();
+        throw("The low level path finding algorithm calculated a path which ignores at least one constraint!");
+    }
+    #endif
 
-        this->hashValue = this->hash();
+    const double oldCost = current.cost;
+    this->pushState(pConstraint.getAgent(), current.index, key, path);
+    this->costSum += (this->state->cost - oldCost);
+}
+std::vector<NodeId> ConstraintTree::findPath(unsigned int pAgent, const ReservationTable& pConstraints) const
+{
+    const std::pair<NodeType, NodeType>& task = this->agentTasks.at(pAgent);
+    NodeId start = this->planner->getNodeId(task.first);
+    NodeId target = this->planner->getNodeId(task.second);
+    if(start == CompactGraph::INVALID_NODE || target == CompactGraph::INVALID_NODE)
+    {
+        return std::vector<NodeId>();
     }
+    return this->planner->findPath(start, target, pConstraints);
 }
-void ConstraintTree::printConstraints() const
+void ConstraintTree::pushState(unsigned int pAgent, unsigned int pIndex, std::optional<ConstraintKey> pConstraint, const std::vector<NodeId>& pPath)
 {
-    std::cout << "{";
-    for(const auto& c : this->constraints)
+    std::pmr::polymorphic_allocator<AgentState> allocator(this->memory.get());
+    std::pmr::vector<NodeId> path(pPath.begin(), pPath.end(), allocator);
+    const double cost = pPath.empty() ? 0.0 : this->planner->getPathCost(pPath);
+    this->state = std::allocate_shared<AgentState>(allocator, this->state, pAgent, pIndex, pConstraint, std::move(path), cost);
+}
+const ConstraintTree::AgentState& ConstraintTree::getState(unsigned int pAgent) const
+{
+    for(const AgentState* s = this->state.get(); s != nullptr; s = s->parent.get())
     {
-        std::cout << "(" << c.first << ": ";
-        for(const auto& c2 : c.second)
+        if(s->agent == pAgent)
         {
-            std::cout << "(" << c2.first << ": {";
-            for(const auto& c3 : c2.second)
-            {
-                std::cout << c3 << " ";
-            }
-            std::cout << "})";
+            return *s;
         }
-        std::cout << ") ";
     }
-    std::cout << "}" << std::endl;
+    throw(std::runtime_error("ConstraintTree::getState(): Unknown agent " + std::to_string(pAgent)));
 }
-std::map<unsigned int, std::set<NodeType>> ConstraintTree::getConstraintsForAgent(unsigned int pAgent) const
+std::vector<const ConstraintTree::AgentState*> ConstraintTree::getStates() const
 {
-    if(this->constraints.count(pAgent) > 0)
+    std::vector<const AgentState*> result(this->agentTasks.size(), nullptr);
+    size_t missing = result.size();
+    for(const AgentState* s = this->state.get(); s != nullptr && missing > 0; s = s->parent.get())
     {
-        return this->constraints.at(pAgent);
-    }
-    else
-    {
-        return std::map<unsigned int, std::set<NodeType>>();
+        if(result[s->index] == nullptr)
+        {
+            result[s->index] = s;
+            missing--;
+        }
     }
+    return result;
 }
-size_t ConstraintTree::hash() const
+void ConstraintTree::printConstraints() const
 {
-    size_t last = 0;
-    bool first = true;
-    for(const auto& agent : this->constraints)
+    /*The keys are sorted by agent, so the constraints of an agent are printed as one group*/
+    std::vector<ConstraintKey> keys = this->getConstraintKeys();
+    std::cout << "{";
+    for(size_t i = 0; i < keys.size(); i++)
     {
-        for(const auto& timestep : this->constraints.at(agent.first))
+        if(i == 0 || keys[i].agent != keys[i - 1].agent)
         {
-            for(const auto& node : this->constraints.at(agent.first).at(timestep.first))
-            {
-                Constraint c(timestep.first, agent.first, node);
-                if(first)
-                {
-                    last = c.hash();
-                    first = false;
-                }
-                else
-                {
-                    last = hashCombine(last, c.hash());
-                }
-            }
+            std::cout << "(" << keys[i].agent << ": ";
+        }
+        std::cout << "(" << keys[i].timestep << ": " << this->planner->getNodeName(keys[i].node) << ")";
+        if(i + 1 == keys.size() || keys[i + 1].agent != keys[i].agent)
+        {
+            std::cout << ") ";
         }
     }
-    return last;
+    std::cout << "}" << std::endl;
 }
-bool ConstraintTree::validateLowLevelPathfinding(unsigned int pAgent, const std::vector<NodeType>& pPath) const
+ReservationTable ConstraintTree::getConstraintsForAgent(unsigned int pAgent) const
 {
-    unsigned int cntr = 0;
-    std::map<unsigned int, std::set<NodeType>> constraints = this->getConstraintsForAgent(pAgent);
-    if(constraints.empty())
-    {
-        return true;
-    }
-    for(cntr=0; cntr<pPath.size(); cntr++)
+    ReservationTable result;
+    for(const AgentState* s = this->state.get(); s != nullptr; s = s->parent.get())
     {
-        NodeType node = pPath[cntr];
-        if(constraints.count(cntr) > 0)
+        if(s->agent == pAgent && s->constraint.has_value())
         {
-            if(constraints[cntr].count(node) > 0)
-            {
-                return false;
-            }
+            result.reserveNode(s->constraint->node, s->constraint->timestep);
         }
     }
-    return true;
-}
-size_t ConstraintTree::getHash() const
-{
-    return this->hashValue;
+    return result;
 }
-void ConstraintTree::pumpUpSolution()
+std::vector<ConstraintTree::ConstraintKey> ConstraintTree::getConstraintKeys() const
 {
-    unsigned int timeCntr = 1;
-    for(timeCntr=1; timeCntr <= this->solution.rbegin()->first; timeCntr++)
+    std::vector<ConstraintKey> result;
+    for(const AgentState* s = this->state.get(); s != nullptr; s = s->parent.get())
     {
-        if(this->solution.count(timeCntr) > 0)
+        if(s->constraint.has_value())
         {
-            for(const auto& agent : this->agentTasks)
-            {
-                if(this->solution.at(timeCntr).count(agent.first) == 0)
-                {
-                    this->solution.at(timeCntr)[agent.first] = this->solution.at(timeCntr-1).at(agent.first);
-                }
-            }
-        }
-        else
-        {
-            throw(std::runtime_error("Invalid solution: Timeline interrupted!"));
+            result.push_back(s->constraint.value());
         }
     }
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
 }
-void ConstraintTree::addConstraint(Constraint pConstraint)
+void ConstraintTree::addToFingerprint(const ConstraintKey& pKey)
 {
-    this->constraints[pConstraint.getAgent()][pConstraint.getTimestep()].insert(pConstraint.getNode());
+    /*The halves hash differently packed keys, so a collision in one half does not imply one in the other*/
+    this->fingerprint.high += mix(mix((static_cast<uint64_t>(pKey.agent) << 32 | pKey.timestep) + 0x9e3779b97f4a7c15ULL) + pKey.node);
+    this->fingerprint.low += mix(mix((static_cast<uint64_t>(pKey.timestep) << 32 | pKey.node) ^ 0xd6e8feb86659fd93ULL) + pKey.agent);
 }
-std::map<unsigned int, std::map<unsigned int, NodeType>> ConstraintTree::getSolution() const
+bool ConstraintTree::validateLowLevelPathfinding(const ReservationTable& pConstraints, const std::vector<NodeId>& pPath) const
 {
-    return this->solution;
+    return pConstraints.isPathAllowed(pPath);
 }
-double ConstraintTree::getCostSum() const
+const Fingerprint& ConstraintTree::getFingerprint() const
 {
-    return this->costSum;
+    return this->fingerprint;
 }
-bool ConstraintTree::operator<(const ConstraintTree& pOther) const
+std::map<unsigned int, std::map<unsigned int, NodeType>> ConstraintTree::getSolution() const
 {
-    if(this->costSum < pOther.costSum)
+    std::map<unsigned int, std::map<unsigned int, NodeType>> solution;
+    if(!this->solvable)
     {
-        return true;
+        return solution;
     }
-    else if(this->costSum == pOther.costSum)
-    {
-        if(this->hashValue < pOther.hashValue)
-        {
-            return true;
-        }
-        else if(this->hashValue == pOther.hashValue)
-        {
-            /*Maybe equal*/
-            std::set<Constraint> thisConstraints;
-            std::set<Constraint> otherConstraints;
 
-            for(const auto& agent : this->constraints)
-            {
-                for(const auto& timestep : this->constraints.at(agent.first))
-                {
-                    for(const auto& node : this->constraints.at(agent.first).at(timestep.first))
-                    {
-                        thisConstraints.insert(Constraint(timestep.first, agent.first, node));
-                    }
-                }
-            }
-            for(const auto& agent : pOther.constraints)
-            {
-                for(const auto& timestep : pOther.constraints.at(agent.first))
-                {
-                    for(const auto& node : pOther.constraints.at(agent.first).at(timestep.first))
-                    {
-                        otherConstraints.insert(Constraint(timestep.first, agent.first, node));
-                    }
-                }
-            }
-
-            std::set<Constraint>::iterator c1 = thisConstraints.begin();
-            std::set<Constraint>::iterator c2 = otherConstraints.begin();
-
-            while(true)
-            {
-                if(c1 == thisConstraints.end())
-                {
-                    if(c2 == otherConstraints.end())
-                    {
-                        /*Equal -> return false*/
-                        return false;
-                    }
-                    else
-                    {
-                        return true;
-                    }
-                }
-                else if(c2 == otherConstraints.end())
-                {
-                    /*c1 is not at end -> c2 has less elements and is thus "smaller"*/
-                    return false;
-                }
-                else
-                {
-
-                    if(*c1 < *c2)
-                    {
-                        return true;
-                    }
-                    else if(*c2 < *c1)
-                    {
-                        return false;
-                    }
-                    else
-                    {
-                        c1++;
-                        c2++;
-                    }
-                }
-            }
-        }
-        else
+    /*Fill up the paths of all agents until they are of the same length (the agent waits on its target)*/
+    std::vector<const AgentState*> states = this->getStates();
+    size_t makespan = 0;
+    for(const AgentState* s : states)
+    {
+        makespan = std::max(makespan, s->path.size() - 1);
+    }
+    for(const AgentState* s : states)
+    {
+        for(size_t t = 0; t <= makespan; t++)
         {
-            return false;
+            solution[t][s->agent] = this->planner->getNodeName(s->path[std::min(t, s->path.size() - 1)]);
         }
     }
-    else
+    return solution;
+}
+double ConstraintTree::getCostSum() const
+{
+    return this->costSum;
+}
+bool ConstraintTree::operator<(const ConstraintTree& pOther) const
+{
+    if(this->costSum != pOther.costSum)
     {
-        return false;
+        return this->costSum < pOther.costSum;
+    }
+    if(!(this->fingerprint == pOther.fingerprint))
+    {
+        return this->fingerprint < pOther.fingerprint;
     }
+    /*Maybe equal; Only then the constraints are collected from the records, the sorted lists can be compared directly*/
+    return this->getConstraintKeys() < pOther.getConstraintKeys();
 }
 bool ConstraintTree::hasSolution() const
 {
-    return !this->solution.empty();
+    return this->solvable;
 }
\ No newline at end of file
@@ -13,8 +13,13 @@
 #define CONSTRAINT_TREE_HPP_INCLUDED
 
 #include "CBS.hpp"
+#include "graph/LowLevelPlanner.hpp"
+#include <cstdint>
 #include <tuple>
 #include <optional>
+#include <memory>
+#include <memory_resource>
+#include <vector>
 
 /**
  * @brief A constraint is a restriction for the pathfinding algorithm: It stores the information that a specific agent is not allowed to enter a specific node
@@ -138,11 +143,48 @@ protected:
      std::tuple<unsigned int, unsigned int, unsigned int, NodeType, NodeType> t;
 };
 
+/**
+ * @brief A 128 bit fingerprint of the constraints of a constraint tree node; Tree nodes with the same constraints have the same
+ * fingerprint, two different sets of constraints collide with a probability of about 2^-128
+ * 
+ */
+struct Fingerprint
+{
+    uint64_t high;
+    uint64_t low;
+
+    bool operator==(const Fingerprint& pOther) const
+    {
+        return this->high == pOther.high && this->low == pOther.low;
+    }
+
+    bool operator<(const Fingerprint& pOther) const
+    {
+        return this->high != pOther.high ? this->high < pOther.high : this->low < pOther.low;
+    }
+};
+
+/**
+ * @brief Hashes a fingerprint (e.g. for std::unordered_set); The fingerprint is already well mixed, so one half is used directly
+ * 
+ */
+struct FingerprintHash
+{
+    size_t operator()(const Fingerprint& pFingerprint) const
+    {
+        return static_cast<size_t>(pFingerprint.low);
+    }
+};
+
 /**
  * @brief The ConstraintTree is used by the high level algorithm of CBS (collision based search) and stores constraints as a binary tree:
  * If a collision between two agents occurs, there are two options to prevent it: Either agent 1 shall not be allowed to be on the node which
  * caused the collision or agent 2 isn't allowed to. This "options" are stored in this tree structure.  
  * 
+ * A tree node only stores what changed against its parent: The new constraint and the replanned path of the constrained agent.
+ * Everything else is shared with the ancestors through reference counted, immutable records which are allocated from a pool shared
+ * by the whole tree, so the memory of a tree node does not grow with the number of agents or constraints. The constraints of an
+ * agent are only collected from the records when the agent is replanned.
  */
 class ConstraintTree
 {
@@ -150,10 +192,10 @@ public:
     /**
      * @brief Construct a new root for a constraint tree
      * 
-     * @param pGraph The graph to be used in the constraint tree
+     * @param pPlanner The low level planner which knows the graph of the MAPF problem; Shared by the whole tree
      * @param pAgentTasks The agents and their missions
      */
-    ConstraintTree(const Graph& pGraph, const std::map<unsigned int, std::pair<NodeType, NodeType>>& pAgentTasks, std::function<double(NodeType, NodeType)> pH=[](NodeType, NodeType){ return 0.0; });
+    ConstraintTree(std::shared_ptr<const LowLevelPlanner> pPlanner, const std::map<unsigned int, std::pair<NodeType, NodeType>>& pAgentTasks);
 
     /**
      * @brief Construct a new child tree
@@ -163,7 +205,7 @@ public:
      * @param pTimestepConstraint The timestep of the additional constraint
      * @param pNodeConstraint The node of the additional constraint
      */
-    ConstraintTree(const ConstraintTree& pParent, Constraint pConstraint, std::function<double(NodeType, NodeType)> pH=[](NodeType, NodeType){ return 0.0; });
+    ConstraintTree(const ConstraintTree& pParent, Constraint pConstraint);
 
     /**
      * @brief Returns the cost sum over all agents
@@ -173,11 +215,12 @@ public:
     double getCostSum() const;
 
     /**
-     * @brief Compares two constraint trees (e.g. to create an order in a set that makes sense)
+     * @brief Compares two constraint trees (e.g. to order an open list); Ties in the costs are broken by the fingerprint and then
+     * by the sorted constraints, so only tree nodes with the same constraints are equivalent
      * 
      * @param pOther The other ConstraintTree to compare against this one
-     * @return true The other ConstraintTree has either a bigger cost, a bigger hash value of more or bigger constraints
-     * @return false The other ConstraintTree has the same or a lower cost sum, a smaller or equal hash value and less or smaller constraints
+     * @return true The other ConstraintTree has either a bigger cost, a bigger fingerprint or more or bigger constraints
+     * @return false The other ConstraintTree has the same or a lower cost sum, a smaller or equal fingerprint and less or smaller constraints
      */
     bool operator<(const ConstraintTree& pOther) const;
 
@@ -190,25 +233,36 @@ public:
     bool hasSolution() const;
 
     /**
-     * @brief Finds the first conflict in the solution and returns it (if it exists)
+     * @brief Finds the first conflict in the solution and returns it (if it exists); Node conflicts come before swap conflicts,
+     * conflicts of the same kind are ordered by their timestep. The result is cached, so a tree node must not be used by multiple
+     * threads at once.
      * 
-     * @return std::optional<std::tuple<unsigned int, unsigned int, unsigned int, NodeType>>
+     * @return std::optional<Conflict> The first conflict or an empty optional if the solution is collision free
      */
     std::optional<Conflict> getFirstConflict() const;
 
     /**
-     * @brief Returns the solution of this ConstraintTree as a vector of Steps
+     * @brief Finds all conflicts in the solution in the order used by getFirstConflict(); Every swap is reported once
+     * 
+     * @return std::vector<Conflict> All conflicts
+     */
+    std::vector<Conflict> getConflicts() const;
+
+    /**
+     * @brief Returns the solution of this ConstraintTree as a vector of Steps; Agents which reached their target wait there until
+     * the last agent arrived
      * 
      * @return std::map<unsigned int, std::map<unsigned int, NodeType>> Represents the solution of this ConstraintTree as mapping time -> agent -> node
      */
     std::map<unsigned int, std::map<unsigned int, NodeType>> getSolution() const;
 
     /**
-     * @brief Returns the hash value of this ConstraintTree
+     * @brief Returns the fingerprint of the constraints of this ConstraintTree; Used to detect tree nodes which were already
+     * generated
      * 
-     * @return size_t Hash value
+     * @return const Fingerprint& The fingerprint
      */
-    size_t getHash() const;
+    const Fingerprint& getFingerprint() const;
 
     /**
      * @brief Pretty prints the constraints which are represented by this tree
@@ -217,88 +271,199 @@ public:
     void printConstraints() const;
 protected:
     /**
-     * @brief This function calculates a has value for the whole ConstraintTree
+     * @brief A constraint with the node as ID; The sorted list of these is the canonical form of the
+     * constraints of a tree node
      * 
-     * @return size_t Hash value
      */
-    size_t hash() const;
+    struct ConstraintKey
+    {
+        unsigned int agent;
+        unsigned int timestep;
+        NodeId node;
+
+        bool operator==(const ConstraintKey& pOther) const
+        {
+            return this->agent == pOther.agent && this->timestep == pOther.timestep && this->node == pOther.node;
+        }
+
+        bool operator<(const ConstraintKey& pOther) const
+        {
+            return std::tie(this->agent, this->timestep, this->node) < std::tie(pOther.agent, pOther.timestep, pOther.node);
+        }
+    };
+
+    /**
+     * @brief The constraint and the path of one agent as set by a tree node; Immutable once created and shared by all
+     * descendants
+     * 
+     */
+    struct AgentState
+    {
+        AgentState(std::shared_ptr<const AgentState> pParent, unsigned int pAgent, unsigned int pIndex, std::optional<ConstraintKey> pConstraint, std::pmr::vector<NodeId>&& pPath, double pCost)
+        : parent(pParent), agent(pAgent), index(pIndex), constraint(pConstraint), path(std::move(pPath)), cost(pCost)
+        {
+
+        }
+
+        /**
+         * @brief The record created before this one (by this tree node or one of its ancestors); nullptr for the first agent of
+         * the root
+         * 
+         */
+        std::shared_ptr<const AgentState> parent;
+
+        /**
+         * @brief The ID of the agent
+         * 
+         */
+        unsigned int agent;
+
+        /**
+         * @brief The position of the agent in the agent tasks
+         * 
+         */
+        unsigned int index;
+
+        /**
+         * @brief The constraint added by the tree node; Empty for the records of the root and for constraints on nodes which are
+         * not part of the graph. The constraints of the agent are the ones of all its records
+         * 
+         */
+        std::optional<ConstraintKey> constraint;
+
+        /**
+         * @brief The path of the agent (one node per timestep) or an empty vector if there is none
+         * 
+         */
+        std::pmr::vector<NodeId> path;
+
+        /**
+         * @brief The costs of the path
+         * 
+         */
+        double cost;
+    };
 
     /**
-     * @brief Calculates a completely new solution based on the constraints, the agent tasks and the underlying graph
-     * @param pH Heuristic to use for A*
+     * @brief Calculates a completely new solution based on the agent tasks and the underlying graph (root node)
      */
-    void calculateSolution(std::function<double(NodeType, NodeType)> pH);
+    void calculateSolution();
+
     /**
-     * @brief Performs the necessary steps to update the path for a single agent; This can be used if only one constraint was added
+     * @brief Adds a constraint and recalculates the path of the constrained agent; This can be used if only one constraint was
+     * added
      * 
-     * @param pAgent The agent to do the recalculation for
-     * @param pH Heuristic to use for A*
+     * @param pConstraint The new constraint
      */
-    void updateSolution(unsigned int pAgent,std::function<double(NodeType, NodeType)> pH);
+    void updateSolution(const Constraint& pConstraint);
 
     /**
-     * @brief As the low level pathfinding algorithm returns a path which is only as long as it has to, this functions is used to
-     * bring all paths of the agents to the same length (in order to construct a plan).
+     * @brief Runs the low level path finding algorithm for an agent under a set of constraints
+     * 
+     * @param pAgent The agent to calculate the path for
+     * @param pConstraints The constraints of the agent
+     * @return std::vector<NodeId> The path of the agent or an empty vector if there is none
      */
-    void pumpUpSolution();
+    std::vector<NodeId> findPath(unsigned int pAgent, const ReservationTable& pConstraints) const;
 
     /**
-     * @brief Returns the constraints specified for the specified agent
+     * @brief Adds the record of an agent on top of the records of this tree node
      * 
-     * @param pAgent The agent for which to get the constraints for
-     * @return std::map<unsigned int, std::set<NodeType>> The constraints of the agent
+     * @param pAgent The ID of the agent
+     * @param pIndex The position of the agent in the agent tasks
+     * @param pConstraint The constraint added for the agent, if any
+     * @param pPath The path of the agent
+     */
+    void pushState(unsigned int pAgent, unsigned int pIndex, std::optional<ConstraintKey> pConstraint, const std::vector<NodeId>& pPath);
+
+    /**
+     * @brief Returns the current record of an agent
+     * 
+     * @param pAgent The ID of the agent
+     * @return const AgentState& The latest record of the agent
+     */
+    const AgentState& getState(unsigned int pAgent) const;
+
+    /**
+     * @brief Returns the current records of all agents
+     * 
+     * @return std::vector<const AgentState*> The latest record of every agent, in the order of the agent tasks
+     */
+    std::vector<const AgentState*> getStates() const;
+
+    /**
+     * @brief Detects conflicts in a single pass over the timesteps: The occupied nodes and the traversed edges of a timestep are
+     * hashed, so every agent position is only looked up once and the costs are linear in <number of agents> * <makespan>
+     * 
+     * @param pFirstOnly Stop as soon as the first conflict (in the order of getFirstConflict()) is known
+     * @return std::vector<Conflict> The conflicts in the order of getFirstConflict(); Only the first one if pFirstOnly is set
+     */
+    std::vector<Conflict> findConflicts(bool pFirstOnly) const;
+
+    /**
+     * @brief Adds a constraint to the fingerprint; Must only be called once per constraint
+     * 
+     * @param pKey The constraint
+     */
+    void addToFingerprint(const ConstraintKey& pKey);
+
+    /**
+     * @brief Collects the constraints of all agents from the records
+     * 
+     * @return std::vector<ConstraintKey> All constraints, sorted and without duplicates
      */
-    std::map<unsigned int, std::set<NodeType>> getConstraintsForAgent(unsigned int pAgent) const;
+    std::vector<ConstraintKey> getConstraintKeys() const;
 
     /**
-     * @brief Adds a constraint for an agent
+     * @brief Collects the constraints specified for the specified agent from the records
      * 
-     * @param pAgent The agent which shall be constrained
-     * @param pTimestep The timestep at which the agent pAgent is not allowed on the node pNode
-     * @param pNode The node which can not be entered by the agent pAgent on timestep pTimestep
+     * @param pAgent The agent for which to get the constraints for
+     * @return ReservationTable The constraints of the agent as reservation table
      */
-    void addConstraint(Constraint pConstraint);
+    ReservationTable getConstraintsForAgent(unsigned int pAgent) const;
 
     /**
      * @brief This function checks a path calculated by the low level path finding algorithm for validity (are all constraints met?)
      * 
-     * @param pAgent The agent for which the path was calculated
+     * @param pConstraints The constraints of the agent for which the path was calculated
      * @param pPath The path which was calculated by the low level path finding algorithm
      * @return true The path mets all constraints
      * @return false The path is invalid as at least one constraint is ignored
      */
-    bool validateLowLevelPathfinding(unsigned int pAgent, const std::vector<NodeType>& pPath) const;
+    bool validateLowLevelPathfinding(const ReservationTable& pConstraints, const std::vector<NodeId>& pPath) const;
 
     /**
-     * @brief Maps an Agent ID to a map which in turn maps timesteps to nodes he shall not enter at that timestep 
-     * (agent -> timestep -> set of nodes he shall not enter)
+     * @brief Stores a mapping, which maps each agent to a pair (<start node>, <target node>)
      * 
      */
-    std::map<unsigned int, std::map<unsigned int, std::set<NodeType>>> constraints;
+    const std::map<unsigned int, std::pair<NodeType, NodeType>>& agentTasks;
 
     /**
-     * @brief Stores the solution as a mapping timestep -> agent -> node
+     * @brief The low level planner; It knows the underlying graph of the MAPF problem and defines the node IDs used in the
+     * reservation tables
      * 
      */
-    std::map<unsigned int, std::map<unsigned int, NodeType>> solution;
+    std::shared_ptr<const LowLevelPlanner> planner;
 
     /**
-     * @brief Stores a mapping, which maps each agent to a pair (<start node>, <target node>)
+     * @brief The pool the agent records of the whole tree are allocated from; Declared before them, so it outlives them
      * 
      */
-    const std::map<unsigned int, std::pair<NodeType, NodeType>>& agentTasks;
+    std::shared_ptr<std::pmr::synchronized_pool_resource> memory;
 
     /**
-     * @brief The underlying graph of the MAPF problem
+     * @brief The latest agent record of this tree node; Following the parents yields the records of all agents, the first one
+     * found for an agent is its current state
      * 
      */
-    const Graph& graph;
+    std::shared_ptr<const AgentState> state;
 
     /**
-     * @brief Maps an agent ID to its path cost using the solution in this ContraintTree
+     * @brief The fingerprint of the constraints of all agents; The sum of a 128 bit hash of every constraint, so it can be updated when a
+     * constraint is added
      * 
      */
-    std::map<unsigned int, double> costs;
+    Fingerprint fingerprint;
 
     /**
      * @brief The sum of the costs of all agent paths
@@ -307,10 +472,17 @@ protected:
     double costSum;
 
     /**
-     * @brief Stores a hash value to make comparisons faster
+     * @brief Set if every agent has a path
+     * 
+     */
+    bool solvable;
+
+    /**
+     * @brief The cached result of getFirstConflict(); Only valid if conflictKnown is set
      * 
      */
-    size_t hashValue;
+    mutable std::optional<Conflict> firstConflict;
+    mutable bool conflictKnown;
 };
 
 #endif /*CONSTRAINT_TREE_HPP_INCLUDED*/
\ No newline at end of file
@@ -0,0 +1,114 @@
+/**
+ * @file MappedFile.cpp
+ * @author Lennart Hustermeier (lennart.hustermeier@gmx.de)
+ * @brief Contains the implementation of the read-only file mapping for Linux and Windows
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "MappedFile.hpp"
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <windows.h>
+
+MappedFile::MappedFile(const std::string& pPath)
+: data(nullptr), size(0), mapping(nullptr)
+{
+    HANDLE file = CreateFileA(pPath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if(file == INVALID_HANDLE_VALUE)
+    {
+        throw(std::runtime_error("MappedFile::MappedFile(): Can not open " + pPath + "!"));
+    }
+    LARGE_INTEGER fileSize;
+    if(!GetFileSizeEx(file, &fileSize))
+    {
+        CloseHandle(file);
+        throw(std::runtime_error("MappedFile::MappedFile(): Can not determine the size of " + pPath + "!"));
+    }
+    this->size = static_cast<size_t>(fileSize.QuadPart);
+    if(this->size > 0)
+    {
+        this->mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if(this->mapping == nullptr)
+        {
+            CloseHandle(file);
+            throw(std::runtime_error("MappedFile::MappedFile(): Can not map " + pPath + "!"));
+        }
+        this->data = static_cast<const uint8_t*>(MapViewOfFile(this->mapping, FILE_MAP_READ, 0, 0, 0));
+        if(this->data == nullptr)
+        {
+            CloseHandle(this->mapping);
+            CloseHandle(file);
+            throw(std::runtime_error("MappedFile::MappedFile(): Can not map " + pPath + "!"));
+        }
+    }
+    /*The mapping object keeps the file referenced*/
+    CloseHandle(file);
+}
+MappedFile::~MappedFile()
+{
+    if(this->data != nullptr)
+    {
+        UnmapViewOfFile(this->data);
+    }
+    if(this->mapping != nullptr)
+    {
+        CloseHandle(this->mapping);
+    }
+}
+
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MappedFile::MappedFile(const std::string& pPath)
+: data(nullptr), size(0), mapping(nullptr)
+{
+    int fd = open(pPath.c_str(), O_RDONLY);
+    if(fd < 0)
+    {
+        throw(std::runtime_error("MappedFile::MappedFile(): Can not open " + pPath + "!"));
+    }
+    struct stat info;
+    if(fstat(fd, &info) != 0)
+    {
+        close(fd);
+        throw(std::runtime_error("MappedFile::MappedFile(): Can not determine the size of " + pPath + "!"));
+    }
+    this->size = static_cast<size_t>(info.st_size);
+    if(this->size > 0)
+    {
+        void* address = mmap(nullptr, this->size, PROT_READ, MAP_SHARED, fd, 0);
+        if(address == MAP_FAILED)
+        {
+            close(fd);
+            throw(std::runtime_error("MappedFile::MappedFile(): Can not map " + pPath + "!"));
+        }
+        this->data = static_cast<const uint8_t*>(address);
+    }
+    /*The mapping keeps the file referenced*/
+    close(fd);
+}
+MappedFile::~MappedFile()
+{
+    if(this->data != nullptr)
+    {
+        munmap(const_cast<uint8_t*>(this->data), this->size);
+    }
+}
+#endif
+
+const uint8_t* MappedFile::getData() const
+{
+    return this->data;
+}
+size_t MappedFile::getSize() const
+{
+    return this->size;
+}
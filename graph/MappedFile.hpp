@@ -0,0 +1,68 @@
+/**
+ * @file MappedFile.hpp
+ * @author Lennart Hustermeier (lennart.hustermeier@gmx.de)
+ * @brief Contains a read-only memory mapping of a file
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Maps a file read-only into memory; The pages are only loaded by the operating system when they are accessed, so opening
+ * even big files is free. The mapping stays valid until the object is destroyed.
+ */
+class MappedFile
+{
+public:
+    /**
+     * @brief Maps a file; Throws std::runtime_error if the file can not be opened or mapped
+     *
+     * @param pPath The path of the file
+     */
+    MappedFile(const std::string& pPath);
+
+    /**
+     * @brief Unmaps the file
+     */
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * @brief Returns the content of the file
+     *
+     * @return const uint8_t* The first byte of the file (nullptr for an empty file)
+     */
+    const uint8_t* getData() const;
+
+    /**
+     * @brief Returns the size of the file
+     *
+     * @return size_t The number of bytes
+     */
+    size_t getSize() const;
+protected:
+    /**
+     * @brief The mapped content
+     */
+    const uint8_t* data;
+
+    /**
+     * @brief The size of the mapping
+     */
+    size_t size;
+
+    /**
+     * @brief The handle of the mapping object (only used on Windows)
+     */
+    void* mapping;
+};
@@ -0,0 +1,155 @@
+/**
+ * @file ReservationTable.cpp
+ * @author Lennart Hustermeier (lennart.hustermeier@gmx.de)
+ * @brief Contains the implementation of the spatio-temporal reservation table
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "ReservationTable.hpp"
+
+ReservationTable::ReservationTable()
+{
+
+}
+uint64_t ReservationTable::packNode(NodeId pNode, unsigned int pTimestep)
+{
+    return (static_cast<uint64_t>(pTimestep) << 32) | pNode;
+}
+size_t ReservationTable::EdgeKeyHash::operator()(const EdgeKey& pKey) const
+{
+    uint64_t h = (static_cast<uint64_t>(pKey.timestep) << 32) | pKey.from;
+    h ^= static_cast<uint64_t>(pKey.to) * 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+    return std::hash<uint64_t>{}(h);
+}
+void ReservationTable::countTimestep(unsigned int pTimestep)
+{
+    this->timestepCounts[pTimestep]++;
+}
+void ReservationTable::uncountTimestep(unsigned int pTimestep)
+{
+    std::map<unsigned int, unsigned int>::iterator c = this->timestepCounts.find(pTimestep);
+    if(--c->second == 0)
+    {
+        this->timestepCounts.erase(c);
+    }
+}
+bool ReservationTable::reserveNode(NodeId pNode, unsigned int pTimestep)
+{
+    if(this->nodeReservations.insert(ReservationTable::packNode(pNode, pTimestep)).second)
+    {
+        this->countTimestep(pTimestep);
+        return true;
+    }
+    return false;
+}
+bool ReservationTable::releaseNode(NodeId pNode, unsigned int pTimestep)
+{
+    if(this->nodeReservations.erase(ReservationTable::packNode(pNode, pTimestep)) > 0)
+    {
+        this->uncountTimestep(pTimestep);
+        return true;
+    }
+    return false;
+}
+bool ReservationTable::reserveEdge(NodeId pFrom, NodeId pTo, unsigned int pTimestep)
+{
+    if(this->edgeReservations.insert(EdgeKey{pFrom, pTo, pTimestep}).second)
+    {
+        this->countTimestep(pTimestep);
+        return true;
+    }
+    return false;
+}
+bool ReservationTable::releaseEdge(NodeId pFrom, NodeId pTo, unsigned int pTimestep)
+{
+    if(this->edgeReservations.erase(EdgeKey{pFrom, pTo, pTimestep}) > 0)
+    {
+        this->uncountTimestep(pTimestep);
+        return true;
+    }
+    return false;
+}
+bool ReservationTable::isNodeReserved(NodeId pNode, unsigned int pTimestep) const
+{
+    return !this->nodeReservations.empty() && this->nodeReservations.contains(ReservationTable::packNode(pNode, pTimestep));
+}
+bool ReservationTable::isEdgeReserved(NodeId pFrom, NodeId pTo, unsigned int pTimestep) const
+{
+    return !this->edgeReservations.empty() && this->edgeReservations.contains(EdgeKey{pFrom, pTo, pTimestep});
+}
+bool ReservationTable::isMoveAllowed(NodeId pFrom, NodeId pTo, unsigned int pTimestep) const
+{
+    return !this->isNodeReserved(pTo, pTimestep) && !this->isEdgeReserved(pFrom, pTo, pTimestep);
+}
+bool ReservationTable::isPathAllowed(const std::vector<NodeId>& pPath) const
+{
+    if(this->empty())
+    {
+        return true;
+    }
+    unsigned int cntr = 0;
+    for(cntr=0; cntr<pPath.size(); cntr++)
+    {
+        if(this->isNodeReserved(pPath[cntr], cntr))
+        {
+            return false;
+        }
+        if(cntr > 0 && this->isEdgeReserved(pPath[cntr - 1], pPath[cntr], cntr))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+std::optional<unsigned int> ReservationTable::getLastNodeReservation(NodeId pNode) const
+{
+    /*Walk backwards over the reserved timesteps; Every lookup is O(1) and this is only needed once per search*/
+    for(std::map<unsigned int, unsigned int>::const_reverse_iterator t = this->timestepCounts.rbegin(); t != this->timestepCounts.rend(); ++t)
+    {
+        if(this->isNodeReserved(pNode, t->first))
+        {
+            return t->first;
+        }
+    }
+    return {};
+}
+unsigned int ReservationTable::getLastTimestep() const
+{
+    if(this->timestepCounts.empty())
+    {
+        return 0;
+    }
+    return this->timestepCounts.rbegin()->first;
+}
+bool ReservationTable::empty() const
+{
+    return this->nodeReservations.empty() && this->edgeReservations.empty();
+}
+size_t ReservationTable::size() const
+{
+    return this->nodeReservations.size() + this->edgeReservations.size();
+}
+std::vector<std::pair<unsigned int, NodeId>> ReservationTable::getNodeReservations() const
+{
+    std::vector<std::pair<unsigned int, NodeId>> result;
+    result.reserve(this->nodeReservations.size());
+    for(uint64_t r : this->nodeReservations)
+    {
+        result.push_back(std::make_pair(static_cast<unsigned int>(r >> 32), static_cast<NodeId>(r & 0xFFFFFFFFULL)));
+    }
+    return result;
+}
+std::vector<std::tuple<unsigned int, NodeId, NodeId>> ReservationTable::getEdgeReservations() const
+{
+    std::vector<std::tuple<unsigned int, NodeId, NodeId>> result;
+    result.reserve(this->edgeReservations.size());
+    for(const EdgeKey& e : this->edgeReservations)
+    {
+        result.push_back(std::make_tuple(e.timestep, e.from, e.to));
+    }
+    return result;
+}
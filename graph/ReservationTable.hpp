@@ -0,0 +1,214 @@
+/**
+ * @file ReservationTable.hpp
+ * @author Lennart Hustermeier (lennart.hustermeier@gmx.de)
+ * @brief Contains a spatio-temporal reservation table which stores the constraints of the low level path finding algorithm
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include "CompactGraph.hpp"
+#include <tuple>
+#include <unordered_set>
+
+/**
+ * @brief A reservation table stores which nodes can not be entered at which timestep (node reservations) and which edges can not
+ * be traversed to arrive at a node at a specific timestep (edge reservations). All lookups are hash based and thus O(1).
+ */
+class ReservationTable
+{
+public:
+    /**
+     * @brief Constructs a new empty reservation table
+     */
+    ReservationTable();
+
+    /**
+     * @brief Reserves a node at a timestep, so it can not be entered at that timestep
+     *
+     * @param pNode The node to reserve
+     * @param pTimestep The timestep at which the node is reserved
+     * @return true The reservation was added
+     * @return false The reservation was already present
+     */
+    bool reserveNode(NodeId pNode, unsigned int pTimestep);
+
+    /**
+     * @brief Removes a node reservation
+     *
+     * @param pNode The reserved node
+     * @param pTimestep The timestep of the reservation
+     * @return true The reservation was removed
+     * @return false There was no such reservation
+     */
+    bool releaseNode(NodeId pNode, unsigned int pTimestep);
+
+    /**
+     * @brief Reserves an edge, so it can not be traversed to arrive at pTo at timestep pTimestep
+     *
+     * @param pFrom The start node of the edge
+     * @param pTo The end node of the edge
+     * @param pTimestep The timestep at which pTo would be reached using the edge
+     * @return true The reservation was added
+     * @return false The reservation was already present
+     */
+    bool reserveEdge(NodeId pFrom, NodeId pTo, unsigned int pTimestep);
+
+    /**
+     * @brief Removes an edge reservation
+     *
+     * @param pFrom The start node of the edge
+     * @param pTo The end node of the edge
+     * @param pTimestep The timestep at which pTo would be reached using the edge
+     * @return true The reservation was removed
+     * @return false There was no such reservation
+     */
+    bool releaseEdge(NodeId pFrom, NodeId pTo, unsigned int pTimestep);
+
+    /**
+     * @brief Checks if a node is reserved at a timestep
+     *
+     * @param pNode The node to check
+     * @param pTimestep The timestep to check
+     * @return true The node can not be entered at pTimestep
+     * @return false The node is free at pTimestep
+     */
+    bool isNodeReserved(NodeId pNode, unsigned int pTimestep) const;
+
+    /**
+     * @brief Checks if an edge is reserved
+     *
+     * @param pFrom The start node of the edge
+     * @param pTo The end node of the edge
+     * @param pTimestep The timestep at which pTo would be reached using the edge
+     * @return true The edge can not be used to arrive at pTimestep
+     * @return false The edge is free
+     */
+    bool isEdgeReserved(NodeId pFrom, NodeId pTo, unsigned int pTimestep) const;
+
+    /**
+     * @brief Checks if a move from pFrom to pTo arriving at pTimestep violates neither a node nor an edge reservation
+     *
+     * @param pFrom The node the move starts at (at pTimestep - 1)
+     * @param pTo The node the move ends at (at pTimestep)
+     * @param pTimestep The timestep of the arrival at pTo
+     * @return true The move is allowed
+     * @return false The move violates a reservation
+     */
+    bool isMoveAllowed(NodeId pFrom, NodeId pTo, unsigned int pTimestep) const;
+
+    /**
+     * @brief Checks if a whole path (one node per timestep, starting at timestep 0) respects all reservations
+     *
+     * @param pPath The path to check
+     * @return true No reservation is violated
+     * @return false The path enters a reserved node or traverses a reserved edge
+     */
+    bool isPathAllowed(const std::vector<NodeId>& pPath) const;
+
+    /**
+     * @brief Returns the last timestep at which a node is reserved
+     *
+     * @param pNode The node
+     * @return std::optional<unsigned int> The last reserved timestep of pNode or an empty optional if it is never reserved
+     */
+    std::optional<unsigned int> getLastNodeReservation(NodeId pNode) const;
+
+    /**
+     * @brief Returns the last timestep which is affected by any reservation
+     *
+     * @return unsigned int The last reserved timestep (0 if the table is empty)
+     */
+    unsigned int getLastTimestep() const;
+
+    /**
+     * @brief Checks if there are no reservations
+     *
+     * @return true The table is empty
+     * @return false There is at least one reservation
+     */
+    bool empty() const;
+
+    /**
+     * @brief Returns the number of reservations (nodes and edges)
+     *
+     * @return size_t Number of reservations
+     */
+    size_t size() const;
+
+    /**
+     * @brief Returns all node reservations
+     *
+     * @return std::vector<std::pair<unsigned int, NodeId>> Unordered vector of (<timestep>, <node>)
+     */
+    std::vector<std::pair<unsigned int, NodeId>> getNodeReservations() const;
+
+    /**
+     * @brief Returns all edge reservations
+     *
+     * @return std::vector<std::tuple<unsigned int, NodeId, NodeId>> Unordered vector of (<timestep>, <from>, <to>)
+     */
+    std::vector<std::tuple<unsigned int, NodeId, NodeId>> getEdgeReservations() const;
+protected:
+    /**
+     * @brief Key of an edge reservation
+     */
+    struct EdgeKey
+    {
+        NodeId from;
+        NodeId to;
+        unsigned int timestep;
+
+        bool operator==(const EdgeKey& pOther) const = default;
+    };
+
+    /**
+     * @brief Hash function for edge reservations
+     */
+    struct EdgeKeyHash
+    {
+        size_t operator()(const EdgeKey& pKey) const;
+    };
+
+    /**
+     * @brief Packs a node reservation to a single integer (<timestep> << 32 | <node>)
+     *
+     * @param pNode The node
+     * @param pTimestep The timestep
+     * @return uint64_t The packed key
+     */
+    static uint64_t packNode(NodeId pNode, unsigned int pTimestep);
+
+    /**
+     * @brief Registers an additional reservation at a timestep
+     *
+     * @param pTimestep The timestep of the reservation
+     */
+    void countTimestep(unsigned int pTimestep);
+
+    /**
+     * @brief Unregisters a reservation at a timestep
+     *
+     * @param pTimestep The timestep of the reservation
+     */
+    void uncountTimestep(unsigned int pTimestep);
+
+    /**
+     * @brief Stores all node reservations as packed keys
+     */
+    std::unordered_set<uint64_t> nodeReservations;
+
+    /**
+     * @brief Stores all edge reservations
+     */
+    std::unordered_set<EdgeKey, EdgeKeyHash> edgeReservations;
+
+    /**
+     * @brief Counts the reservations per timestep in order to know the last reserved timestep after a removal
+     */
+    std::map<unsigned int, unsigned int> timestepCounts;
+};
@@ -0,0 +1,43 @@
+/**
+ * @file SafeIntervalSearch.cpp
+ * @author Lennart Hustermeier (lennart.hustermeier@gmx.de)
+ * @brief Contains the non-template parts of SIPP and its instantiations
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "SafeIntervalSearch.hpp"
+
+template<class GraphType> BasicSafeIntervalSearch<GraphType>::BasicSafeIntervalSearch(const GraphType& pGraph, std::pmr::memory_resource* pResource, double pWaitCost)
+: graph(pGraph), waitCost(pWaitCost), lastTimestep(0), reserved(pResource), intervalStates(pResource), stateNode(pResource), stateArrival(pResource), stateIntervalEnd(pResource),
+  g(pResource), parent(pResource), open(pResource), expansions(0)
+{
+
+}
+template<class GraphType> size_t BasicSafeIntervalSearch<GraphType>::getExpansions() const
+{
+    return this->expansions;
+}
+template<class GraphType> double BasicSafeIntervalSearch<GraphType>::getWaitCost() const
+{
+    return this->waitCost;
+}
+template<class GraphType> void BasicSafeIntervalSearch<GraphType>::reset()
+{
+    this->reserved.clear();
+    this->intervalStates.clear();
+    this->stateNode.clear();
+    this->stateArrival.clear();
+    this->stateIntervalEnd.clear();
+    this->g.clear();
+    this->parent.clear();
+    this->open.clear();
+    this->expansions = 0;
+}
+template class BasicSafeIntervalSearch<CompactGraph>;
+template class BasicSafeIntervalSearch<LatticeGraph>;
+template class BasicSafeIntervalSearch<GraphSnapshot>;
+template class BasicSafeIntervalSearch<BlockedGraph>;
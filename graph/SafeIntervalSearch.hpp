@@ -0,0 +1,427 @@
+/**
+ * @file SafeIntervalSearch.hpp
+ * @author Lennart Hustermeier (lennart.hustermeier@gmx.de)
+ * @brief Contains the low level path finding algorithm SIPP (safe interval path planning) which operates on compact and lattice graphs
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include "BlockedGraph.hpp"
+#include "CompactGraph.hpp"
+#include "LatticeGraph.hpp"
+#include "GraphSnapshot.hpp"
+#include "IndexedHeap.hpp"
+#include "ReservationTable.hpp"
+#include <algorithm>
+#include <limits>
+#include <memory_resource>
+#include <optional>
+#include <unordered_map>
+
+/**
+ * @brief Safe interval path planning: The free timesteps of every node are grouped into safe intervals (maximal ranges of timesteps
+ * without a node reservation) and a search state is a pair (<node>, <safe interval>) instead of (<node>, <timestep>). Agents can
+ * wait on every node, and as long as waiting on the previous node is at least as expensive as on the entered one, arriving early
+ * and waiting is never more expensive than arriving late; Then only the earliest possible arrival in an interval is generated,
+ * otherwise every arrival up to the end of the reservations. A state is dropped if an earlier arrival at the same interval is at
+ * most as expensive after waiting until its arrival; After the last reservation the timestep does not matter anymore, so all
+ * arrivals after it count as the same. The number of states depends on the number of reservations instead of the length of the
+ * time horizon, and the search terminates without a horizon.
+ *
+ * A wait (the same node on consecutive timesteps) costs the weight of the self loop of the node, the same as in the space-time
+ * A*, so both searches find paths with the same costs on graphs with loops. In contrast to the space-time A* an agent may also wait
+ * on nodes without a loop; These waits are charged with the wait cost of the search. A positive wait cost makes every delay more
+ * expensive, which CBS needs to terminate: With free waits the children which only delay an agent would cost as much as their
+ * parent.
+ *
+ * @tparam GraphType The graph to search in; Has to provide getNodeCount(), isBlocked(<node>) and
+ * forEachOutgoing(<node>, <callback(target, weight)>) (instantiated for CompactGraph, LatticeGraph, GraphSnapshot
+ * and BlockedGraph)
+ */
+template<class GraphType> class BasicSafeIntervalSearch
+{
+public:
+    /**
+     * @brief Marks the end of the last safe interval of a node
+     */
+    static constexpr unsigned int INFINITE_TIMESTEP = std::numeric_limits<unsigned int>::max();
+
+    /**
+     * @brief The default costs of waiting one timestep on a node without a self loop; Equals the unit loops which the graphs of CBS
+     * usually contain
+     */
+    static constexpr double DEFAULT_WAIT_COST = 1.0;
+
+    /**
+     * @brief Creates a new search on a graph; The instance can be reused for multiple searches on the same graph
+     *
+     * @param pGraph The graph to search in
+     * @param pResource The memory resource for the per-search data (e.g. the SearchArena of the thread)
+     * @param pWaitCost The costs of waiting one timestep on a node without a self loop (has to be positive)
+     */
+    BasicSafeIntervalSearch(const GraphType& pGraph, std::pmr::memory_resource* pResource=std::pmr::get_default_resource(), double pWaitCost=DEFAULT_WAIT_COST);
+
+    /**
+     * @brief Searches a cost optimal path from pStart to pTarget which respects the obstacles and the reservations. A path is only
+     * accepted if the agent is allowed to stay on the target after reaching it.
+     *
+     * @tparam Heuristic Callable with the signature double(NodeId); Passed as concrete type, so it can be inlined into the search
+     * @param pStart The start node
+     * @param pTarget The target node
+     * @param pH The heuristic (estimated costs from a node to pTarget); Nodes with an infinite estimate are never expanded
+     * @param pBlocked Nodes which shall not be entered (indexed by node ID); May be empty if there are no obstacles
+     * @param pReservations The node and edge reservations which have to be respected
+     * @return std::vector<NodeId> The path (one node per timestep, waits repeat the node) or an empty vector if there is no such path
+     */
+    template<class Heuristic> std::vector<NodeId> findPath(NodeId pStart, NodeId pTarget, const Heuristic& pH, const std::vector<bool>& pBlocked, const ReservationTable& pReservations)
+    {
+        this->reset();
+
+        const size_t nodeCount = this->graph.getNodeCount();
+        if(pStart >= nodeCount || pTarget >= nodeCount || this->graph.isBlocked(pStart) || this->graph.isBlocked(pTarget) ||
+           (!pBlocked.empty() && (pBlocked[pStart] || pBlocked[pTarget])))
+        {
+            return std::vector<NodeId>();
+        }
+
+        /*Group the node reservations by node, the gaps between them are the safe intervals*/
+        for(const std::pair<unsigned int, NodeId>& r : pReservations.getNodeReservations())
+        {
+            this->reserved[r.second].push_back(r.first);
+        }
+        for(std::pair<const NodeId, std::pmr::vector<unsigned int>>& r : this->reserved)
+        {
+            std::sort(r.second.begin(), r.second.end());
+        }
+        const unsigned int lastTimestep = pReservations.getLastTimestep();
+        this->lastTimestep = lastTimestep;
+
+        double hStart = pH(pStart);
+        if(hStart == std::numeric_limits<double>::infinity())
+        {
+            return std::vector<NodeId>();
+        }
+
+        /*The agent is on the start node at timestep 0 even if the node is reserved then*/
+        const std::pmr::vector<unsigned int>* startReserved = this->getReserved(pStart);
+        if(startReserved != nullptr && startReserved->front() == 0)
+        {
+            this->reserved[pStart].erase(this->reserved[pStart].begin());
+            startReserved = this->reserved[pStart].empty() ? nullptr : startReserved;
+        }
+        const unsigned int startEnd = startReserved == nullptr ? INFINITE_TIMESTEP : startReserved->front() - 1;
+        this->addState(pStart, 0, startEnd, 0, 0.0, IndexedHeap<Key>::NOT_IN_HEAP, hStart);
+
+        while(!this->open.empty())
+        {
+            uint32_t current = this->open.pop();
+            this->expansions++;
+
+            const NodeId currentNode = this->stateNode[current];
+            const unsigned int arrival = this->stateArrival[current];
+            const unsigned int intervalEnd = this->stateIntervalEnd[current];
+            const double currentG = this->g[current];
+            const double currentWaitCost = getNodeWaitCost(this->graph, currentNode, this->waitCost);
+
+            if(currentNode == pTarget && intervalEnd == INFINITE_TIMESTEP)
+            {
+                /*The last safe interval of the target never ends, so the agent can stay there*/
+                return this->reconstructPath(current);
+            }
+
+            /*The agent can leave at any timestep of [arrival, intervalEnd], so it arrives at a successor in [arrival + 1, intervalEnd + 1]*/
+            const uint64_t earliest = static_cast<uint64_t>(arrival) + 1;
+            const uint64_t latest = intervalEnd == INFINITE_TIMESTEP ? INFINITE_TIMESTEP : static_cast<uint64_t>(intervalEnd) + 1;
+
+            this->graph.forEachOutgoing(currentNode, [&](NodeId s, double pWeight) {
+                if(s == currentNode)
+                {
+                    /*Loops are waits, which are part of the safe intervals*/
+                    return;
+                }
+                if(!pBlocked.empty() && pBlocked[s])
+                {
+                    /*Skip obstacles*/
+                    return;
+                }
+                double h = pH(s);
+                if(h == std::numeric_limits<double>::infinity())
+                {
+                    /*The target can not be reached from s*/
+                    return;
+                }
+                const double sWaitCost = getNodeWaitCost(this->graph, s, this->waitCost);
+
+                /*Visit every safe interval of s which overlaps the possible arrival times*/
+                const std::pmr::vector<unsigned int>* sReserved = this->getReserved(s);
+                std::pmr::vector<unsigned int>::const_iterator next;
+                if(sReserved != nullptr)
+                {
+                    next = std::lower_bound(sReserved->begin(), sReserved->end(), earliest);
+                }
+                uint64_t t = earliest;
+                while(t <= latest)
+                {
+                    if(sReserved != nullptr)
+                    {
+                        while(next != sReserved->end() && *next == t)
+                        {
+                            t++;
+                            next++;
+                        }
+                    }
+                    if(t > latest)
+                    {
+                        break;
+                    }
+                    const bool lastInterval = sReserved == nullptr || next == sReserved->end();
+                    const unsigned int sIntervalStart = sReserved == nullptr || next == sReserved->begin() ? 0 : *(next - 1) + 1;
+                    const unsigned int sIntervalEnd = lastInterval ? INFINITE_TIMESTEP : *next - 1;
+
+                    /*Arrive as early as possible, i.e. at the first timestep at which the edge is not reserved; Every timestep which
+                      the agent stays on currentNode before leaving is a wait. If waiting on currentNode is cheaper than on s, staying
+                      longer on currentNode can pay off, so the later arrivals up to the end of the reservations are added as well*/
+                    const uint64_t arrivalEnd = std::min<uint64_t>(latest, sIntervalEnd);
+                    const uint64_t delayEnd = sWaitCost > currentWaitCost ? std::min<uint64_t>(arrivalEnd, std::max<uint64_t>(t, static_cast<uint64_t>(lastTimestep) + 1)) : 0;
+                    for(; t <= arrivalEnd; t++)
+                    {
+                        if(t > lastTimestep || !pReservations.isEdgeReserved(currentNode, s, static_cast<unsigned int>(t)))
+                        {
+                            const double tentativeG = currentG + static_cast<double>(t - earliest) * currentWaitCost + pWeight;
+                            this->addState(s, sIntervalStart, sIntervalEnd, static_cast<unsigned int>(t), tentativeG, current, tentativeG + h);
+                            if(t >= delayEnd)
+                            {
+                                break;
+                            }
+                        }
+                    }
+
+                    if(lastInterval)
+                    {
+                        break;
+                    }
+                    t = static_cast<uint64_t>(sIntervalEnd) + 1;
+                }
+            });
+        }
+
+        return std::vector<NodeId>();
+    }
+
+    /**
+     * @brief Returns the number of states expanded by the last search
+     *
+     * @return size_t Number of expansions
+     */
+    size_t getExpansions() const;
+
+    /**
+     * @brief Returns the costs of waiting one timestep on a node without a self loop
+     *
+     * @return double The wait cost
+     */
+    double getWaitCost() const;
+
+    /**
+     * @brief Returns the costs of waiting one timestep on a node: The weight of its self loop or pWaitCost if it has none
+     *
+     * @param pGraph The graph
+     * @param pNode The node
+     * @param pWaitCost The costs of waiting on a node without a self loop
+     * @return double The wait cost of the node
+     */
+    static double getNodeWaitCost(const GraphType& pGraph, NodeId pNode, double pWaitCost)
+    {
+        double result = pWaitCost;
+        pGraph.forEachOutgoing(pNode, [&](NodeId s, double pWeight) {
+            if(s == pNode)
+            {
+                result = pWeight;
+            }
+        });
+        return result;
+    }
+protected:
+    /**
+     * @brief The key by which the open list is ordered: f-value first, then the arrival timestep and the node for deterministic ties
+     */
+    struct Key
+    {
+        double f;
+        unsigned int arrival;
+        NodeId node;
+
+        bool operator<(const Key& pOther) const
+        {
+            if(this->f != pOther.f)
+            {
+                return this->f < pOther.f;
+            }
+            if(this->arrival != pOther.arrival)
+            {
+                return this->arrival < pOther.arrival;
+            }
+            return this->node < pOther.node;
+        }
+    };
+
+    /**
+     * @brief Returns the sorted reserved timesteps of a node
+     *
+     * @param pNode The node
+     * @return const std::pmr::vector<unsigned int>* The reserved timesteps or nullptr if the node is never reserved
+     */
+    const std::pmr::vector<unsigned int>* getReserved(NodeId pNode) const
+    {
+        std::pmr::unordered_map<NodeId, std::pmr::vector<unsigned int>>::const_iterator r = this->reserved.find(pNode);
+        return r == this->reserved.end() ? nullptr : &r->second;
+    }
+
+    /**
+     * @brief Adds the arrival at a safe interval unless an earlier arrival at the same interval dominates it, i.e. is at most as
+     * expensive after waiting until pArrival; Arrivals after the last reservation only have to wait until then
+     *
+     * @param pNode The node
+     * @param pIntervalStart The first timestep of the safe interval
+     * @param pIntervalEnd The last timestep of the safe interval
+     * @param pArrival The arrival timestep
+     * @param pG The costs of the arrival
+     * @param pParent The state from which the node is entered
+     * @param pF The f-value of the state
+     */
+    void addState(NodeId pNode, unsigned int pIntervalStart, unsigned int pIntervalEnd, unsigned int pArrival, double pG, uint32_t pParent, double pF)
+    {
+        std::pmr::vector<uint32_t>& arrivals = this->intervalStates[(static_cast<uint64_t>(pIntervalStart) << 32) | pNode];
+        const double nodeWaitCost = arrivals.empty() ? this->waitCost : getNodeWaitCost(this->graph, pNode, this->waitCost);
+        const uint64_t arrival = std::min<uint64_t>(pArrival, static_cast<uint64_t>(this->lastTimestep) + 1);
+        for(uint32_t a : arrivals)
+        {
+            const uint64_t aArrival = std::min<uint64_t>(this->stateArrival[a], static_cast<uint64_t>(this->lastTimestep) + 1);
+            if(aArrival <= arrival && this->g[a] + static_cast<double>(arrival - aArrival) * nodeWaitCost <= pG)
+            {
+                return;
+            }
+        }
+
+        const uint32_t state = static_cast<uint32_t>(this->stateNode.size());
+        arrivals.push_back(state);
+        this->stateNode.push_back(pNode);
+        this->stateArrival.push_back(pArrival);
+        this->stateIntervalEnd.push_back(pIntervalEnd);
+        this->g.push_back(pG);
+        this->parent.push_back(pParent);
+        this->open.push(state, Key{pF, pArrival, pNode});
+    }
+
+    /**
+     * @brief Expands the chain of states which ends at pState to a path with one node per timestep
+     *
+     * @param pState The last state of the path
+     * @return std::vector<NodeId> The path
+     */
+    std::vector<NodeId> reconstructPath(uint32_t pState) const
+    {
+        std::vector<NodeId> result(static_cast<size_t>(this->stateArrival[pState]) + 1);
+        size_t leave = result.size();
+        for(uint32_t s = pState; s != IndexedHeap<Key>::NOT_IN_HEAP; s = this->parent[s])
+        {
+            /*The agent waits on the node of s from its arrival until it moves on*/
+            for(size_t t = this->stateArrival[s]; t < leave; t++)
+            {
+                result[t] = this->stateNode[s];
+            }
+            leave = this->stateArrival[s];
+        }
+        return result;
+    }
+
+    /**
+     * @brief Resets all per-search data while keeping the allocated memory
+     */
+    void reset();
+
+    /**
+     * @brief The graph to search in
+     */
+    const GraphType& graph;
+
+    /**
+     * @brief The costs of waiting one timestep on a node without a self loop
+     */
+    double waitCost;
+
+    /**
+     * @brief The last timestep with a reservation in the current search
+     */
+    unsigned int lastTimestep;
+
+    /**
+     * @brief The sorted reserved timesteps of every node which has node reservations
+     */
+    std::pmr::unordered_map<NodeId, std::pmr::vector<unsigned int>> reserved;
+
+    /**
+     * @brief Maps a safe interval (<first timestep> << 32 | <node>) to its non-dominated arrival states
+     */
+    std::pmr::unordered_map<uint64_t, std::pmr::vector<uint32_t>> intervalStates;
+
+    /**
+     * @brief The node of every state
+     */
+    std::pmr::vector<NodeId> stateNode;
+
+    /**
+     * @brief The arrival timestep of every state
+     */
+    std::pmr::vector<unsigned int> stateArrival;
+
+    /**
+     * @brief The last timestep of the safe interval of every state
+     */
+    std::pmr::vector<unsigned int> stateIntervalEnd;
+
+    /**
+     * @brief The costs of every state
+     */
+    std::pmr::vector<double> g;
+
+    /**
+     * @brief The predecessor state of every state
+     */
+    std::pmr::vector<uint32_t> parent;
+
+    /**
+     * @brief The open list
+     */
+    IndexedHeap<Key> open;
+
+    /**
+     * @brief Counts the expansions of the last search
+     */
+    size_t expansions;
+};
+
+/**
+ * @brief SIPP on compact graphs
+ */
+typedef BasicSafeIntervalSearch<CompactGraph> SafeIntervalSearch;
+
+/**
+ * @brief SIPP on implicit lattices
+ */
+typedef BasicSafeIntervalSearch<LatticeGraph> LatticeSafeIntervalSearch;
+
+/**
+ * @brief The safe interval search on memory-mapped graph snapshots
+ */
+typedef BasicSafeIntervalSearch<GraphSnapshot> SnapshotSafeIntervalSearch;
+
+/**
+ * @brief The SIPP on compact graphs with blocked nodes and edges
+ */
+typedef BasicSafeIntervalSearch<BlockedGraph> BlockedSafeIntervalSearch;
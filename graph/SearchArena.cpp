@@ -0,0 +1,96 @@
+/**
+ * @file SearchArena.cpp
+ * @author Lennart Hustermeier (lennart.hustermeier@gmx.de)
+ * @brief Contains the implementation of the per-thread monotonic allocator
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "SearchArena.hpp"
+#include <algorithm>
+#include <cstdint>
+
+SearchArena::Scope::Scope()
+: arena(SearchArena::getThreadArena())
+{
+    this->arena.depth++;
+}
+SearchArena::Scope::~Scope()
+{
+    if(--this->arena.depth == 0)
+    {
+        this->arena.reset();
+    }
+}
+std::pmr::memory_resource* SearchArena::Scope::getResource() const
+{
+    return &this->arena;
+}
+
+SearchArena::SearchArena(size_t pBlockSize)
+: offset(0), usedBefore(0), depth(0)
+{
+    this->blocks.push_back(Block{std::unique_ptr<std::byte[]>(new std::byte[pBlockSize]), pBlockSize});
+}
+SearchArena& SearchArena::getThreadArena()
+{
+    thread_local SearchArena arena;
+    return arena;
+}
+void SearchArena::reset()
+{
+    if(this->blocks.size() > 1)
+    {
+        /*The last search did not fit into one block -> merge the blocks, so the next one does*/
+        size_t size = 0;
+        for(const Block& b : this->blocks)
+        {
+            size += b.size;
+        }
+        this->blocks.clear();
+        this->blocks.push_back(Block{std::unique_ptr<std::byte[]>(new std::byte[size]), size});
+    }
+    this->offset = 0;
+    this->usedBefore = 0;
+}
+size_t SearchArena::getUsed() const
+{
+    return this->usedBefore + this->offset;
+}
+size_t SearchArena::getCapacity() const
+{
+    size_t size = 0;
+    for(const Block& b : this->blocks)
+    {
+        size += b.size;
+    }
+    return size;
+}
+void* SearchArena::do_allocate(size_t pBytes, size_t pAlignment)
+{
+    Block* block = &this->blocks.back();
+    uintptr_t base = reinterpret_cast<uintptr_t>(block->memory.get());
+    size_t aligned = ((base + this->offset + pAlignment - 1) & ~(static_cast<uintptr_t>(pAlignment) - 1)) - base;
+    if(aligned + pBytes > block->size)
+    {
+        const size_t size = std::max(2 * block->size, pBytes + pAlignment);
+        this->usedBefore += this->offset;
+        this->blocks.push_back(Block{std::unique_ptr<std::byte[]>(new std::byte[size]), size});
+        block = &this->blocks.back();
+        base = reinterpret_cast<uintptr_t>(block->memory.get());
+        aligned = ((base + pAlignment - 1) & ~(static_cast<uintptr_t>(pAlignment) - 1)) - base;
+    }
+    this->offset = aligned + pBytes;
+    return block->memory.get() + aligned;
+}
+void SearchArena::do_deallocate(void*, size_t, size_t)
+{
+
+}
+bool SearchArena::do_is_equal(const std::pmr::memory_resource& pOther) const noexcept
+{
+    return this == &pOther;
+}
@@ -0,0 +1,152 @@
+/**
+ * @file SearchArena.hpp
+ * @author Lennart Hustermeier (lennart.hustermeier@gmx.de)
+ * @brief Contains a per-thread monotonic allocator for the data of a single search
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+/**
+ * @brief A monotonic memory resource for search-local containers (state arrays, hash maps, open lists): Allocations bump a pointer
+ * inside of a block, deallocations are ignored and reset() releases everything at once. After a reset the blocks are merged into
+ * one block which is large enough for the previous search, so repeated searches of similar size do not call the system allocator
+ * at all.
+ *
+ * Every thread has an arena of its own (getThreadArena()), so the workers of a ThreadPool and the threads of CBS do not share
+ * memory. Containers which use the arena have to be destroyed before it is reset; Use SearchArena::Scope to bound their lifetime.
+ */
+class SearchArena : public std::pmr::memory_resource
+{
+public:
+    /**
+     * @brief Resets the arena of the current thread when the outermost scope of the thread ends; Nested scopes (e.g. a search
+     * which runs another search) share the memory of the outermost one
+     */
+    class Scope
+    {
+    public:
+        /**
+         * @brief Opens a scope on the arena of the current thread
+         */
+        Scope();
+
+        /**
+         * @brief Closes the scope and resets the arena if this was the outermost scope
+         */
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+        /**
+         * @brief Returns the memory resource to construct the search-local containers with
+         *
+         * @return std::pmr::memory_resource* The arena of the current thread
+         */
+        std::pmr::memory_resource* getResource() const;
+    protected:
+        /**
+         * @brief The arena of the thread which opened the scope
+         */
+        SearchArena& arena;
+    };
+
+    /**
+     * @brief Creates an empty arena
+     *
+     * @param pBlockSize The size of the first block in bytes
+     */
+    SearchArena(size_t pBlockSize=1 << 16);
+
+    SearchArena(const SearchArena&) = delete;
+    SearchArena& operator=(const SearchArena&) = delete;
+
+    /**
+     * @brief Returns the arena of the current thread
+     *
+     * @return SearchArena& The arena
+     */
+    static SearchArena& getThreadArena();
+
+    /**
+     * @brief Releases all allocations; The memory is kept for the next search
+     */
+    void reset();
+
+    /**
+     * @brief Returns the number of bytes allocated since the last reset
+     *
+     * @return size_t Number of bytes (including alignment padding)
+     */
+    size_t getUsed() const;
+
+    /**
+     * @brief Returns the number of bytes reserved by the arena
+     *
+     * @return size_t Number of bytes
+     */
+    size_t getCapacity() const;
+protected:
+    /**
+     * @brief Allocates memory by bumping the offset inside of the current block; Starts a new block of at least twice the size if
+     * the current block is full
+     *
+     * @param pBytes Number of bytes
+     * @param pAlignment The required alignment
+     * @return void* The memory
+     */
+    void* do_allocate(size_t pBytes, size_t pAlignment) override;
+
+    /**
+     * @brief Does nothing, the memory is released by reset()
+     */
+    void do_deallocate(void* pPointer, size_t pBytes, size_t pAlignment) override;
+
+    /**
+     * @brief Checks if two resources are the same arena
+     *
+     * @param pOther The other resource
+     * @return true pOther is this arena
+     * @return false pOther is another resource
+     */
+    bool do_is_equal(const std::pmr::memory_resource& pOther) const noexcept override;
+
+    /**
+     * @brief A block of memory and its size
+     */
+    struct Block
+    {
+        std::unique_ptr<std::byte[]> memory;
+        size_t size;
+    };
+
+    /**
+     * @brief The blocks; Allocations are served from the last one
+     */
+    std::vector<Block> blocks;
+
+    /**
+     * @brief The offset of the first free byte in the last block
+     */
+    size_t offset;
+
+    /**
+     * @brief The number of bytes used in the blocks before the last one
+     */
+    size_t usedBefore;
+
+    /**
+     * @brief The number of open scopes on this arena
+     */
+    unsigned int depth;
+};
@@ -0,0 +1,328 @@
+/**
+ * @file ShortestPathTree.cpp
+ * @author Lennart Hustermeier (lennart.hustermeier@gmx.de)
+ * @brief Contains the heap based implementation of Dijkstra's algorithm on compact graphs
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "ShortestPathTree.hpp"
+#include "LatticeGraph.hpp"
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <stdexcept>
+
+ShortestPathTree::ShortestPathTree(std::shared_ptr<const CompactGraph> pGraph, NodeId pSource, bool pBackward)
+: graph(pGraph), lattice(), source(pSource), backward(pBackward), predecessor(pGraph->getNodeCount(), CompactGraph::INVALID_NODE),
+  distance(pGraph->getNodeCount(), std::numeric_limits<double>::infinity())
+{
+    if(this->source < this->distance.size())
+    {
+        this->distance[this->source] = 0.0;
+    }
+}
+ShortestPathTree::ShortestPathTree(std::shared_ptr<const LatticeGraph> pGraph, NodeId pSource, bool pBackward)
+: graph(), lattice(pGraph), source(pSource), backward(pBackward), predecessor(pGraph->getNodeCount(), LatticeGraph::INVALID_NODE),
+  distance(pGraph->getNodeCount(), std::numeric_limits<double>::infinity())
+{
+    if(this->source < this->distance.size())
+    {
+        this->distance[this->source] = 0.0;
+    }
+}
+ShortestPathTree ShortestPathTree::compute(std::shared_ptr<const CompactGraph> pGraph, NodeId pSource, const std::vector<bool>& pBlocked, NodeId pTarget, bool pBackward)
+{
+    ShortestPathTree result(pGraph, pSource, pBackward);
+    ShortestPathTree::run(result, *pGraph, pSource, pBlocked, pTarget, pBackward);
+    return result;
+}
+ShortestPathTree ShortestPathTree::compute(std::shared_ptr<const LatticeGraph> pGraph, NodeId pSource, const std::vector<bool>& pBlocked, NodeId pTarget, bool pBackward)
+{
+    ShortestPathTree result(pGraph, pSource, pBackward);
+    ShortestPathTree::run(result, *pGraph, pSource, pBlocked, pTarget, pBackward);
+    return result;
+}
+template<class GraphType> void ShortestPathTree::run(ShortestPathTree& pResult, const GraphType& pGraph, NodeId pSource, const std::vector<bool>& pBlocked, NodeId pTarget, bool pBackward)
+{
+    if(pSource >= pGraph.getNodeCount() || pGraph.isBlocked(pSource) || (!pBlocked.empty() && pBlocked[pSource]))
+    {
+        pResult.distance.assign(pResult.distance.size(), std::numeric_limits<double>::infinity());
+        return;
+    }
+
+    /*Binary heap of (<distance>, <node>) with lazy deletion: Outdated entries are skipped when they are popped*/
+    typedef std::pair<double, NodeId> HeapEntry;
+    std::priority_queue<HeapEntry, std::vector<HeapEntry>, std::greater<HeapEntry>> heap;
+    std::vector<bool> settled(pGraph.getNodeCount(), false);
+
+    heap.push(std::make_pair(0.0, pSource));
+    while(!heap.empty())
+    {
+        HeapEntry current = heap.top();
+        heap.pop();
+
+        NodeId u = current.second;
+        if(settled[u])
+        {
+            continue;
+        }
+        settled[u] = true;
+
+        if(u == pTarget)
+        {
+            /*The target is settled, its distance can not change anymore*/
+            break;
+        }
+
+        auto relax = [&](NodeId v, double pWeight) {
+            if(settled[v] || (!pBlocked.empty() && pBlocked[v]))
+            {
+                return;
+            }
+            double alt = current.first + pWeight;
+            if(alt < pResult.distance[v])
+            {
+                pResult.distance[v] = alt;
+                pResult.predecessor[v] = u;
+                heap.push(std::make_pair(alt, v));
+            }
+        };
+        if(pBackward)
+        {
+            pGraph.forEachIncoming(u, relax);
+        }
+        else
+        {
+            pGraph.forEachOutgoing(u, relax);
+        }
+    }
+}
+ShortestPathTree ShortestPathTree::computeParallel(std::shared_ptr<const CompactGraph> pGraph, NodeId pSource, ThreadPool& pPool, const std::vector<bool>& pBlocked, bool pBackward, double pDelta)
+{
+    ShortestPathTree result(pGraph, pSource, pBackward);
+    const size_t nodeCount = pGraph->getNodeCount();
+    if(pSource >= nodeCount || (!pBlocked.empty() && pBlocked[pSource]))
+    {
+        result.distance.assign(result.distance.size(), std::numeric_limits<double>::infinity());
+        return result;
+    }
+
+    if(pDelta <= 0.0)
+    {
+        double sum = 0.0;
+        size_t count = 0;
+        for(NodeId n = 0; n < nodeCount; n++)
+        {
+            for(double w : pGraph->getOutgoingWeights(n))
+            {
+                sum += w;
+                count++;
+            }
+        }
+        pDelta = (count == 0 || sum == 0.0) ? 1.0 : sum / count;
+    }
+
+    /*A relaxation request: pNode can be reached over pPredecessor with the costs pDistance*/
+    struct Request
+    {
+        NodeId node;
+        NodeId predecessor;
+        double distance;
+    };
+
+    const unsigned int threads = pPool.getThreadCount();
+    auto owner = [threads](NodeId pNode) { return pNode % threads; };
+    auto bucketOf = [pDelta](double pDistance) { return static_cast<size_t>(pDistance / pDelta); };
+
+    /*buckets[o][b]: Nodes of thread o with a tentative distance in [b * delta, (b + 1) * delta); Entries become stale when the
+    distance of their node decreases and are skipped*/
+    std::vector<std::vector<std::vector<NodeId>>> buckets(threads);
+    /*requests[t * threads + o]: Requests created by thread t for nodes owned by thread o*/
+    std::vector<std::vector<Request>> requests(static_cast<size_t>(threads) * threads);
+    std::vector<std::vector<NodeId>> frontier(threads);
+    std::vector<std::vector<NodeId>> settled(threads);
+    /*Only written by the owner of a node, so no packed std::vector<bool>*/
+    std::vector<char> inSettled(nodeCount, 0);
+    std::vector<size_t> lastPhase(nodeCount, 0);
+
+    auto pushBucket = [&](NodeId pNode, double pDistance) {
+        std::vector<std::vector<NodeId>>& b = buckets[owner(pNode)];
+        const size_t index = bucketOf(pDistance);
+        if(index >= b.size())
+        {
+            b.resize(index + 1);
+        }
+        b[index].push_back(pNode);
+    };
+
+    /*Relaxes the edges of a node which are light (pLight) or heavy (!pLight) into the request lists of thread pThread*/
+    auto relaxEdges = [&](NodeId pNode, bool pLight, unsigned int pThread) {
+        std::span<const NodeId> neighbours = pBackward ? pGraph->getIncoming(pNode) : pGraph->getOutgoing(pNode);
+        std::span<const double> weights = pBackward ? pGraph->getIncomingWeights(pNode) : pGraph->getOutgoingWeights(pNode);
+        for(size_t i = 0; i < neighbours.size(); i++)
+        {
+            if((weights[i] <= pDelta) != pLight || (!pBlocked.empty() && pBlocked[neighbours[i]]))
+            {
+                continue;
+            }
+            requests[pThread * threads + owner(neighbours[i])].push_back(Request{neighbours[i], pNode, result.distance[pNode] + weights[i]});
+        }
+    };
+
+    /*Every thread applies the requests for its own nodes*/
+    auto applyRequests = [&](unsigned int pThread) {
+        for(unsigned int t = 0; t < threads; t++)
+        {
+            for(const Request& r : requests[t * threads + pThread])
+            {
+                if(r.distance < result.distance[r.node])
+                {
+                    result.distance[r.node] = r.distance;
+                    result.predecessor[r.node] = r.predecessor;
+                    pushBucket(r.node, r.distance);
+                }
+            }
+            requests[t * threads + pThread].clear();
+        }
+    };
+
+    pushBucket(pSource, 0.0);
+    size_t phase = 0;
+    for(size_t current = 0; ; current++)
+    {
+        /*Find the smallest bucket which is not empty*/
+        size_t bucketCount = 0;
+        for(const std::vector<std::vector<NodeId>>& b : buckets)
+        {
+            bucketCount = std::max(bucketCount, b.size());
+        }
+        while(current < bucketCount && std::all_of(buckets.begin(), buckets.end(), [current](const std::vector<std::vector<NodeId>>& b) {
+            return current >= b.size() || b[current].empty();
+        }))
+        {
+            current++;
+        }
+        if(current >= bucketCount)
+        {
+            break;
+        }
+
+        /*Light phases: Relax the light edges until no node falls into the current bucket anymore*/
+        while(true)
+        {
+            phase++;
+            pPool.run([&](unsigned int pThread) {
+                frontier[pThread].clear();
+                if(current < buckets[pThread].size())
+                {
+                    std::vector<NodeId> entries;
+                    entries.swap(buckets[pThread][current]);
+                    for(NodeId n : entries)
+                    {
+                        if(lastPhase[n] == phase || bucketOf(result.distance[n]) != current)
+                        {
+                            /*Duplicate or stale entry*/
+                            continue;
+                        }
+                        lastPhase[n] = phase;
+                        frontier[pThread].push_back(n);
+                        if(!inSettled[n])
+                        {
+                            inSettled[n] = 1;
+                            settled[pThread].push_back(n);
+                        }
+                    }
+                }
+                for(NodeId n : frontier[pThread])
+                {
+                    relaxEdges(n, true, pThread);
+                }
+            });
+            if(std::all_of(frontier.begin(), frontier.end(), [](const std::vector<NodeId>& f) { return f.empty(); }))
+            {
+                break;
+            }
+            pPool.run(applyRequests);
+        }
+
+        /*Heavy phase: The distances of the settled nodes are final, their heavy edges lead into later buckets*/
+        pPool.run([&](unsigned int pThread) {
+            for(NodeId n : settled[pThread])
+            {
+                relaxEdges(n, false, pThread);
+            }
+            settled[pThread].clear();
+        });
+        pPool.run(applyRequests);
+    }
+    return result;
+}
+NodeId ShortestPathTree::getSource() const
+{
+    return this->source;
+}
+bool ShortestPathTree::isReachable(NodeId pNode) const
+{
+    return pNode < this->distance.size() && this->distance[pNode] != std::numeric_limits<double>::infinity();
+}
+double ShortestPathTree::getDistance(NodeId pNode) const
+{
+    if(pNode >= this->distance.size())
+    {
+        return std::numeric_limits<double>::infinity();
+    }
+    return this->distance[pNode];
+}
+NodeId ShortestPathTree::getPredecessor(NodeId pNode) const
+{
+    if(pNode >= this->predecessor.size())
+    {
+        return CompactGraph::INVALID_NODE;
+    }
+    return this->predecessor[pNode];
+}
+const std::vector<double>& ShortestPathTree::getDistances() const
+{
+    return this->distance;
+}
+std::vector<NodeId> ShortestPathTree::getPath(NodeId pTarget) const
+{
+    if(!this->isReachable(pTarget))
+    {
+        return std::vector<NodeId>();
+    }
+    std::vector<NodeId> path;
+    NodeId currentNode = pTarget;
+    while(currentNode != this->source)
+    {
+        path.push_back(currentNode);
+        currentNode = this->predecessor[currentNode];
+    }
+    path.push_back(this->source);
+    if(!this->backward)
+    {
+        std::reverse(path.begin(), path.end());
+    }
+    return path;
+}
+std::vector<NodeType> ShortestPathTree::getPath(const NodeType& pTarget) const
+{
+    NodeId target = this->graph ? this->graph->getNodeId(pTarget) : this->lattice->getNodeId(pTarget);
+    if(target == CompactGraph::INVALID_NODE)
+    {
+        return std::vector<NodeType>();
+    }
+    return this->graph ? this->graph->toNodeNames(this->getPath(target)) : this->lattice->toNodeNames(this->getPath(target));
+}
+const CompactGraph& ShortestPathTree::getGraph() const
+{
+    if(!this->graph)
+    {
+        throw(std::runtime_error("ShortestPathTree::getGraph(): The tree was calculated on a lattice!"));
+    }
+    return *this->graph;
+}
\ No newline at end of file
@@ -0,0 +1,188 @@
+/**
+ * @file ShortestPathTree.hpp
+ * @author Lennart Hustermeier (lennart.hustermeier@gmx.de)
+ * @brief Contains a compact representation of the result of a single source shortest path search (Dijkstra)
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include "CompactGraph.hpp"
+#include "ThreadPool.hpp"
+#include <memory>
+
+class LatticeGraph;
+
+/**
+ * @brief The result of a single source shortest path search on a CompactGraph or a LatticeGraph, stored as predecessor and distance
+ * arrays. Paths are only reconstructed when they are requested.
+ */
+class ShortestPathTree
+{
+public:
+    /**
+     * @brief Runs Dijkstra's algorithm using a binary heap on a compact graph and returns the resulting shortest path tree
+     *
+     * @param pGraph The graph to search in
+     * @param pSource The source node of the search
+     * @param pBlocked Nodes which can not be entered (indexed by node ID); May be empty if there are no obstacles
+     * @param pTarget If this is a valid node, the search stops as soon as this node is settled; Distances of nodes which were not
+     * settled until then are not final
+     * @param pBackward If true, the search follows the incoming edges; The distances are then the costs from every node to pSource
+     * and the predecessor of a node is its next hop towards pSource
+     * @return ShortestPathTree The resulting shortest path tree
+     */
+    static ShortestPathTree compute(std::shared_ptr<const CompactGraph> pGraph, NodeId pSource, const std::vector<bool>& pBlocked=std::vector<bool>(), NodeId pTarget=CompactGraph::INVALID_NODE, bool pBackward=false);
+
+    /**
+     * @brief Runs Dijkstra's algorithm using a binary heap on an implicit lattice; Same as for compact graphs, the obstacles of the
+     * lattice are respected in addition to pBlocked
+     *
+     * @param pGraph The lattice to search in
+     * @param pSource The source node of the search
+     * @param pBlocked Nodes which can not be entered (indexed by node ID); May be empty if there are no additional obstacles
+     * @param pTarget If this is a valid node, the search stops as soon as this node is settled
+     * @param pBackward If true, the search follows the incoming edges (see above)
+     * @return ShortestPathTree The resulting shortest path tree
+     */
+    static ShortestPathTree compute(std::shared_ptr<const LatticeGraph> pGraph, NodeId pSource, const std::vector<bool>& pBlocked=std::vector<bool>(), NodeId pTarget=CompactGraph::INVALID_NODE, bool pBackward=false);
+
+    /**
+     * @brief Runs the parallel delta-stepping algorithm on a compact graph: Nodes are kept in buckets of width pDelta by their
+     * tentative distance; All nodes of the smallest bucket are settled at once by relaxing their light edges (weight <= pDelta)
+     * until the bucket stays empty and their heavy edges afterwards. Every node is owned by one thread of the pool, the threads
+     * exchange relaxation requests, so there are no concurrent writes. The distances are the same as the ones of compute(); If
+     * there are multiple shortest paths, the chosen predecessor may differ.
+     *
+     * @param pGraph The graph to search in
+     * @param pSource The source node of the search
+     * @param pPool The threads to run on
+     * @param pBlocked Nodes which can not be entered (indexed by node ID); May be empty if there are no obstacles
+     * @param pBackward If true, the search follows the incoming edges (see compute())
+     * @param pDelta The width of the buckets; 0 selects the average edge weight
+     * @return ShortestPathTree The resulting shortest path tree
+     */
+    static ShortestPathTree computeParallel(std::shared_ptr<const CompactGraph> pGraph, NodeId pSource, ThreadPool& pPool, const std::vector<bool>& pBlocked=std::vector<bool>(), bool pBackward=false, double pDelta=0.0);
+
+    /**
+     * @brief Returns the source node of the search
+     *
+     * @return NodeId The source node
+     */
+    NodeId getSource() const;
+
+    /**
+     * @brief Checks if a node was reached by the search
+     *
+     * @param pNode The node to check
+     * @return true There is a path from the source to pNode
+     * @return false The node was not reached (it is unreachable, blocked or the search stopped early)
+     */
+    bool isReachable(NodeId pNode) const;
+
+    /**
+     * @brief Returns the distance from the source to a node
+     *
+     * @param pNode The node to get the distance for
+     * @return double The distance or infinity if the node was not reached
+     */
+    double getDistance(NodeId pNode) const;
+
+    /**
+     * @brief Returns the predecessor of a node on its shortest path
+     *
+     * @param pNode The node to get the predecessor for
+     * @return NodeId The predecessor or CompactGraph::INVALID_NODE for the source and unreached nodes
+     */
+    NodeId getPredecessor(NodeId pNode) const;
+
+    /**
+     * @brief Returns the distances of all nodes (indexed by node ID; infinity for unreached nodes)
+     *
+     * @return const std::vector<double>& The distance array
+     */
+    const std::vector<double>& getDistances() const;
+
+    /**
+     * @brief Reconstructs the shortest path from the source to a node (from the node to the source for backward searches)
+     *
+     * @param pTarget The target node
+     * @return std::vector<NodeId> The path including the source and the target; Empty if the target was not reached
+     */
+    std::vector<NodeId> getPath(NodeId pTarget) const;
+
+    /**
+     * @brief Reconstructs the shortest path from the source to a node using node names
+     *
+     * @param pTarget The name of the target node
+     * @return std::vector<NodeType> The path including the source and the target; Empty if the target was not reached
+     */
+    std::vector<NodeType> getPath(const NodeType& pTarget) const;
+
+    /**
+     * @brief Returns the graph on which the search was performed; Throws std::runtime_error if the search ran on a lattice
+     *
+     * @return const CompactGraph& The underlying graph
+     */
+    const CompactGraph& getGraph() const;
+protected:
+    /**
+     * @brief Constructs an empty tree in which only the source is reached
+     *
+     * @param pGraph The graph of the search
+     * @param pSource The source of the search
+     * @param pBackward true for a search along the incoming edges
+     */
+    ShortestPathTree(std::shared_ptr<const CompactGraph> pGraph, NodeId pSource, bool pBackward);
+
+    /**
+     * @brief Constructs an empty tree on a lattice in which only the source is reached
+     *
+     * @param pGraph The lattice of the search
+     * @param pSource The source of the search
+     * @param pBackward true for a search along the incoming edges
+     */
+    ShortestPathTree(std::shared_ptr<const LatticeGraph> pGraph, NodeId pSource, bool pBackward);
+
+    /**
+     * @brief Runs Dijkstra's algorithm on any graph which provides forEachOutgoing() and forEachIncoming()
+     *
+     * @param pResult The tree to fill; Its arrays have to be initialized for the graph
+     * @param pGraph The graph to search in
+     */
+    template<class GraphType> static void run(ShortestPathTree& pResult, const GraphType& pGraph, NodeId pSource, const std::vector<bool>& pBlocked, NodeId pTarget, bool pBackward);
+
+    /**
+     * @brief The graph of the search if it ran on a compact graph; Kept alive to be able to translate node IDs
+     */
+    std::shared_ptr<const CompactGraph> graph;
+
+    /**
+     * @brief The lattice of the search if it ran on a lattice
+     */
+    std::shared_ptr<const LatticeGraph> lattice;
+
+    /**
+     * @brief The source node of the search
+     */
+    NodeId source;
+
+    /**
+     * @brief Stores if the search followed the incoming edges
+     */
+    bool backward;
+
+    /**
+     * @brief Stores the predecessor of each node on its shortest path
+     */
+    std::vector<NodeId> predecessor;
+
+    /**
+     * @brief Stores the distance from the source for each node
+     */
+    std::vector<double> distance;
+};
@@ -0,0 +1,38 @@
+/**
+ * @file SpaceTimeAStar.cpp
+ * @author Lennart Hustermeier (lennart.hustermeier@gmx.de)
+ * @brief Contains the implementation of A* extended to the time domain
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "SpaceTimeAStar.hpp"
+
+template<class GraphType> BasicSpaceTimeAStar<GraphType>::BasicSpaceTimeAStar(const GraphType& pGraph, std::pmr::memory_resource* pResource)
+: graph(pGraph), stateIndex(pResource), stateNode(pResource), stateTimestep(pResource), g(pResource), parent(pResource), closed(pResource),
+  open(pResource), expansions(0)
+{
+
+}
+template<class GraphType> size_t BasicSpaceTimeAStar<GraphType>::getExpansions() const
+{
+    return this->expansions;
+}
+template<class GraphType> void BasicSpaceTimeAStar<GraphType>::reset()
+{
+    this->stateIndex.clear();
+    this->stateNode.clear();
+    this->stateTimestep.clear();
+    this->g.clear();
+    this->parent.clear();
+    this->closed.clear();
+    this->open.clear();
+    this->expansions = 0;
+}
+template class BasicSpaceTimeAStar<CompactGraph>;
+template class BasicSpaceTimeAStar<LatticeGraph>;
+template class BasicSpaceTimeAStar<GraphSnapshot>;
+template class BasicSpaceTimeAStar<BlockedGraph>;
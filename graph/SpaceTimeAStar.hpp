@@ -0,0 +1,282 @@
+/**
+ * @file SpaceTimeAStar.hpp
+ * @author Lennart Hustermeier (lennart.hustermeier@gmx.de)
+ * @brief Contains the low level path finding algorithm (A* extended to the time domain) which operates on compact and lattice graphs
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include "BlockedGraph.hpp"
+#include "CompactGraph.hpp"
+#include "LatticeGraph.hpp"
+#include "GraphSnapshot.hpp"
+#include "IndexedHeap.hpp"
+#include "ReservationTable.hpp"
+#include <algorithm>
+#include <memory_resource>
+#include <optional>
+#include <unordered_map>
+
+/**
+ * @brief A* in the time expanded graph: A search state is a pair (<node>, <timestep>) and every move along an edge takes exactly
+ * one timestep. States are hashed, the open list is an indexed heap with decrease-key and the closed list is a flag per state.
+ * The search is limited by a horizon, so unsatisfiable constraints on the target can not lead to an infinite search.
+ *
+ * @tparam GraphType The graph to search in; Has to provide getNodeCount(), isBlocked(<node>) and
+ * forEachOutgoing(<node>, <callback(target, weight)>) (instantiated for CompactGraph, LatticeGraph, GraphSnapshot
+ * and BlockedGraph)
+ */
+template<class GraphType> class BasicSpaceTimeAStar
+{
+public:
+    /**
+     * @brief Creates a new search on a graph; The instance can be reused for multiple searches on the same graph
+     *
+     * @param pGraph The graph to search in
+     * @param pResource The memory resource for the per-search data (e.g. the SearchArena of the thread)
+     */
+    BasicSpaceTimeAStar(const GraphType& pGraph, std::pmr::memory_resource* pResource=std::pmr::get_default_resource());
+
+    /**
+     * @brief Searches a cost optimal path from pStart to pTarget which respects the obstacles and the constraints. A path is only
+     * accepted if the agent is allowed to stay on the target after reaching it.
+     *
+     * @tparam Heuristic Callable with the signature double(NodeId); Passed as concrete type, so it can be inlined into the search
+     * @param pStart The start node
+     * @param pTarget The target node
+     * @param pH The heuristic (estimated costs from a node to pTarget); Nodes with an infinite estimate are never expanded
+     * @param pBlocked Nodes which shall not be entered (indexed by node ID); May be empty if there are no obstacles
+     * @param pReservations The node and edge reservations which have to be respected
+     * @param pHorizon The maximum timestep which will be searched; 0 selects <last reserved timestep> + <number of nodes>, which is
+     * sufficient to find an optimal path if one exists
+     * @return std::vector<NodeId> The path (one node per timestep) or an empty vector if there is no such path
+     */
+    template<class Heuristic> std::vector<NodeId> findPath(NodeId pStart, NodeId pTarget, const Heuristic& pH, const std::vector<bool>& pBlocked, const ReservationTable& pReservations, unsigned int pHorizon=0)
+    {
+        this->reset();
+
+        const size_t nodeCount = this->graph.getNodeCount();
+        if(pStart >= nodeCount || pTarget >= nodeCount || this->graph.isBlocked(pStart) || this->graph.isBlocked(pTarget) ||
+           (!pBlocked.empty() && (pBlocked[pStart] || pBlocked[pTarget])))
+        {
+            return std::vector<NodeId>();
+        }
+
+        /*The agent stays on the target after reaching it; Thus the target is only accepted after its last reservation*/
+        std::optional<unsigned int> lastTargetConstraint = pReservations.getLastNodeReservation(pTarget);
+
+        if(pHorizon == 0)
+        {
+            /*After the last reservation any optimal continuation is a simple path with less than <number of nodes> steps*/
+            pHorizon = pReservations.getLastTimestep() + static_cast<unsigned int>(nodeCount);
+        }
+
+        double hStart = pH(pStart);
+        if(hStart == std::numeric_limits<double>::infinity())
+        {
+            return std::vector<NodeId>();
+        }
+        uint32_t startState = this->getState(pStart, 0);
+        this->g[startState] = 0.0;
+        this->open.push(startState, Key{hStart, 0, pStart});
+
+        while(!this->open.empty())
+        {
+            uint32_t current = this->open.pop();
+            this->closed[current] = true;
+            this->expansions++;
+
+            const NodeId currentNode = this->stateNode[current];
+            const unsigned int currentTimestep = this->stateTimestep[current];
+            const double currentG = this->g[current];
+
+            if(currentNode == pTarget && (!lastTargetConstraint.has_value() || currentTimestep > lastTargetConstraint.value()))
+            {
+                std::vector<NodeId> result;
+                result.reserve(currentTimestep + 1);
+                for(uint32_t s = current; s != IndexedHeap<Key>::NOT_IN_HEAP; s = this->parent[s])
+                {
+                    result.push_back(this->stateNode[s]);
+                }
+                std::reverse(result.begin(), result.end());
+                return result;
+            }
+
+            if(currentTimestep >= pHorizon)
+            {
+                continue;
+            }
+
+            /*Expand*/
+            const unsigned int nextTimestep = currentTimestep + 1;
+            const bool constrained = nextTimestep <= pReservations.getLastTimestep();
+
+            this->graph.forEachOutgoing(currentNode, [&](NodeId s, double pWeight) {
+                if(!pBlocked.empty() && pBlocked[s])
+                {
+                    /*Skip obstacles*/
+                    return;
+                }
+                if(constrained && !pReservations.isMoveAllowed(currentNode, s, nextTimestep))
+                {
+                    return;
+                }
+
+                const double tentativeG = currentG + pWeight;
+                const uint32_t successor = this->getState(s, nextTimestep);
+                if(this->closed[successor] || tentativeG >= this->g[successor])
+                {
+                    return;
+                }
+
+                double h = pH(s);
+                if(h == std::numeric_limits<double>::infinity())
+                {
+                    /*The target can not be reached from s*/
+                    return;
+                }
+
+                this->g[successor] = tentativeG;
+                this->parent[successor] = current;
+                Key key{tentativeG + h, nextTimestep, s};
+                if(this->open.contains(successor))
+                {
+                    this->open.decreaseKey(successor, key);
+                }
+                else
+                {
+                    this->open.push(successor, key);
+                }
+            });
+        }
+
+        return std::vector<NodeId>();
+    }
+
+    /**
+     * @brief Returns the number of states expanded by the last search
+     *
+     * @return size_t Number of expansions
+     */
+    size_t getExpansions() const;
+protected:
+    /**
+     * @brief The key by which the open list is ordered: f-value first, then the timestep and the node for deterministic ties
+     */
+    struct Key
+    {
+        double f;
+        unsigned int timestep;
+        NodeId node;
+
+        bool operator<(const Key& pOther) const
+        {
+            if(this->f != pOther.f)
+            {
+                return this->f < pOther.f;
+            }
+            if(this->timestep != pOther.timestep)
+            {
+                return this->timestep < pOther.timestep;
+            }
+            return this->node < pOther.node;
+        }
+    };
+
+    /**
+     * @brief Returns the index of the state (pNode, pTimestep), creating it if necessary
+     *
+     * @param pNode The node of the state
+     * @param pTimestep The timestep of the state
+     * @return uint32_t The index of the state in the state arrays
+     */
+    uint32_t getState(NodeId pNode, unsigned int pTimestep)
+    {
+        uint64_t packed = (static_cast<uint64_t>(pTimestep) << 32) | pNode;
+        std::pair<std::pmr::unordered_map<uint64_t, uint32_t>::iterator, bool> inserted = this->stateIndex.try_emplace(packed, static_cast<uint32_t>(this->stateNode.size()));
+        if(inserted.second)
+        {
+            this->stateNode.push_back(pNode);
+            this->stateTimestep.push_back(pTimestep);
+            this->g.push_back(std::numeric_limits<double>::infinity());
+            this->parent.push_back(IndexedHeap<Key>::NOT_IN_HEAP);
+            this->closed.push_back(false);
+        }
+        return inserted.first->second;
+    }
+
+    /**
+     * @brief Resets all per-search data while keeping the allocated memory
+     */
+    void reset();
+
+    /**
+     * @brief The graph to search in
+     */
+    const GraphType& graph;
+
+    /**
+     * @brief Maps the packed state (<timestep> << 32 | <node>) to its index
+     */
+    std::pmr::unordered_map<uint64_t, uint32_t> stateIndex;
+
+    /**
+     * @brief The node of every state
+     */
+    std::pmr::vector<NodeId> stateNode;
+
+    /**
+     * @brief The timestep of every state
+     */
+    std::pmr::vector<unsigned int> stateTimestep;
+
+    /**
+     * @brief The best known costs to reach every state
+     */
+    std::pmr::vector<double> g;
+
+    /**
+     * @brief The predecessor state of every state
+     */
+    std::pmr::vector<uint32_t> parent;
+
+    /**
+     * @brief The closed flag of every state
+     */
+    std::pmr::vector<bool> closed;
+
+    /**
+     * @brief The open list
+     */
+    IndexedHeap<Key> open;
+
+    /**
+     * @brief Counts the expansions of the last search
+     */
+    size_t expansions;
+};
+
+/**
+ * @brief The space-time A* on compact graphs
+ */
+typedef BasicSpaceTimeAStar<CompactGraph> SpaceTimeAStar;
+
+/**
+ * @brief The space-time A* on implicit lattices
+ */
+typedef BasicSpaceTimeAStar<LatticeGraph> LatticeSpaceTimeAStar;
+
+/**
+ * @brief The space-time A* on memory-mapped graph snapshots
+ */
+typedef BasicSpaceTimeAStar<GraphSnapshot> SnapshotSpaceTimeAStar;
+
+/**
+ * @brief The space-time A* on compact graphs with blocked nodes and edges
+ */
+typedef BasicSpaceTimeAStar<BlockedGraph> BlockedSpaceTimeAStar;
@@ -0,0 +1,142 @@
+/**
+ * @file ThreadPool.cpp
+ * @author Lennart Hustermeier (lennart.hustermeier@gmx.de)
+ * @brief Contains the implementation of the pool of persistent worker threads
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+
+ThreadPool::ThreadPool(unsigned int pThreads)
+: task(nullptr), generation(0), running(0), stop(false)
+{
+    if(pThreads == 0)
+    {
+        pThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    for(unsigned int i = 1; i < pThreads; i++)
+    {
+        this->workers.emplace_back(&ThreadPool::work, this, i);
+    }
+}
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->stop = true;
+    }
+    this->taskAvailable.notify_all();
+    for(std::thread& t : this->workers)
+    {
+        t.join();
+    }
+}
+unsigned int ThreadPool::getThreadCount() const
+{
+    return static_cast<unsigned int>(this->workers.size()) + 1;
+}
+void ThreadPool::run(const std::function<void(unsigned int)>& pTask)
+{
+    std::lock_guard<std::mutex> runLock(this->runMutex);
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->task = &pTask;
+        this->running = static_cast<unsigned int>(this->workers.size());
+        this->generation++;
+    }
+    this->taskAvailable.notify_all();
+
+    std::exception_ptr error;
+    try
+    {
+        pTask(0);
+    }
+    catch(...)
+    {
+        error = std::current_exception();
+    }
+
+    /*The workers reference pTask, so wait for them even if the calling thread failed*/
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->taskDone.wait(lock, [this]() { return this->running == 0; });
+    this->task = nullptr;
+    if(!error)
+    {
+        error = this->error;
+    }
+    this->error = nullptr;
+    if(error)
+    {
+        std::rethrow_exception(error);
+    }
+}
+void ThreadPool::parallelFor(size_t pCount, const std::function<void(size_t, size_t, unsigned int)>& pBody, size_t pChunkSize)
+{
+    if(pCount == 0)
+    {
+        return;
+    }
+    if(pChunkSize == 0)
+    {
+        pChunkSize = std::max<size_t>(1, pCount / (4 * this->getThreadCount()));
+    }
+    if(pCount <= pChunkSize || this->workers.empty())
+    {
+        /*Not worth waking the workers*/
+        pBody(0, pCount, 0);
+        return;
+    }
+
+    std::atomic<size_t> next(0);
+    this->run([&](unsigned int pThread) {
+        for(size_t begin = next.fetch_add(pChunkSize); begin < pCount; begin = next.fetch_add(pChunkSize))
+        {
+            pBody(begin, std::min(begin + pChunkSize, pCount), pThread);
+        }
+    });
+}
+void ThreadPool::work(unsigned int pIndex)
+{
+    size_t seen = 0;
+    while(true)
+    {
+        const std::function<void(unsigned int)>* current;
+        {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            this->taskAvailable.wait(lock, [&]() { return this->stop || this->generation != seen; });
+            if(this->stop)
+            {
+                return;
+            }
+            seen = this->generation;
+            current = this->task;
+        }
+
+        std::exception_ptr error;
+        try
+        {
+            (*current)(pIndex);
+        }
+        catch(...)
+        {
+            error = std::current_exception();
+        }
+
+        std::lock_guard<std::mutex> lock(this->mutex);
+        if(error && !this->error)
+        {
+            this->error = error;
+        }
+        if(--this->running == 0)
+        {
+            this->taskDone.notify_one();
+        }
+    }
+}
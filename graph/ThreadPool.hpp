@@ -0,0 +1,126 @@
+/**
+ * @file ThreadPool.hpp
+ * @author Lennart Hustermeier (lennart.hustermeier@gmx.de)
+ * @brief Contains a pool of persistent worker threads for data parallel loops
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief A fixed set of worker threads which are started once and then execute parallel loops; In contrast to spawning threads
+ * per loop, a loop only costs a wake up and a join of the already running workers. The calling thread participates in every
+ * loop, so a pool with n threads starts n - 1 workers. Loops are executed one after another; A loop must not start another loop
+ * on the same pool.
+ */
+class ThreadPool
+{
+public:
+    /**
+     * @brief Starts the workers
+     *
+     * @param pThreads The number of threads including the calling thread; 0 selects the number of hardware threads
+     */
+    ThreadPool(unsigned int pThreads=0);
+
+    /**
+     * @brief Stops and joins all workers
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Returns the number of threads which execute a loop (including the calling thread)
+     *
+     * @return unsigned int Number of threads
+     */
+    unsigned int getThreadCount() const;
+
+    /**
+     * @brief Runs pTask once on every thread and returns when all of them are done; If a thread throws, the first exception is
+     * rethrown after all threads are done
+     *
+     * @param pTask Callable which gets the index of the thread in [0, getThreadCount()); The calling thread has index 0
+     */
+    void run(const std::function<void(unsigned int)>& pTask);
+
+    /**
+     * @brief Splits [0, pCount) into chunks which are processed in parallel and returns when all of them are done
+     *
+     * @param pCount The number of iterations
+     * @param pBody Callable which gets a range [begin, end) and the index of the executing thread
+     * @param pChunkSize The number of iterations handed to a thread at once; 0 selects a size which gives every thread a few chunks
+     */
+    void parallelFor(size_t pCount, const std::function<void(size_t, size_t, unsigned int)>& pBody, size_t pChunkSize=0);
+protected:
+    /**
+     * @brief The loop of a worker: Waits for a task, runs it and reports its completion
+     *
+     * @param pIndex The index of the worker thread
+     */
+    void work(unsigned int pIndex);
+
+    /**
+     * @brief The worker threads
+     */
+    std::vector<std::thread> workers;
+
+    /**
+     * @brief Serializes the loops of different callers
+     */
+    std::mutex runMutex;
+
+    /**
+     * @brief Protects the fields below
+     */
+    std::mutex mutex;
+
+    /**
+     * @brief Wakes the workers when a task is available
+     */
+    std::condition_variable taskAvailable;
+
+    /**
+     * @brief Wakes the caller when all workers are done
+     */
+    std::condition_variable taskDone;
+
+    /**
+     * @brief The current task
+     */
+    const std::function<void(unsigned int)>* task;
+
+    /**
+     * @brief Incremented for every task, so a worker can tell a new task from the one it already ran
+     */
+    size_t generation;
+
+    /**
+     * @brief The number of workers which still run the current task
+     */
+    unsigned int running;
+
+    /**
+     * @brief The first exception thrown by a worker during the current task
+     */
+    std::exception_ptr error;
+
+    /**
+     * @brief Set to stop the workers
+     */
+    bool stop;
+};
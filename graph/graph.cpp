@@ -10,6 +10,10 @@
  */
 
 #include "graph.hpp"
+#include "BidirectionalSearch.hpp"
+#include "SearchArena.hpp"
+#include "SpaceTimeAStar.hpp"
+#include "ContractionHierarchy.hpp"
 #include <queue>
 #include <algorithm>
 #include <numeric>
@@ -71,6 +75,7 @@ bool Graph::addNode(NodeType pNode)
         this->nodes.insert(pNode);
         this->edges[pNode] = std::set<NodeType>();
         this->edgesIn[pNode] = std::set<NodeType>();
+        this->invalidateCompactGraph();
         return true;
     }
 }
@@ -84,6 +89,7 @@ bool Graph::addEdge(std::pair<NodeType, NodeType> pEdge, double pWeight)
             e.insert(pEdge.second);
             this->edgesIn.at(pEdge.second).insert(pEdge.first);
             this->weights[std::make_pair(pEdge.first, pEdge.second)] = pWeight;
+            this->invalidateCompactGraph();
             return true;
         }
         else
@@ -109,17 +115,21 @@ bool Graph::removeNode(NodeType pNode)
     if(this->nodes.count(pNode) > 0)
     {
         this->nodes.erase(pNode);
-        std::set<NodeType>& outgoingEdges = this->edges.at(pNode);
-        for(NodeType n : outgoingEdges)
+
+        /*Only the neighbours refer to the node, so there is no need to visit all edges*/
+        for(const NodeType& n : this->edges.at(pNode))
         {
             this->weights.erase(std::make_pair(pNode, n));
+            this->edgesIn.at(n).erase(pNode);
         }
-        outgoingEdges.clear();
-        this->edges.erase(pNode);
-        for(std::pair<NodeType, std::set<NodeType>> i : this->edgesIn)
+        for(const NodeType& n : this->edgesIn.at(pNode))
         {
-            this->edgesIn.at(i.first).erase(pNode);
+            this->weights.erase(std::make_pair(n, pNode));
+            this->edges.at(n).erase(pNode);
         }
+        this->edges.erase(pNode);
+        this->edgesIn.erase(pNode);
+        this->invalidateCompactGraph();
         return true;
     }
     else
@@ -137,6 +147,7 @@ bool Graph::removeEdge(std::pair<NodeType, NodeType> pEdge)
             e.erase(pEdge.second);
             this->edgesIn.at(pEdge.second).erase(pEdge.first);
             this->weights.erase(std::make_pair(pEdge.first, pEdge.second));
+            this->invalidateCompactGraph();
             return true;
         }
         else
@@ -224,94 +235,153 @@ std::map<NodeType, double> Graph::getIncomingEdgesWithWeights(NodeType pNode) co
         return std::map<NodeType, double>();
     }
 }
-std::map<NodeType, std::vector<NodeType>> Graph::getAllShortestPaths(NodeType pStart, std::set<NodeType> pObstacles) const
+ShortestPathTree Graph::getShortestPathTree(NodeType pStart, const std::set<NodeType>& pObstacles, std::optional<NodeType> pTarget) const
 {
-    if(this->nodes.count(pStart) == 0 || pObstacles.count(pStart) > 0)
+    std::shared_ptr<const BlockedGraph> layer = this->getActiveBlockedGraph();
+    std::shared_ptr<const CompactGraph> compact = layer ? layer->getGraph() : this->getCompactGraph();
+    NodeId target = CompactGraph::INVALID_NODE;
+    if(pTarget.has_value())
     {
-        return std::map<NodeType, std::vector<NodeType>>();
+        target = compact->getNodeId(pTarget.value());
     }
+    ObstacleMask blocked(*compact, pObstacles, layer.get());
+    return ShortestPathTree::compute(compact, compact->getNodeId(pStart), blocked.get(), target);
+}
+HopDistanceMatrix Graph::getHopDistances(const std::vector<NodeType>& pSources, const std::set<NodeType>& pObstacles, bool pBackward) const
+{
+    std::shared_ptr<const BlockedGraph> layer = this->getActiveBlockedGraph();
+    std::shared_ptr<const CompactGraph> compact = layer ? layer->getGraph() : this->getCompactGraph();
+    std::vector<NodeId> sources;
+    sources.reserve(pSources.size());
+    for(const NodeType& s : pSources)
+    {
+        sources.push_back(compact->getNodeId(s));
+    }
+    ObstacleMask blocked(*compact, pObstacles, layer.get());
+    return HopDistanceMatrix::compute(compact, sources, blocked.get(), pBackward);
+}
+std::shared_ptr<ContractionHierarchy> Graph::getContractionHierarchy(ThreadPool& pPool) const
+{
+    return ContractionHierarchy::build(this->getCompactGraph(), pPool);
+}
+ShortestPathTree Graph::getShortestPathTree(NodeType pStart, ThreadPool& pPool, const std::set<NodeType>& pObstacles) const
+{
+    std::shared_ptr<const BlockedGraph> layer = this->getActiveBlockedGraph();
+    std::shared_ptr<const CompactGraph> compact = layer ? layer->getGraph() : this->getCompactGraph();
+    ObstacleMask blocked(*compact, pObstacles, layer.get());
+    return ShortestPathTree::computeParallel(compact, compact->getNodeId(pStart), pPool, blocked.get());
+}
+std::map<NodeType, std::vector<NodeType>> Graph::getAllShortestPaths(NodeType pStart, const std::set<NodeType>& pObstacles) const
+{
+    std::map<NodeType, std::vector<NodeType>> result;
+    ShortestPathTree tree = this->getShortestPathTree(pStart, pObstacles);
+    const CompactGraph& compact = tree.getGraph();
 
-    std::map<NodeType, NodeType> predecessor;
-    std::map<NodeType, double> Q;
-
-    for(NodeType n : this->nodes)
+    for(NodeId n = 0; n < compact.getNodeCount(); n++)
     {
-        if(pObstacles.count(n) > 0)
+        if(n == tree.getSource() || !tree.isReachable(n))
         {
+            /*Skip the start node as well as obstacles and unreachable nodes*/
             continue;
         }
-        if(n == pStart)
-        {
-            Q[n] = 0.0;
-        }
-        else
-        {
-            Q[n] = std::numeric_limits<double>::infinity();
-        }
-        
+        result[compact.getNodeName(n)] = compact.toNodeNames(tree.getPath(n));
     }
-
-    while(!Q.empty())
+    return result;
+}
+Graph::ObstacleMask::ObstacleMask(const CompactGraph& pCompact, const std::set<NodeType>& pObstacles, const BlockedGraph* pLayer)
+{
+    thread_local std::vector<bool> mask;
+    thread_local bool used = false;
+    this->threadMask = nullptr;
+    this->threadMaskUsed = nullptr;
+    this->layerMarked = pLayer != nullptr && pLayer->getBlockedCount() > 0;
+    if(pObstacles.empty() && !this->layerMarked)
     {
-        NodeType u = std::min_element(Q.begin(), Q.end(), [](std::pair<const NodeType, double> p1, std::pair<const NodeType, double> p2) { return p1.second < p2.second; } )->first;
-        double distance = Q[u];
-        Q.erase(u);
-        const std::set<NodeType>& neighbours = this->edges.at(u);
-        for(NodeType v : neighbours)
-        {
-            if(pObstacles.count(v))
-            {
-                continue;
-            }
-            if(Q.count(v) > 0)
-            {
-                double alt = distance + this->weights.at(std::make_pair(u, v));
-                if(alt < Q[v])
-                {
-                    Q[v] = alt;
-                    predecessor[v] = u;
-                }
-            }
-        }
+        /*An empty vector is interpreted as "nothing blocked" by the search functions*/
+        return;
     }
-
-    std::map<NodeType, std::vector<NodeType>> result;
-    for(NodeType n : this->nodes)
+    std::vector<bool>* target = &this->ownMask;
+    if(!used)
     {
-        if(pObstacles.count(n))
+        /*Idle, the vector of the thread is all false, so resizing it does not leave marks of other graphs*/
+        used = true;
+        this->threadMaskUsed = &used;
+        this->threadMask = &mask;
+        target = &mask;
+    }
+    target->resize(pCompact.getNodeCount(), false);
+    if(this->layerMarked)
+    {
+        for(NodeId n = 0; n < target->size(); n++)
         {
-            continue;
+            (*target)[n] = pLayer->isBlocked(n);
         }
-        if(n == pStart)
+    }
+    for(const NodeType& o : pObstacles)
+    {
+        NodeId id = pCompact.getNodeId(o);
+        if(id != CompactGraph::INVALID_NODE && !(*target)[id])
         {
-            continue;
+            (*target)[id] = true;
+            this->marked.push_back(id);
         }
-        std::vector<NodeType> path;
-        NodeType currentNode = n;
-        while(currentNode != pStart)
+    }
+}
+Graph::ObstacleMask::~ObstacleMask()
+{
+    if(this->threadMask == nullptr)
+    {
+        return;
+    }
+    if(this->layerMarked)
+    {
+        std::fill(this->threadMask->begin(), this->threadMask->end(), false);
+    }
+    else
+    {
+        for(NodeId n : this->marked)
         {
-            path.push_back(currentNode);
-            currentNode = predecessor[currentNode];
+            (*this->threadMask)[n] = false;
         }
-        path.push_back(pStart);
-        std::reverse(path.begin(), path.end());
-        result[n] = path;
     }
-    return result;
+    *this->threadMaskUsed = false;
+}
+const std::vector<bool>& Graph::ObstacleMask::get() const
+{
+    return this->threadMask != nullptr ? *this->threadMask : this->ownMask;
 }
 Graph::Graph(const Graph& pOther)
 {
     this->edges = pOther.edges;
-    this->edgesIn = pOther.edges;
+    this->edgesIn = pOther.edgesIn;
     this->nodes = pOther.nodes;
     this->weights = pOther.weights;
+
+    /*The compact representation is immutable and can thus be shared between copies; Build it on the original, so all further
+    copies share it as well (e.g. for caches which are bound to a compact graph)*/
+    this->compactGraph = pOther.getCompactGraph();
+
+    /*The obstacle layer is mutable and thus copied*/
+    std::lock_guard<std::mutex> lock(pOther.compactGraphMutex);
+    if(pOther.blockedGraph)
+    {
+        this->blockedGraph = std::make_shared<BlockedGraph>(*pOther.blockedGraph);
+    }
 }
 Graph& Graph::operator=(Graph& pOther)
 {
+    if(this == &pOther)
+    {
+        return *this;
+    }
     this->edges = pOther.edges;
-    this->edgesIn = pOther.edges;
+    this->edgesIn = pOther.edgesIn;
     this->nodes = pOther.nodes;
     this->weights = pOther.weights;
+
+    std::scoped_lock lock(this->compactGraphMutex, pOther.compactGraphMutex);
+    this->compactGraph = pOther.compactGraph;
+    this->blockedGraph = pOther.blockedGraph ? std::make_shared<BlockedGraph>(*pOther.blockedGraph) : nullptr;
     return *this;
 }
 Graph::~Graph()
@@ -321,202 +391,222 @@ Graph::~Graph()
     this->nodes.clear();
     this->weights.clear();
 }
-std::map<NodeType, std::pair<std::vector<NodeType>, double>> Graph::getAllShortestPathsWithCosts(NodeType pStart, std::set<NodeType> pObstacles) const
+std::map<NodeType, std::pair<std::vector<NodeType>, double>> Graph::getAllShortestPathsWithCosts(NodeType pStart, const std::set<NodeType>& pObstacles) const
 {
-    std::map<NodeType, std::vector<NodeType>> shortestPaths = this->getAllShortestPaths(pStart, pObstacles);
     std::map<NodeType, std::pair<std::vector<NodeType>, double>> result;
+    ShortestPathTree tree = this->getShortestPathTree(pStart, pObstacles);
+    const CompactGraph& compact = tree.getGraph();
 
-    while(!shortestPaths.empty())
+    for(NodeId n = 0; n < compact.getNodeCount(); n++)
     {
-        std::pair<NodeType, std::vector<NodeType>> p = *shortestPaths.begin();
-        double sum = 0.0;
-        NodeType lastNode = pStart;
-        std::for_each(p.second.begin() + 1, p.second.end(), [&](const NodeType& pNode) { sum += this->weights.at(std::make_pair(lastNode, pNode)); lastNode = pNode; });
-        result[p.first] = std::make_pair(p.second, sum);
-        shortestPaths.erase(p.first);
+        if(n == tree.getSource() || !tree.isReachable(n))
+        {
+            continue;
+        }
+        result[compact.getNodeName(n)] = std::make_pair(compact.toNodeNames(tree.getPath(n)), tree.getDistance(n));
     }
     return result;
 }
-bool Graph::checkPathConstraints(const std::vector<NodeType>& pPath, const std::map<unsigned int, std::set<NodeType>> pConstraints) const
+std::map<NodeType, std::pair<std::vector<NodeType>, double>> Graph::getAllShortestPathsWithCosts(NodeType pStart, ThreadPool& pPool, const std::set<NodeType>& pObstacles) const
 {
-    unsigned int cntr = 0;
-    for(cntr=0; cntr<pPath.size(); cntr++)
+    std::map<NodeType, std::pair<std::vector<NodeType>, double>> result;
+    ShortestPathTree tree = this->getShortestPathTree(pStart, pPool, pObstacles);
+    const CompactGraph& compact = tree.getGraph();
+
+    for(NodeId n = 0; n < compact.getNodeCount(); n++)
     {
-        if(pConstraints.count(cntr) > 0)
+        if(n == tree.getSource() || !tree.isReachable(n))
         {
-            if(pConstraints.at(cntr).count(pPath[cntr]) > 0)
-            {
-                return false;
-            }
+            continue;
         }
+        result[compact.getNodeName(n)] = std::make_pair(compact.toNodeNames(tree.getPath(n)), tree.getDistance(n));
     }
-    return true;
+    return result;
 }
-struct State
+bool Graph::checkPathConstraints(const std::vector<NodeType>& pPath, const std::map<unsigned int, std::set<NodeType>> pConstraints) const
 {
-    unsigned int timestep;
-    NodeType node;
-    double f;
-
-    State(NodeType pNode, unsigned int pTimestep, double pF)
+    std::shared_ptr<const CompactGraph> compact = this->getCompactGraph();
+    return this->checkPathConstraints(pPath, Graph::getReservationTable(*compact, pConstraints));
+}
+bool Graph::checkPathConstraints(const std::vector<NodeType>& pPath, const ReservationTable& pReservations) const
+{
+    if(pReservations.empty())
     {
-        this->node = pNode;
-        this->timestep = pTimestep;
-        this->f = pF;
+        return true;
     }
-    bool operator<(const State& pOther) const 
+    return pReservations.isPathAllowed(this->getCompactGraph()->toNodeIds(pPath));
+}
+std::vector<NodeType> Graph::getShortestPath(NodeType pStart, NodeType pTarget, std::function<double(NodeType, NodeType)> pH, const std::set<NodeType>& pObstacles, std::map<unsigned int, std::set<NodeType>> pConstraints, unsigned int pHorizon) const
+{
+    std::shared_ptr<const CompactGraph> compact = this->getCompactGraph();
+    return this->getShortestPath(pStart, pTarget, pH, pObstacles, Graph::getReservationTable(*compact, pConstraints), pHorizon);
+}
+std::vector<NodeType> Graph::getShortestPath(NodeType pStart, NodeType pTarget, std::function<double(NodeType, NodeType)> pH, const std::set<NodeType>& pObstacles, const ReservationTable& pReservations, unsigned int pHorizon) const
+{
+    std::shared_ptr<const BlockedGraph> layer = this->getActiveBlockedGraph();
+    std::shared_ptr<const CompactGraph> compact = layer ? layer->getGraph() : this->getCompactGraph();
+    NodeId start = compact->getNodeId(pStart);
+    NodeId target = compact->getNodeId(pTarget);
+    if(start == CompactGraph::INVALID_NODE || target == CompactGraph::INVALID_NODE || pObstacles.count(pStart) > 0)
     {
-        if(this->f < pOther.f)
-        {
-            return true;
-        }
-        else if(this->f == pOther.f)
-        {
-            if(this->timestep < pOther.timestep)
-            {
-                return true;
-            }
-            else if(this->timestep == pOther.timestep)
-            {
-                return this->node < pOther.node;
-            }
-            else
-            {
-                return false;
-            }
-        }
-        else
-        {
-            return false;
-        }
+        return std::vector<NodeType>();
     }
-    State& operator=(const State& pOther)
+    if(pReservations.empty() && pHorizon == 0)
     {
-        this->f = pOther.f;
-        this->node = pOther.node;
-        this->timestep = pOther.timestep;
-        return *this;
+        /*Without constraints time does not matter -> point-to-point query*/
+        return this->getShortestPathBidirectional(pStart, pTarget, pH, pObstacles);
     }
-};
-bool operator<(const std::pair<unsigned int, NodeType>& p1, const std::pair<unsigned int, NodeType>& p2)
-{
-    return p1.first <= p2.first || (p1.first == p2.first && p1.second < p2.second);
+
+    /*The obstacle layer is only searched if it blocks anything, the plain compact graph needs no bit tests*/
+    ObstacleMask blocked(*compact, pObstacles);
+    auto run = [&](const auto& pGraph) {
+        SearchArena::Scope scope;
+        BasicSpaceTimeAStar<std::decay_t<decltype(pGraph)>> search(pGraph, scope.getResource());
+        return search.findPath(start, target, [&](NodeId pNode) { return pH(compact->getNodeName(pNode), pTarget); },
+                               blocked.get(), pReservations, pHorizon);
+    };
+    return compact->toNodeNames(layer ? run(*layer) : run(*compact));
 }
-std::vector<NodeType> Graph::getShortestPath(NodeType pStart, NodeType pTarget, std::function<double(NodeType, NodeType)> pH, std::set<NodeType> pObstacles, std::map<unsigned int, std::set<NodeType>> pConstraints) const
+std::vector<NodeType> Graph::getShortestPath(NodeType pStart, NodeType pTarget, HeuristicProvider& pHeuristicProvider, const std::set<NodeType>& pObstacles, const ReservationTable& pReservations, unsigned int pHorizon) const
 {
-    if(this->nodes.count(pStart) == 0 || this->nodes.count(pTarget) == 0 || pObstacles.count(pStart) > 0)
+    std::shared_ptr<const BlockedGraph> layer = this->getActiveBlockedGraph();
+    std::shared_ptr<const CompactGraph> compact = layer ? layer->getGraph() : this->getCompactGraph();
+    NodeId start = compact->getNodeId(pStart);
+    NodeId target = compact->getNodeId(pTarget);
+    if(start == CompactGraph::INVALID_NODE || target == CompactGraph::INVALID_NODE || pObstacles.count(pStart) > 0)
     {
         return std::vector<NodeType>();
     }
 
-    std::set<State> openList;
-    std::map<unsigned int, std::set<NodeType>> closedList;
-    std::map<std::pair<unsigned int, NodeType>, std::pair<unsigned int, NodeType>> predecessor;
-    std::map<NodeType, double> g;
+    /*Obstacles only make paths longer, so the heuristics of the unrestricted graph stay admissible*/
+    std::function<double(NodeId)> h = pHeuristicProvider.getHeuristic(compact, target);
+    ObstacleMask blocked(*compact, pObstacles);
+    if(pReservations.empty() && pHorizon == 0)
+    {
+        /*Without constraints time does not matter -> point-to-point query; The provider only estimates the costs to the target,
+        so the backward search runs without heuristic. The search of the thread is reused, so only the nodes touched by the
+        previous query have to be reset*/
+        auto run = [&]<class GraphType>(const std::shared_ptr<const GraphType>& pGraph) {
+            BasicBidirectionalSearch<GraphType>& search = BasicBidirectionalSearch<GraphType>::getThreadSearch(pGraph);
+            return search.findPath(start, target, h, [](NodeId) { return 0.0; }, blocked.get());
+        };
+        return compact->toNodeNames(layer ? run(layer) : run(compact));
+    }
 
-    for(const NodeType& n : this->nodes)
+    auto run = [&](const auto& pGraph) {
+        SearchArena::Scope scope;
+        BasicSpaceTimeAStar<std::decay_t<decltype(pGraph)>> search(pGraph, scope.getResource());
+        return search.findPath(start, target, h, blocked.get(), pReservations, pHorizon);
+    };
+    return compact->toNodeNames(layer ? run(*layer) : run(*compact));
+}
+std::vector<NodeType> Graph::getShortestPathBidirectional(NodeType pStart, NodeType pTarget, std::function<double(NodeType, NodeType)> pH, const std::set<NodeType>& pObstacles) const
+{
+    std::shared_ptr<const BlockedGraph> layer = this->getActiveBlockedGraph();
+    std::shared_ptr<const CompactGraph> compact = layer ? layer->getGraph() : this->getCompactGraph();
+    NodeId start = compact->getNodeId(pStart);
+    NodeId target = compact->getNodeId(pTarget);
+    if(start == CompactGraph::INVALID_NODE || target == CompactGraph::INVALID_NODE || pObstacles.count(pStart) > 0)
     {
-        if(pObstacles.count(n) > 0)
-        {
-            /*Skip obstacles*/
-            continue;
-        }
-        g[n] = 0.0;
+        return std::vector<NodeType>();
     }
 
-    openList.insert(State(pStart, 0, 0));
-    
-    do
+    /*The search of the thread is reused, so only the nodes touched by the previous query have to be reset*/
+    ObstacleMask blocked(*compact, pObstacles);
+    auto run = [&]<class GraphType>(const std::shared_ptr<const GraphType>& pGraph) {
+        BasicBidirectionalSearch<GraphType>& search = BasicBidirectionalSearch<GraphType>::getThreadSearch(pGraph);
+        return search.findPath(start, target, [&](NodeId pNode) { return pH(compact->getNodeName(pNode), pTarget); },
+                               [&](NodeId pNode) { return pH(pStart, compact->getNodeName(pNode)); }, blocked.get());
+    };
+    return compact->toNodeNames(layer ? run(layer) : run(compact));
+}
+ReservationTable Graph::getReservationTable(const CompactGraph& pCompact, const std::map<unsigned int, std::set<NodeType>>& pConstraints)
+{
+    ReservationTable result;
+    for(const auto& c : pConstraints)
     {
-        State currentState = *openList.begin();
-        openList.erase(currentState);
-        
-        if(currentState.node == pTarget)
+        for(const NodeType& n : c.second)
         {
-            /*We are at our target position; Check if there are future constraints which forbid staying here*/
-            bool constrained = false;
-
-            if(pConstraints.size() > 0)
-            {
-                unsigned int t = 0;
-                for(t = currentState.timestep; t <= pConstraints.rbegin()->first; t++)
-                {
-                    if(pConstraints[t].contains(pTarget))
-                    {
-                        /*We might be on the right node but we are not allowed to stay -> continue A**/
-                        constrained = true;
-                        break;
-                    }
-                }
-            }
-            if(!constrained)
+            NodeId id = pCompact.getNodeId(n);
+            if(id != CompactGraph::INVALID_NODE)
             {
-                std::vector<NodeType> result;
-                std::pair<unsigned int, NodeType> c = std::make_pair(currentState.timestep, currentState.node);
-                while(predecessor.contains(c))
-                {
-                    //std::cout << c.first << ": " << c.second << std::endl;
-                    result.push_back(c.second);
-                    c = predecessor[c];
-                }
-                result.push_back(pStart);
-                std::reverse(result.begin(), result.end());
-                return result;
+                result.reserveNode(id, c.first);
             }
         }
-
-        closedList[currentState.timestep].insert(currentState.node);
-
-        /*Expand*/
-        std::set<NodeType> successors;
-        if(this->edges.contains(currentState.node))
-        {
-            successors = this->edges.at(currentState.node);
-        }
-        for(NodeType s : successors)
+    }
+    return result;
+}
+std::shared_ptr<const CompactGraph> Graph::getCompactGraph() const
+{
+    std::lock_guard<std::mutex> lock(this->compactGraphMutex);
+    if(!this->compactGraph)
+    {
+        this->compactGraph = std::make_shared<const CompactGraph>(this->nodes, this->edges, this->weights);
+    }
+    return this->compactGraph;
+}
+void Graph::invalidateCompactGraph()
+{
+    std::lock_guard<std::mutex> lock(this->compactGraphMutex);
+    this->compactGraph.reset();
+}
+bool Graph::setBlocked(NodeType pNode, bool pBlocked)
+{
+    std::shared_ptr<BlockedGraph> layer = this->getBlockedGraph();
+    NodeId id = layer->getNodeId(pNode);
+    if(id == CompactGraph::INVALID_NODE)
+    {
+        return false;
+    }
+    layer->setBlocked(id, pBlocked);
+    return true;
+}
+bool Graph::setEdgeBlocked(NodeType pFrom, NodeType pTo, bool pBlocked)
+{
+    std::shared_ptr<BlockedGraph> layer = this->getBlockedGraph();
+    NodeId from = layer->getNodeId(pFrom);
+    NodeId to = layer->getNodeId(pTo);
+    if(from == CompactGraph::INVALID_NODE || to == CompactGraph::INVALID_NODE)
+    {
+        return false;
+    }
+    return layer->setEdgeBlocked(from, to, pBlocked);
+}
+bool Graph::isBlocked(NodeType pNode) const
+{
+    std::shared_ptr<const BlockedGraph> layer = this->getActiveBlockedGraph();
+    if(!layer)
+    {
+        return false;
+    }
+    NodeId id = layer->getNodeId(pNode);
+    return id != CompactGraph::INVALID_NODE && layer->isBlocked(id);
+}
+std::shared_ptr<BlockedGraph> Graph::getBlockedGraph() const
+{
+    std::shared_ptr<const CompactGraph> compact = this->getCompactGraph();
+    std::lock_guard<std::mutex> lock(this->compactGraphMutex);
+    if(!this->blockedGraph)
+    {
+        this->blockedGraph = std::make_shared<BlockedGraph>(compact);
+    }
+    else if(this->blockedGraph->getGraph() != compact)
+    {
+        /*The structure changed -> move the obstacles to the new compact graph*/
+        this->blockedGraph = std::make_shared<BlockedGraph>(compact, *this->blockedGraph);
+    }
+    return this->blockedGraph;
+}
+std::shared_ptr<const BlockedGraph> Graph::getActiveBlockedGraph() const
+{
+    {
+        std::lock_guard<std::mutex> lock(this->compactGraphMutex);
+        if(!this->blockedGraph || this->blockedGraph->getBlockedCount() == 0)
         {
-            if(pObstacles.count(s) > 0)
-            {
-                /*Skip obstacles*/
-                continue;
-            }
-            if(pConstraints.contains(currentState.timestep+1) && pConstraints.at(currentState.timestep+1).contains(s))
-            {
-                continue;
-            }
-
-            if(closedList.contains(currentState.timestep+1) && closedList.at(currentState.timestep+1).contains(s))
-            {
-                /*In closed list*/
-                continue;
-            }
-
-            double tentativeG = g[currentState.node] + this->weights.at(std::make_pair(currentState.node, s));
-
-            std::set<State>::iterator l = std::find_if(openList.begin(), openList.end(), [&](const State& a) { return a.node == s; });
-
-            if(l != openList.end() && tentativeG >= g[s])
-            {
-                continue;
-            }
-
-            predecessor[std::make_pair(currentState.timestep + 1, s)] = std::make_pair(currentState.timestep, currentState.node);
-            g[s] = tentativeG;
-            /*calculate the heuristic for the original (non virtual) successor s*/
-            double fValue = tentativeG + pH(s, pTarget);
-            if(l != openList.end())
-            {
-                openList.erase(l);
-                openList.insert(State(s, currentState.timestep+1, fValue));
-            }
-            else
-            {
-                openList.insert(State(s, currentState.timestep+1, fValue));
-            }
+            return nullptr;
         }
-    } while(!openList.empty());
-
-    return std::vector<NodeType>();
+    }
+    return this->getBlockedGraph();
 }
 NodeType Graph::generateNewNode() const
 {
@@ -540,16 +630,6 @@ double Graph::getPathCost(const std::vector<NodeType>& pPath) const
         return 0.0;
     }
 
-    std::vector<NodeType>::const_iterator i = pPath.begin();
-    std::vector<NodeType>::const_iterator lastNode = i;
-    ++i;
-    double sum = 0.0;
-    while(i != pPath.end())
-    {
-        sum += this->weights.at(std::make_pair(*lastNode, *i));
-        lastNode = i;
-        ++i;
-    }
-
-    return sum;
+    std::shared_ptr<const CompactGraph> compact = this->getCompactGraph();
+    return compact->getPathCost(compact->toNodeIds(pPath));
 }
\ No newline at end of file
@@ -17,8 +17,17 @@
 #include <tuple>
 #include <functional>
 #include <string>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include "BlockedGraph.hpp"
+#include "CompactGraph.hpp"
+#include "ShortestPathTree.hpp"
+#include "HopDistanceMatrix.hpp"
+#include "ReservationTable.hpp"
+#include "HeuristicProvider.hpp"
 
-typedef std::string NodeType;
+class ContractionHierarchy;
 
 /**
  * @brief An abstraction of a Graph with a maximum of one edge between a pair of nodes
@@ -156,7 +165,51 @@ public:
      * @param pObstacles A set of static obstacles which are on nodes which an agent can not enter
      * @return std::map<NodeType, std::vector<NodeType>> A mapping which maps every node to a path over which to reach the node on the fastest way from pStart while avoiding the obstacles of pObstacles 
      */
-    std::map<NodeType, std::vector<NodeType>> getAllShortestPaths(NodeType pStart, std::set<NodeType> pObstacles=std::set<NodeType>()) const;
+    std::map<NodeType, std::vector<NodeType>> getAllShortestPaths(NodeType pStart, const std::set<NodeType>& pObstacles=std::set<NodeType>()) const;
+
+    /**
+     * @brief Calculates a shortest path tree rooted at pStart using Dijkstra's algorithm with a binary heap. Paths to individual nodes
+     * are only reconstructed when they are requested from the tree.
+     * 
+     * @param pStart The root of the tree
+     * @param pObstacles Nodes which shall not be entered
+     * @param pTarget If set, the search stops as soon as the shortest path to this node is known
+     * @return ShortestPathTree The shortest path tree (predecessors and distances of all nodes)
+     */
+    ShortestPathTree getShortestPathTree(NodeType pStart, const std::set<NodeType>& pObstacles=std::set<NodeType>(), std::optional<NodeType> pTarget=std::optional<NodeType>()) const;
+
+    /**
+     * @brief Calculates a shortest path tree rooted at pStart using parallel delta-stepping on all threads of a pool; Meant for
+     * distance fields over big graphs (e.g. the environment lattice at startup)
+     * 
+     * @param pStart The root of the tree
+     * @param pPool The threads to run on
+     * @param pObstacles Nodes which shall not be entered
+     * @return ShortestPathTree The shortest path tree (predecessors and distances of all nodes)
+     */
+    ShortestPathTree getShortestPathTree(NodeType pStart, ThreadPool& pPool, const std::set<NodeType>& pObstacles=std::set<NodeType>()) const;
+
+    /**
+     * @brief Calculates the number of hops from (or to) every source node to all nodes with a bit-parallel BFS which handles 64
+     * sources per pass over the edges. On graphs with uniform edge weights (see CompactGraph::getUniformWeight()) this replaces one
+     * Dijkstra per source, e.g. to calculate the heuristics of all agent targets at once.
+     *
+     * @param pSources The source nodes; Unknown nodes reach no node at all
+     * @param pObstacles Nodes which shall not be entered
+     * @param pBackward If true, the hops are counted from every node to the sources instead of from the sources to every node
+     * @return HopDistanceMatrix The hops of all nodes for every source
+     */
+    HopDistanceMatrix getHopDistances(const std::vector<NodeType>& pSources, const std::set<NodeType>& pObstacles=std::set<NodeType>(), bool pBackward=false) const;
+
+    /**
+     * @brief Builds a contraction hierarchy of the graph, which answers exact distance and shortest path queries without exploring
+     * the graph (see ContractionHierarchyQuery) and can be used as HeuristicProvider; The hierarchy belongs to the current
+     * getCompactGraph() and is outdated once the graph is modified
+     * 
+     * @param pPool The threads to contract the nodes on
+     * @return std::shared_ptr<ContractionHierarchy> The hierarchy
+     */
+    std::shared_ptr<ContractionHierarchy> getContractionHierarchy(ThreadPool& pPool) const;
 
     /**
      * @brief Returns a mapping which maps all graph nodes to a vector of nodes which form the shortest way from a start node pStart to them  and the costs of the path while avoiding obstacles 
@@ -165,7 +218,17 @@ public:
      * @param pObstacles A set of static obstacles which are on nodes which an agent can not enter
      * @return std::map<NodeType, std::pair<std::vector<NodeType>, double>> A mapping which maps every node to a path over which to reach the node on the fastest way from pStart while avoiding the obstacles of pObstacles 
      */
-    std::map<NodeType, std::pair<std::vector<NodeType>, double>> getAllShortestPathsWithCosts(NodeType pStart, std::set<NodeType> pObstacles=std::set<NodeType>()) const;
+    std::map<NodeType, std::pair<std::vector<NodeType>, double>> getAllShortestPathsWithCosts(NodeType pStart, const std::set<NodeType>& pObstacles=std::set<NodeType>()) const;
+
+    /**
+     * @brief Same as getAllShortestPathsWithCosts(), but the shortest path tree is calculated by parallel delta-stepping
+     * 
+     * @param pStart The start node of the ways
+     * @param pPool The threads to run on
+     * @param pObstacles A set of static obstacles which are on nodes which an agent can not enter
+     * @return std::map<NodeType, std::pair<std::vector<NodeType>, double>> A mapping which maps every node to a shortest path from pStart and its costs
+     */
+    std::map<NodeType, std::pair<std::vector<NodeType>, double>> getAllShortestPathsWithCosts(NodeType pStart, ThreadPool& pPool, const std::set<NodeType>& pObstacles=std::set<NodeType>()) const;
     
     /**
      * @brief Returns a shortest path between the start node pStart and a target node pTarget using the heuristic pH for A*, a set of obstacles which can not be entered by an agent and constraints which forbid entering nodes at specific
@@ -176,10 +239,52 @@ public:
      * @param pH A heuristic to use for A*
      * @param pObstacles Static obstacles on nodes which shall not be entered
      * @param pConstraints Mappings <timestep> -> <set of nodes> which specify which nodes shall not be entered at a specific timestep
+     * @param pHorizon The maximum timestep to search; 0 selects <last constrained timestep> + <number of nodes>, which always suffices to find an optimal path
+     * @return std::vector<NodeType> A vector which contains the node of the shortest path
+     */
+    std::vector<NodeType> getShortestPath(NodeType pStart, NodeType pTarget, std::function<double(NodeType, NodeType)> pH=[](NodeType, NodeType){ return 0.0; }, const std::set<NodeType>& pObstacles=std::set<NodeType>(), std::map<unsigned int, std::set<NodeType>> pConstraints=std::map<unsigned int, std::set<NodeType>>(), unsigned int pHorizon=0) const;
+
+    /**
+     * @brief Returns a shortest path between the start node pStart and a target node pTarget using the heuristic pH for A*, a set of obstacles which can not be entered by an agent and
+     * a reservation table which forbids entering nodes or traversing edges at specific time steps
+     * 
+     * @param pStart The start node
+     * @param pTarget The target node
+     * @param pH A heuristic to use for A*
+     * @param pObstacles Static obstacles on nodes which shall not be entered
+     * @param pReservations Node and edge reservations (using the node IDs of getCompactGraph()) which have to be respected
+     * @param pHorizon The maximum timestep to search; 0 selects <last reserved timestep> + <number of nodes>, which always suffices to find an optimal path
+     * @return std::vector<NodeType> A vector which contains the node of the shortest path
+     */
+    std::vector<NodeType> getShortestPath(NodeType pStart, NodeType pTarget, std::function<double(NodeType, NodeType)> pH, const std::set<NodeType>& pObstacles, const ReservationTable& pReservations, unsigned int pHorizon=0) const;
+
+    /**
+     * @brief Returns a shortest path between the start node pStart and a target node pTarget using a heuristic provider for A* (e.g. a
+     * HeuristicCache or a LandmarkHeuristic), a set of obstacles which can not be entered by an agent and a reservation table
+     * 
+     * @param pStart The start node
+     * @param pTarget The target node
+     * @param pHeuristicProvider Provides the heuristic on the node IDs of getCompactGraph()
+     * @param pObstacles Static obstacles on nodes which shall not be entered
+     * @param pReservations Node and edge reservations (using the node IDs of getCompactGraph()) which have to be respected
+     * @param pHorizon The maximum timestep to search; 0 selects <last reserved timestep> + <number of nodes>, which always suffices to find an optimal path
      * @return std::vector<NodeType> A vector which contains the node of the shortest path
      */
-    std::vector<NodeType> getShortestPath(NodeType pStart, NodeType pTarget, std::function<double(NodeType, NodeType)> pH=[](NodeType, NodeType){ return 0.0; }, std::set<NodeType> pObstacles=std::set<NodeType>(), std::map<unsigned int, std::set<NodeType>> pConstraints=std::map<unsigned int, std::set<NodeType>>()) const;
+    std::vector<NodeType> getShortestPath(NodeType pStart, NodeType pTarget, HeuristicProvider& pHeuristicProvider, const std::set<NodeType>& pObstacles=std::set<NodeType>(), const ReservationTable& pReservations=ReservationTable(), unsigned int pHorizon=0) const;
     
+    /**
+     * @brief Returns a shortest path between the start node pStart and a target node pTarget using a bidirectional A*, which explores
+     * roughly half of the nodes of a unidirectional search; Used by getShortestPath() if there are no constraints
+     * 
+     * @param pStart The start node
+     * @param pTarget The target node
+     * @param pH A consistent heuristic which estimates the costs from the first to the second node; It is evaluated towards pTarget
+     * for the forward search and from pStart for the backward search
+     * @param pObstacles Static obstacles on nodes which shall not be entered
+     * @return std::vector<NodeType> A vector which contains the node of the shortest path
+     */
+    std::vector<NodeType> getShortestPathBidirectional(NodeType pStart, NodeType pTarget, std::function<double(NodeType, NodeType)> pH=[](NodeType, NodeType){ return 0.0; }, const std::set<NodeType>& pObstacles=std::set<NodeType>()) const;
+
     /**
      * @brief Returns the costs of a path in this graph
      * 
@@ -238,7 +343,141 @@ public:
      * @return false The path pPath does not satisfy at least one constraint of pConstraints
      */
     bool checkPathConstraints(const std::vector<NodeType>& pPath, const std::map<unsigned int, std::set<NodeType>> pConstraints) const;
+
+    /**
+     * @brief Checks if a path satisfies the node and edge reservations of a reservation table
+     * 
+     * @param pPath The path to check as a vector of nodes (one node per timestep)
+     * @param pReservations The reservations (using the node IDs of getCompactGraph())
+     * @return true The path pPath does not violate any reservation
+     * @return false The path pPath violates at least one reservation
+     */
+    bool checkPathConstraints(const std::vector<NodeType>& pPath, const ReservationTable& pReservations) const;
+
+    /**
+     * @brief Translates constraints in the form <timestep> -> <set of nodes> to a reservation table
+     * 
+     * @param pCompact The compact graph which defines the node IDs
+     * @param pConstraints The constraints
+     * @return ReservationTable A reservation table containing a node reservation for every constraint
+     */
+    static ReservationTable getReservationTable(const CompactGraph& pCompact, const std::map<unsigned int, std::set<NodeType>>& pConstraints);
+
+    /**
+     * @brief Returns an immutable compressed sparse row representation of this graph which is used by the search algorithms; The
+     * representation is built on first use after a modification of the graph and shared between copies of the graph
+     * 
+     * @return std::shared_ptr<const CompactGraph> The compact representation of the current state of this graph
+     */
+    std::shared_ptr<const CompactGraph> getCompactGraph() const;
+
+    /**
+     * @brief Blocks or unblocks a node in the obstacle layer; Blocked nodes are avoided by all searches without changing the
+     * structure of the graph
+     * 
+     * @param pNode The node
+     * @param pBlocked true to block the node, false to unblock it
+     * @return true The node was found
+     * @return false The node is not part of the graph
+     */
+    bool setBlocked(NodeType pNode, bool pBlocked);
+
+    /**
+     * @brief Blocks or unblocks an edge in the obstacle layer; Blocked edges are avoided by the path searches (getShortestPath(),
+     * getShortestPathBidirectional()), the shortest path trees only respect blocked nodes
+     * 
+     * @param pFrom The start node of the edge
+     * @param pTo The end node of the edge
+     * @param pBlocked true to block the edge, false to unblock it
+     * @return true The edge was found
+     * @return false There is no such edge
+     */
+    bool setEdgeBlocked(NodeType pFrom, NodeType pTo, bool pBlocked);
+
+    /**
+     * @brief Checks if a node is blocked in the obstacle layer
+     * 
+     * @param pNode The node
+     * @return true The node is blocked
+     * @return false The node is not blocked or not part of the graph
+     */
+    bool isBlocked(NodeType pNode) const;
+
+    /**
+     * @brief Returns the obstacle layer on the current compact graph, e.g. to toggle obstacles by node ID in O(1) or to plan on it
+     * with the Blocked* searches; The obstacles are carried over (by name) when the structure of the graph changes. The layer must
+     * not be modified while searches run on it.
+     * 
+     * @return std::shared_ptr<BlockedGraph> The obstacle layer
+     */
+    std::shared_ptr<BlockedGraph> getBlockedGraph() const;
+
+    /**
+     * @brief Returns the obstacle layer if it blocks anything, e.g. to plan on it instead of on getCompactGraph()
+     * 
+     * @return std::shared_ptr<const BlockedGraph> The obstacle layer or nullptr if nothing is blocked
+     */
+    std::shared_ptr<const BlockedGraph> getActiveBlockedGraph() const;
 protected:
+
+    /**
+     * @brief Drops the cached compact representation; Has to be called by every function which modifies the graph
+     */
+    void invalidateCompactGraph();
+
+    /**
+     * @brief Marks the obstacles of one query in a vector of flags indexed by node ID; Every thread reuses its own vector, which
+     * only gets the bits of the obstacles set and reset again once the mask is destroyed, so a query does not build a vector of
+     * all nodes. If a mask of the thread is still alive (nested queries), a vector of its own is used instead
+     */
+    class ObstacleMask
+    {
+    public:
+        /**
+         * @brief Marks the obstacles and, if given, the nodes blocked by the obstacle layer
+         * 
+         * @param pCompact The compact graph which defines the node IDs
+         * @param pObstacles The obstacles
+         * @param pLayer The obstacle layer of pCompact or nullptr, if only the obstacles shall be marked
+         */
+        ObstacleMask(const CompactGraph& pCompact, const std::set<NodeType>& pObstacles, const BlockedGraph* pLayer=nullptr);
+        ~ObstacleMask();
+        ObstacleMask(const ObstacleMask&) = delete;
+        ObstacleMask& operator=(const ObstacleMask&) = delete;
+
+        /**
+         * @brief Returns the flags; Only valid as long as the mask exists
+         * 
+         * @return const std::vector<bool>& true for every blocked node; An empty vector if nothing is blocked
+         */
+        const std::vector<bool>& get() const;
+    private:
+        /**
+         * @brief The vector of the thread, nullptr if nothing is blocked or if ownMask is used
+         */
+        std::vector<bool>* threadMask;
+
+        /**
+         * @brief Set while threadMask is used by this mask
+         */
+        bool* threadMaskUsed;
+
+        /**
+         * @brief Used instead of the vector of the thread if that one is still in use
+         */
+        std::vector<bool> ownMask;
+
+        /**
+         * @brief The nodes marked in threadMask, which have to be reset; Not used if the obstacle layer was marked
+         */
+        std::vector<NodeId> marked;
+
+        /**
+         * @brief True if the obstacle layer was marked, so threadMask has to be reset completely
+         */
+        bool layerMarked;
+    };
+
     /**
      * @brief A set storing the nodes of the graph
      */
@@ -258,4 +497,20 @@ protected:
      * @brief A mapping (<from >, <to>) -> <weight> which stores all edge weights of the graph
      */
     std::map<std::pair<NodeType, NodeType>, double> weights;
+
+    /**
+     * @brief Caches the compact representation of the graph (nullptr if it has to be rebuilt)
+     */
+    mutable std::shared_ptr<const CompactGraph> compactGraph;
+
+    /**
+     * @brief Protects compactGraph as the search functions may be called concurrently (e.g. by CBS)
+     */
+    mutable std::mutex compactGraphMutex;
+
+    /**
+     * @brief The obstacle layer (nullptr if nothing was ever blocked); Protected by compactGraphMutex and rebuilt on the current
+     * compact graph when it is requested
+     */
+    mutable std::shared_ptr<BlockedGraph> blockedGraph;
 };
\ No newline at end of file
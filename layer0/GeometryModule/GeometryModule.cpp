@@ -6,7 +6,7 @@
 #include "logger.hpp"
 
 GeometryModule::GeometryModule(double pHeightOffset, double pHeight, Position pStepSizes, Position pWeights, const std::map<uint16_t, Position>& pInitialDronePositions)
-: environmentGraph(), nodePositions(), stepSizes(pStepSizes), minHeight(pHeightOffset), height(pHeight)
+: environmentLattice(), environmentGraph(), nodePositions(), stepSizes(pStepSizes), minHeight(pHeightOffset), height(pHeight)
 {
     std::pair<uint16_t, uint16_t> maxPair;
     double maxDistance = 0.0;
@@ -47,72 +47,38 @@ GeometryModule::GeometryModule(double pHeightOffset, double pHeight, Position pS
 
     MSG_INFO("Hypercube X-Y-layer edge positions: (x=" + std::to_string(minX) + ", y=" + std::to_string(minY) + "), (x=" + std::to_string(maxX) + ", y=" + std::to_string(maxY) + ") Steps: " + (std::string)pStepSizes);
 
+    /*The edges are implicit: Grid nodes are connected to their neighbours in x and y direction, spikes to the corners of their cell*/
+    uint32_t sizeX = 0;
     cntrY = 0;
     for(y=minY; y <= maxY; y+=pStepSizes.getY())
     {
         cntrX = 0;
         for(x=minX; x <= maxX; x+=pStepSizes.getX())
         {
-            NodeType nodeName = this->generateNodeName(cntrX, cntrY, 0);
-
-            this->nodePositions.insert(std::make_pair(nodeName, Position(x, y, minHeight, 0.0)));
-            environmentGraph.addNode(nodeName);
-
-            if(cntrX > 0)
-            {
-                /*There is a node previous (in Y direction) to the current node*/
-                NodeType otherNode = GeometryModule::generateNodeName(cntrX-1, cntrY, 0);
-                this->environmentGraph.addEdge(otherNode, nodeName, pWeights.getX());
-                this->environmentGraph.addEdge(nodeName, otherNode, pWeights.getX());
-            }
-            if(cntrY > 0)
-            {
-                /*There is a node previous (in Y direction) to the current node*/
-                NodeType otherNode = GeometryModule::generateNodeName(cntrX, cntrY-1, 0);
-                this->environmentGraph.addEdge(otherNode, nodeName, pWeights.getY());
-                this->environmentGraph.addEdge(nodeName, otherNode, pWeights.getY());
-            }
+            this->nodePositions.insert(std::make_pair(this->generateNodeName(cntrX, cntrY, 0), Position(x, y, minHeight, 0.0)));
             cntrX++;
         }
+        sizeX = cntrX;
         cntrY++;
     }
+    uint32_t sizeY = cntrY;
 
-    if (stepSizes.getZ() <= pHeight)
-    {
-        /*Create "spikes"*/
+    double spikeWeight = sqrt(pWeights.getZ() * pWeights.getZ() + pWeights.getX() * pWeights.getX() + pWeights.getY() * pWeights.getY());
+    this->environmentLattice = std::make_shared<LatticeGraph>(sizeX, sizeY, stepSizes.getZ() <= pHeight, pWeights.getX(), pWeights.getY(), spikeWeight);
 
-        cntrY = 0;
-        for (y = minY + pStepSizes.getY() / 2; y < maxY; y += pStepSizes.getY())
+    if (this->environmentLattice->hasSpikes())
+    {
+        /*Create "spikes", one in the center of every grid cell*/
+        y = minY + pStepSizes.getY() / 2;
+        for (cntrY = 0; cntrY + 1 < sizeY; cntrY++)
         {
-            cntrX = 0;
-            for (x = minX + pStepSizes.getX() / 2; x < maxX; x += pStepSizes.getX())
+            x = minX + pStepSizes.getX() / 2;
+            for (cntrX = 0; cntrX + 1 < sizeX; cntrX++)
             {
-                NodeType nodeName = this->generateNodeName(cntrX, cntrY, 1);
-
-                this->nodePositions.insert(std::make_pair(nodeName, Position(x, y, stepSizes.getZ() + minHeight, 0.0)));
-                environmentGraph.addNode(nodeName);
-
-                double weight = sqrt(pWeights.getZ() * pWeights.getZ() + pWeights.getX() * pWeights.getX() + pWeights.getY() * pWeights.getY());
-
-                NodeType n1 = GeometryModule::generateNodeName(cntrX, cntrY, 0);
-                this->environmentGraph.addEdge(n1, nodeName, weight);
-                this->environmentGraph.addEdge(nodeName, n1, weight);
-
-                NodeType n2 = GeometryModule::generateNodeName(cntrX + 1, cntrY, 0);
-                this->environmentGraph.addEdge(n2, nodeName, weight);
-                this->environmentGraph.addEdge(nodeName, n2, weight);
-
-                NodeType n3 = GeometryModule::generateNodeName(cntrX, cntrY + 1, 0);
-                this->environmentGraph.addEdge(n3, nodeName, weight);
-                this->environmentGraph.addEdge(nodeName, n3, weight);
-
-                NodeType n4 = GeometryModule::generateNodeName(cntrX + 1, cntrY + 1, 0);
-                this->environmentGraph.addEdge(n4, nodeName, weight);
-                this->environmentGraph.addEdge(nodeName, n4, weight);
-
-                cntrX++;
+                this->nodePositions.insert(std::make_pair(this->generateNodeName(cntrX, cntrY, 1), Position(x, y, stepSizes.getZ() + minHeight, 0.0)));
+                x += pStepSizes.getX();
             }
-            cntrY++;
+            y += pStepSizes.getY();
         }
     }
 
@@ -122,7 +88,16 @@ GeometryModule::GeometryModule(double pHeightOffset, double pHeight, Position pS
 
 const Graph& GeometryModule::getEnvironmentGraph() const
 {
-    return this->environmentGraph;
+    std::lock_guard<std::mutex> lock(this->environmentGraphMutex);
+    if(!this->environmentGraph)
+    {
+        this->environmentGraph = std::make_unique<Graph>(this->environmentLattice->toGraph());
+    }
+    return *this->environmentGraph;
+}
+std::shared_ptr<const LatticeGraph> GeometryModule::getEnvironmentLattice() const
+{
+    return this->environmentLattice;
 }
 
 const std::map<NodeType, Position> GeometryModule::getNodePositions() const
@@ -2,8 +2,11 @@
 #define GEOMETRY_MODULE_HPP_INCLUDED
 
 #include "graph/graph.hpp"
+#include "graph/LatticeGraph.hpp"
 #include "layer0/position.hpp"
 #include <algorithm>
+#include <memory>
+#include <mutex>
 
 class GeometryModule
 {
@@ -21,12 +24,19 @@ public:
     GeometryModule(double pHeightOffset, double pHeight, Position pStepSizes, Position pWeights, const std::map<uint16_t, Position>& pInitialDronePositions);
 
     /**
-     * @brief Returns the hypercube graph representing the environmnent
+     * @brief Returns the hypercube graph representing the environmnent; The graph is materialized from the lattice on the first call
      * 
      * @return const Graph& The environment hypercube graph
      */
     const Graph& getEnvironmentGraph() const;
 
+    /**
+     * @brief Returns the implicit lattice representing the environment; Its node names are the same as in the environment graph
+     * 
+     * @return std::shared_ptr<const LatticeGraph> The environment lattice
+     */
+    std::shared_ptr<const LatticeGraph> getEnvironmentLattice() const;
+
     /**
      * @brief Returns the positions for all nodes of the environment graph
      * 
@@ -164,9 +174,19 @@ public:
 
 protected:
     /**
-     * @brief A hypercube graph representing the environment of the swarm
+     * @brief The implicit lattice representing the environment of the swarm (the edges are never stored)
+     */
+    std::shared_ptr<LatticeGraph> environmentLattice;
+
+    /**
+     * @brief The hypercube graph representing the environment of the swarm; Only built on demand for users of the Graph interface
+     */
+    mutable std::unique_ptr<Graph> environmentGraph;
+
+    /**
+     * @brief Protects the lazy construction of environmentGraph
      */
-    Graph environmentGraph;
+    mutable std::mutex environmentGraphMutex;
 
     /**
      * @brief A mapping node -> position for all graph nodes
@@ -1,11 +1,15 @@
 #include "SwarmOperationHandler.hpp"
 #include "graph/MAPF/CBS/CBS.hpp"
+#include "graph/DistanceMatrix.hpp"
 #include "logger.hpp"
 #include "utils.hpp"
 #include <vector>
 
 #define PATH_MERGING 0
 #define PATH_REFINING 0
+/*Lattices with up to this many nodes get a precomputed matrix of all distances (2 byte per pair), larger ones are searched with Jump
+Point Search*/
+#define DISTANCE_MATRIX_MAX_NODES 8192
 
 void SwarmOperationHandler::handleTakeoffRequest()
 {
@@ -246,15 +250,6 @@ void SwarmOperationHandler::handleMoveRequest()
 
                     MSG_INFO(targetsStr);
 
-                    CBS solver = CBS([](NodeType pNode1, NodeType pNode2) {
-                        std::tuple<uint32_t, uint32_t, uint32_t> pos1 = GeometryModule::getNodeHypercubePosition(pNode1);
-                        std::tuple<uint32_t, uint32_t, uint32_t> pos2 = GeometryModule::getNodeHypercubePosition(pNode2);
-
-                        return Position(std::get<0>(pos1),
-                            std::get<1>(pos1), std::get<2>(pos1), 0.0).getEuclideanDistance(Position(std::get<0>(pos2), 
-                            std::get<1>(pos2), std::get<2>(pos2), 0.0));
-                    });
-
                     std::map<unsigned int, std::pair<NodeType, NodeType>> agents = {};
                     for (const auto& t : snappedTargets)
                     {
@@ -263,11 +258,22 @@ void SwarmOperationHandler::handleMoveRequest()
                         agents[t.first] = std::make_pair(start, target);
                     }
 
-                    Graph environmentGraph = this->geometry.getEnvironmentGraph();
-                    MAPF::Task task(environmentGraph, agents);
+                    /*Plan directly on the implicit lattice, the environment graph does not have to be materialized; With the distance
+                    matrix mapped at startup the space-time A* follows the exact distances, without it Jump Point Search prunes the
+                    symmetric paths of the grid*/
+                    std::shared_ptr<const LatticeGraph> lattice = this->geometry.getEnvironmentLattice();
+                    std::shared_ptr<const LowLevelPlanner> planner;
+                    if(this->heuristics)
+                    {
+                        planner = this->heuristics->createPlanner(lattice, LOW_LEVEL_SPACE_TIME_A_STAR);
+                    }
+                    else
+                    {
+                        planner = std::make_shared<LatticeJumpPointPlanner>(lattice);
+                    }
 
                     unsigned int entryTime = getMillis();
-                    MAPF::Plan mapfPlan = solver.solveTask(task);
+                    MAPF::Plan mapfPlan = this->solver.solve(planner, agents);
                     MSG_INFO("Calculated path using CBS after " + std::to_string(getTimedif(entryTime, getMillis())) + " ms");
 
                     std::vector<std::map<unsigned int, NodeType>> nodePlan = {};
@@ -728,8 +734,47 @@ void SwarmOperationHandler::update()
     this->interactionServer.updateDronePositions(this->droneSwarmInterfaceClient.getDronePositions());
     this->interactionServer.updateDroneStates(this->droneSwarmInterfaceClient.getDroneStates());
 }
-SwarmOperationHandler::SwarmOperationHandler(InteractionServer& pInteractionServer, DroneSwarmInterfaceClient& pDroneSwarmInterfaceClient, GeometryModule& pGeometry)
-: interactionServer(pInteractionServer), droneSwarmInterfaceClient(pDroneSwarmInterfaceClient), geometry(pGeometry), plan()
+SwarmOperationHandler::SwarmOperationHandler(InteractionServer& pInteractionServer, DroneSwarmInterfaceClient& pDroneSwarmInterfaceClient, GeometryModule& pGeometry, const std::string& pDistanceMatrixPath)
+: interactionServer(pInteractionServer), droneSwarmInterfaceClient(pDroneSwarmInterfaceClient), geometry(pGeometry), heuristics(nullptr), plan(), solver()
+{
+    /*The environment does not change while the controller runs, so the distances between all nodes are mapped from the file of
+    precomputeDistanceMatrix(); Calculating them here would delay the startup, so without the file the low level searches use Jump
+    Point Search*/
+    if(pDistanceMatrixPath.empty())
+    {
+        return;
+    }
+    try
+    {
+        this->heuristics = DistanceMatrix::load(pDistanceMatrixPath, this->geometry.getEnvironmentLattice());
+        MSG_INFO("Mapped the distance matrix of the environment from " + pDistanceMatrixPath);
+    }
+    catch(const std::runtime_error& e)
+    {
+        MSG_WARNING(std::string(e.what()) + " Planning without distance matrix.");
+    }
+}
+bool SwarmOperationHandler::precomputeDistanceMatrix(GeometryModule& pGeometry, const std::string& pPath)
 {
+    std::shared_ptr<const LatticeGraph> lattice = pGeometry.getEnvironmentLattice();
+    if(lattice->getNodeCount() > DISTANCE_MATRIX_MAX_NODES)
+    {
+        MSG_WARNING("The environment has " + std::to_string(lattice->getNodeCount()) + " nodes, which is too large for a distance matrix.");
+        return false;
+    }
 
+    unsigned int entryTime = getMillis();
+    ThreadPool pool;
+    std::shared_ptr<DistanceMatrix> matrix = DistanceMatrix::compute(lattice, pool);
+    try
+    {
+        matrix->save(pPath);
+    }
+    catch(const std::runtime_error& e)
+    {
+        MSG_ERROR(e.what());
+        return false;
+    }
+    MSG_INFO("Calculated the distance matrix of the environment after " + std::to_string(getTimedif(entryTime, getMillis())) + " ms and stored it in " + pPath);
+    return true;
 }
\ No newline at end of file
@@ -4,7 +4,11 @@
 #include "layer0/InteractionInterface/InteractionServer.hpp"
 #include "layer0/DroneSwarmInterface/DroneSwarmInterfaceClient.hpp"
 #include "layer0/GeometryModule/GeometryModule.hpp"
+#include "graph/MAPF/CBS/CBS.hpp"
+#include "graph/HeuristicCache.hpp"
+#include <memory>
 #include <optional>
+#include <string>
 
 /**
  * @brief Core element of the Operation Controller; This class puts all of the components (InteractionServer, DroneSwarmInterfaceClient, GeometryModule) together and manages their interactions. Requests are received from the interaction server, plan calculations are started based on the information of the Geometry module and the plan is executed using the DroneSwarmInterfaceClient.
@@ -14,8 +18,20 @@ class SwarmOperationHandler
 public:
     /**
      * @brief Creates a new SwarmOperationHandler, which needs an InteractionServer to serve as communication interface to an InteractionClient (e.g. an AR application), a DroneSwarmInterfaceClient which communicates with the drone swarm and a GeometryModule which manages an environment graph in which the drones are flying
+     *
+     * @param pDistanceMatrixPath The file written by precomputeDistanceMatrix() for this environment; Empty, missing or outdated files are ignored, the paths are then planned with Jump Point Search
      */
-    SwarmOperationHandler(InteractionServer& pInteractionServer, DroneSwarmInterfaceClient& pDroneSwarmInterfaceClient, GeometryModule& pGeometry);
+    SwarmOperationHandler(InteractionServer& pInteractionServer, DroneSwarmInterfaceClient& pDroneSwarmInterfaceClient, GeometryModule& pGeometry, const std::string& pDistanceMatrixPath="");
+
+    /**
+     * @brief Calculates the distances between all nodes of the environment lattice on all cores and stores them in a file which is mapped by the constructor at the next start; Meant to be run once as a separate step before the operation, as it takes long on larger environments
+     *
+     * @param pGeometry The GeometryModule containing the environment
+     * @param pPath The file to store the matrix in
+     * @return true The matrix was stored
+     * @return false The environment is too large for a distance matrix or the file could not be written
+     */
+    static bool precomputeDistanceMatrix(GeometryModule& pGeometry, const std::string& pPath);
 
     /**
      * @brief Update function which needs to be called cyclically
@@ -106,6 +122,9 @@ protected:
     DroneSwarmInterfaceClient& droneSwarmInterfaceClient;
     /*The GeometryModule containing the environment information of the swarm*/
     GeometryModule& geometry;
+    /*The distances to the targets of the low level path finding; A matrix of all distances which is mapped from a file at startup, or
+    nullptr if there is no matrix for the environment (the low level searches then use Jump Point Search)*/
+    std::shared_ptr<HeuristicProvider> heuristics;
 
 private:
     /**
@@ -132,6 +151,11 @@ private:
      * @brief Stores the current plan for the drones (if any)
      */
     std::optional<Plan> plan;
+
+    /**
+     * @brief The MAPF solver; Kept for the lifetime of the handler, so its worker threads are reused by all path calculations
+     */
+    CBS solver;
 };
 
 #endif /*SWARM_OPERATION_HANDLER_HPP_INCLUDED*/
\ No newline at end of file
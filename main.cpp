@@ -7,6 +7,8 @@
 #include <iostream>
 #include <algorithm>
 #include <random>
+#include <optional>
+#include <string>
 
 void printDroneSwarmInterfaceClientInformation(DroneSwarmInterfaceClient& client)
 {
@@ -103,8 +105,77 @@ void printDroneSwarmInterfaceClientInformation(DroneSwarmInterfaceClient& client
     std::cout << std::endl;
 }
 
-int main()
+/**
+ * @brief Creates the geometry module of the environment spanned by the drones
+ */
+GeometryModule* createGeometryModule(const std::map<uint16_t, Position>& pDronePositions)
 {
+    return new GeometryModule(1.0, 0.7, Position(0.6, 0.6, 0.6, 0.0), Position(0.2, 0.21, 0.4, 0.0), pDronePositions);
+}
+
+/**
+ * @brief Starts the operation controller; Usage: OperationController [--distance-matrix <file>] or
+ * OperationController --precompute <file> --arena <x1> <y1> <x2> <y2>. The distance matrix file is mapped to speed up the path
+ * planning. With --precompute the matrix of the environment between the corners given by --arena (the positions of the two drones
+ * which are farthest apart) is calculated and stored in the file without connecting to the swarm.
+ */
+int main(int argc, char* argv[])
+{
+    std::string distanceMatrixPath;
+    std::optional<std::string> precomputePath;
+    std::optional<std::map<uint16_t, Position>> arena;
+    for (int i = 1; i < argc; i++)
+    {
+        std::string argument = argv[i];
+        if ((argument == "--distance-matrix" || argument == "--precompute") && (i + 1 >= argc || std::string(argv[i + 1]).rfind("--", 0) == 0))
+        {
+            MSG_ERROR(argument + " needs the path of the distance matrix file.");
+            return 1;
+        }
+        if (argument == "--distance-matrix")
+        {
+            distanceMatrixPath = argv[++i];
+        }
+        else if (argument == "--precompute")
+        {
+            precomputePath = argv[++i];
+        }
+        else if (argument == "--arena" && i + 4 < argc)
+        {
+            try
+            {
+                arena = std::map<uint16_t, Position>{{0, Position(std::stod(argv[i + 1]), std::stod(argv[i + 2]), 0.0, 0.0)},
+                                                     {1, Position(std::stod(argv[i + 3]), std::stod(argv[i + 4]), 0.0, 0.0)}};
+            }
+            catch (const std::logic_error&)
+            {
+                MSG_ERROR("--arena needs the coordinates <x1> <y1> <x2> <y2>.");
+                return 1;
+            }
+            i += 4;
+        }
+        else
+        {
+            MSG_ERROR("Invalid argument " + argument + ". Usage: OperationController [--distance-matrix <file>] or OperationController --precompute <file> --arena <x1> <y1> <x2> <y2>");
+            return 1;
+        }
+    }
+
+    if (precomputePath.has_value())
+    {
+        /*The matrix only depends on the environment, so neither the swarm nor the interaction server are needed*/
+        if (!arena.has_value())
+        {
+            MSG_ERROR("--precompute needs the corners of the environment given by --arena <x1> <y1> <x2> <y2>.");
+            return 1;
+        }
+        MSG_INFO("Calculating the distance matrix...");
+        GeometryModule* geometry = createGeometryModule(arena.value());
+        bool stored = SwarmOperationHandler::precomputeDistanceMatrix(*geometry, precomputePath.value());
+        delete geometry;
+        return stored ? 0 : 1;
+    }
+
     SwarmOperationHandler* swarmOperationHandler = nullptr;
     GeometryModule* geometryModule = nullptr;
     InteractionServer* interactionServer;
@@ -157,9 +228,9 @@ int main()
                 interactionServer->updateSwarmState(SWARM_IDLE);
                 interactionServer->initialize(12346);
                 MSG_INFO("Initializing geometry...");
-                geometryModule = new GeometryModule(1.0, 0.7, Position(0.6, 0.6, 0.6, 0.0), Position(0.2, 0.21, 0.4, 0.0), client.getDronePositions());
+                geometryModule = createGeometryModule(client.getDronePositions());
                 MSG_INFO("Intializing swarm operation handler...");
-                swarmOperationHandler = new SwarmOperationHandler(*interactionServer, client, *geometryModule);
+                swarmOperationHandler = new SwarmOperationHandler(*interactionServer, client, *geometryModule, distanceMatrixPath);
                 MSG_INFO("Running. The system is operational.");
                 init = true;
             }